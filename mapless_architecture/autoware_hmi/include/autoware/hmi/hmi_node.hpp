@@ -18,7 +18,11 @@
 #include "rclcpp/rclcpp.hpp"
 
 #include "autoware_mapless_planning_msgs/msg/mission.hpp"
+#include "autoware_mapless_planning_msgs/msg/mission_ack.hpp"
+#include "autoware_mapless_planning_msgs/srv/set_mission.hpp"
+#include "std_srvs/srv/trigger.hpp"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -50,18 +54,69 @@ private:
   rcl_interfaces::msg::SetParametersResult ParamCallback_(
     const std::vector<rclcpp::Parameter> & parameters);
 
+  /**
+   * @brief Callback of the mission service (validates and publishes the mission).
+   *
+   * @param request The mission string, deadline and priority.
+   * @param response Success (false for an unknown mission string) and the publish time.
+   */
+  void SetMissionCallback_(
+    const autoware_mapless_planning_msgs::srv::SetMission::Request::SharedPtr request,
+    autoware_mapless_planning_msgs::srv::SetMission::Response::SharedPtr response);
+
+  /**
+   * @brief Callback of the typed mission topic (forwards valid missions without a parameter or
+   * service round trip). Missions without a (positive) deadline get the default deadline.
+   *
+   * @param msg The mission.
+   */
+  void CallbackMissionMessages_(const autoware_mapless_planning_msgs::msg::Mission & msg);
+
+  /**
+   * @brief Callback of the mission acknowledgement of the mission planner (logs the command
+   * latency).
+   *
+   * @param msg The acknowledgement.
+   */
+  void CallbackMissionAckMessages_(const autoware_mapless_planning_msgs::msg::MissionAck & msg);
+
+  /**
+   * @brief Convert a mission string to the mission type.
+   *
+   * @param mission The mission string (e.g. LANE_CHANGE_LEFT).
+   * @param mission_type The mission type (output, unchanged for an unknown string).
+   * @return False if the mission string is unknown.
+   */
+  static bool ParseMissionType_(const std::string & mission, std::uint8_t & mission_type);
+
   /**
    * @brief Function which publishes the mission.
    *
-   * @param mission The mission that should be published.
+   * @param mission The mission that should be published (the stamp is set if it is zero).
+   * @return The stamp of the published mission.
    */
-  void PublishMission_(const std::string & mission);
+  builtin_interfaces::msg::Time PublishMission_(
+    autoware_mapless_planning_msgs::msg::Mission mission);
 
   // Declare ROS2 publisher and subscriber
 
   rclcpp::Publisher<autoware_mapless_planning_msgs::msg::Mission>::SharedPtr mission_publisher_;
 
+  rclcpp::Subscription<autoware_mapless_planning_msgs::msg::Mission>::SharedPtr
+    mission_subscriber_;
+
+  rclcpp::Subscription<autoware_mapless_planning_msgs::msg::MissionAck>::SharedPtr
+    mission_ack_subscriber_;
+
+  rclcpp::Service<autoware_mapless_planning_msgs::srv::SetMission>::SharedPtr
+    set_mission_service_;
+
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr param_callback_handle_;
+
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr trace_dump_service_;
+
+  // Deadline of the missions set by the parameter (and by the service if no deadline is given)
+  float default_deadline_;
 };
 }  // namespace autoware::mapless_architecture
 
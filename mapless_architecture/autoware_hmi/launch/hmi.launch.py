@@ -27,6 +27,11 @@ def generate_launch_description():
                 namespace="mapless_architecture",
                 remappings=[
                     ("hmi_node/output/mission", "hmi_node/output/mission"),
+                    ("hmi_node/input/mission", "hmi_node/input/mission"),
+                    (
+                        "hmi_node/input/mission_ack",
+                        "mission_planner_node/output/mission_ack",
+                    ),
                 ],
                 parameters=[],
                 output="screen",
@@ -14,6 +14,9 @@
 
 #include "autoware/hmi/hmi_node.hpp"
 
+#include "autoware/local_mission_planner_common/trace_recorder.hpp"
+#include "autoware/local_mission_planner_common/trace_service.hpp"
+
 namespace autoware::mapless_architecture
 {
 using std::placeholders::_1;
@@ -28,61 +31,179 @@ HMINode::HMINode(const rclcpp::NodeOptions & options) : Node("hmi_node", options
   // Declare parameter
   this->declare_parameter("mission", "LANE_KEEP");
 
-  // Initialize publisher
+  default_deadline_ = declare_parameter<float>("default_deadline", 1000.0);
+  RCLCPP_INFO(this->get_logger(), "Default mission deadline set to: %.1f m", default_deadline_);
+
+  // Initialize publisher (reliable, each mission command matters)
   mission_publisher_ = this->create_publisher<autoware_mapless_planning_msgs::msg::Mission>(
-    "hmi_node/output/mission", 1);
+    "hmi_node/output/mission", 10);
+
+  // Typed mission commands and the acknowledgements are reliable (each command matters)
+  mission_subscriber_ = this->create_subscription<autoware_mapless_planning_msgs::msg::Mission>(
+    "hmi_node/input/mission", 10, std::bind(&HMINode::CallbackMissionMessages_, this, _1));
+
+  mission_ack_subscriber_ =
+    this->create_subscription<autoware_mapless_planning_msgs::msg::MissionAck>(
+      "hmi_node/input/mission_ack", 10,
+      std::bind(&HMINode::CallbackMissionAckMessages_, this, _1));
+
+  // Service to set a mission with a direct response (no parameter round trip)
+  set_mission_service_ = this->create_service<autoware_mapless_planning_msgs::srv::SetMission>(
+    "hmi_node/set_mission",
+    std::bind(&HMINode::SetMissionCallback_, this, _1, std::placeholders::_2));
 
   // Initialize parameters callback handle
   param_callback_handle_ = this->add_on_set_parameters_callback(
     std::bind(&HMINode::ParamCallback_, this, std::placeholders::_1));
+
+  // Service to write the recorded trace events to a file
+  trace_dump_service_ = CreateTraceDumpService(*this);
 }
 
 rcl_interfaces::msg::SetParametersResult HMINode::ParamCallback_(
   const std::vector<rclcpp::Parameter> & parameters)
 {
+  MAPLESS_TRACE_SCOPE("hmi", "parameter callback");
+
   // Initialize output
   rcl_interfaces::msg::SetParametersResult result;
 
-  result.successful = false;
+  // Other parameters (e.g. the tracing parameters) are accepted without a mission
+  result.successful = true;
   result.reason = "";
-  std::string mission;
   for (const auto & param : parameters) {
     if (param.get_name() == "mission") {
-      if (param.get_type() == rclcpp::ParameterType::PARAMETER_STRING) {
-        mission = param.as_string();
+      if (param.get_type() != rclcpp::ParameterType::PARAMETER_STRING) {
+        result.successful = false;
+        result.reason = "Incorrect Type";
+        return result;
+      }
 
-        // Publish mission
-        PublishMission_(mission);
+      // Unknown missions are rejected (the parameter keeps its value, nothing is published)
+      autoware_mapless_planning_msgs::msg::Mission mission;
+      if (!ParseMissionType_(param.as_string(), mission.mission_type)) {
+        result.successful = false;
+        result.reason = "Unknown mission: " + param.as_string();
+        return result;
+      }
 
-        result.successful = true;
-      } else {
+      // Publish mission
+      mission.deadline = default_deadline_;
+      mission.priority = autoware_mapless_planning_msgs::msg::Mission::PRIORITY_NORMAL;
+      PublishMission_(mission);
+    } else if (param.get_name() == "default_deadline") {
+      if (param.get_type() != rclcpp::ParameterType::PARAMETER_DOUBLE) {
+        result.successful = false;
         result.reason = "Incorrect Type";
+        return result;
       }
+      default_deadline_ = static_cast<float>(param.as_double());
     }
   }
   return result;
 }
 
-void HMINode::PublishMission_(const std::string & mission)
+void HMINode::SetMissionCallback_(
+  const autoware_mapless_planning_msgs::srv::SetMission::Request::SharedPtr request,
+  autoware_mapless_planning_msgs::srv::SetMission::Response::SharedPtr response)
+{
+  MAPLESS_TRACE_SCOPE("hmi", "set mission service");
+
+  autoware_mapless_planning_msgs::msg::Mission mission;
+  if (!ParseMissionType_(request->mission, mission.mission_type)) {
+    response->success = false;
+    response->message = "Unknown mission: " + request->mission;
+    RCLCPP_WARN(this->get_logger(), "%s", response->message.c_str());
+    return;
+  }
+
+  if (request->priority > autoware_mapless_planning_msgs::msg::Mission::PRIORITY_HIGH) {
+    response->success = false;
+    response->message = "Unknown priority: " + std::to_string(request->priority);
+    RCLCPP_WARN(this->get_logger(), "%s", response->message.c_str());
+    return;
+  }
+
+  mission.deadline = request->deadline > 0.0f ? request->deadline : default_deadline_;
+  mission.priority = request->priority;
+
+  response->stamp = PublishMission_(mission);
+  response->success = true;
+  response->message = "Mission " + request->mission + " published";
+}
+
+void HMINode::CallbackMissionMessages_(const autoware_mapless_planning_msgs::msg::Mission & msg)
+{
+  MAPLESS_TRACE_SCOPE("hmi", "mission callback");
+
+  if (msg.mission_type > autoware_mapless_planning_msgs::msg::Mission::TAKE_NEXT_EXIT_RIGHT) {
+    RCLCPP_WARN(
+      this->get_logger(), "Unknown mission type %u received, mission is not forwarded.",
+      msg.mission_type);
+    return;
+  }
+  if (msg.priority > autoware_mapless_planning_msgs::msg::Mission::PRIORITY_HIGH) {
+    RCLCPP_WARN(
+      this->get_logger(), "Unknown mission priority %u received, mission is not forwarded.",
+      msg.priority);
+    return;
+  }
+
+  // Missions without a (positive) deadline get the default deadline, as in the service
+  autoware_mapless_planning_msgs::msg::Mission mission = msg;
+  if (!(mission.deadline > 0.0f)) mission.deadline = default_deadline_;
+
+  PublishMission_(mission);
+}
+
+void HMINode::CallbackMissionAckMessages_(
+  const autoware_mapless_planning_msgs::msg::MissionAck & msg)
+{
+  // Command latency from the mission stamp to the acceptance by the mission planner
+  const double latency_ms =
+    1e3 * (rclcpp::Time(msg.accepted_stamp) - rclcpp::Time(msg.stamp)).seconds();
+
+  if (msg.accepted) {
+    RCLCPP_INFO(
+      this->get_logger(), "Mission %u (priority %u) accepted after %.2f ms", msg.mission_type,
+      msg.priority, latency_ms);
+  } else {
+    RCLCPP_WARN(
+      this->get_logger(), "Mission %u (priority %u) rejected after %.2f ms", msg.mission_type,
+      msg.priority, latency_ms);
+  }
+}
+
+bool HMINode::ParseMissionType_(const std::string & mission, std::uint8_t & mission_type)
 {
-  autoware_mapless_planning_msgs::msg::Mission missionMessage;
   if (mission == "LANE_KEEP") {
-    missionMessage.mission_type = autoware_mapless_planning_msgs::msg::Mission::LANE_KEEP;
+    mission_type = autoware_mapless_planning_msgs::msg::Mission::LANE_KEEP;
   } else if (mission == "LANE_CHANGE_LEFT") {
-    missionMessage.mission_type = autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_LEFT;
+    mission_type = autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_LEFT;
   } else if (mission == "LANE_CHANGE_RIGHT") {
-    missionMessage.mission_type = autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_RIGHT;
+    mission_type = autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_RIGHT;
   } else if (mission == "TAKE_NEXT_EXIT_LEFT") {
-    missionMessage.mission_type = autoware_mapless_planning_msgs::msg::Mission::TAKE_NEXT_EXIT_LEFT;
+    mission_type = autoware_mapless_planning_msgs::msg::Mission::TAKE_NEXT_EXIT_LEFT;
   } else if (mission == "TAKE_NEXT_EXIT_RIGHT") {
-    missionMessage.mission_type =
-      autoware_mapless_planning_msgs::msg::Mission::TAKE_NEXT_EXIT_RIGHT;
+    mission_type = autoware_mapless_planning_msgs::msg::Mission::TAKE_NEXT_EXIT_RIGHT;
+  } else {
+    return false;
   }
+  return true;
+}
+
+builtin_interfaces::msg::Time HMINode::PublishMission_(
+  autoware_mapless_planning_msgs::msg::Mission mission)
+{
+  MAPLESS_TRACE_SCOPE("hmi", "publish mission");
 
-  missionMessage.deadline = 1000;  // This parameter can be changed if needed (it will be set by the
-                                   // software in the future).
+  // The stamp is the reference of the command latency (kept if set by the commanding client)
+  if (mission.stamp.sec == 0 && mission.stamp.nanosec == 0) {
+    mission.stamp = this->now();
+  }
 
-  mission_publisher_->publish(missionMessage);
+  mission_publisher_->publish(mission);
+  return mission.stamp;
 }
 }  // namespace autoware::mapless_architecture
 
@@ -15,10 +15,17 @@
 #ifndef AUTOWARE__LOCAL_MAP_PROVIDER__LOCAL_MAP_PROVIDER_NODE_HPP_
 #define AUTOWARE__LOCAL_MAP_PROVIDER__LOCAL_MAP_PROVIDER_NODE_HPP_
 
+#include "autoware/local_map_provider/shm_road_segments_ring.hpp"
+#include "autoware/local_mission_planner_common/polyline_simplifier.hpp"
 #include "rclcpp/rclcpp.hpp"
 
 #include "autoware_mapless_planning_msgs/msg/local_map.hpp"
 #include "autoware_mapless_planning_msgs/msg/road_segments.hpp"
+#include "std_srvs/srv/trigger.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
 
 namespace autoware::mapless_architecture
 {
@@ -45,12 +52,33 @@ private:
    */
   void CallbackRoadSegmentsMessages_(const autoware_mapless_planning_msgs::msg::RoadSegments & msg);
 
+  /**
+   * @brief Poll the shared-memory ring for a new RoadSegments frame (replaces the subscriber if
+   * shm_ring_name is set).
+   */
+  void TimedSharedMemoryCallback_();
+
+  // Shared-memory input (optional)
+  std::string shm_ring_name_;
+  std::unique_ptr<ShmRoadSegmentsRing> shm_ring_;
+  autoware_mapless_planning_msgs::msg::RoadSegments shm_road_segments_;
+  std::uint64_t n_polls_without_frame_ = 0;
+  std::uint64_t n_polls_reopen_check_ = 0;  // Polls without frame until the ring is checked
+
+  // Simplification of the linestrings (optional)
+  double simplification_max_lateral_error_;
+  PolylineSimplifier polyline_simplifier_;
+
   // Declare ROS2 publisher and subscriber
 
   rclcpp::Publisher<autoware_mapless_planning_msgs::msg::LocalMap>::SharedPtr map_publisher_;
 
   rclcpp::Subscription<autoware_mapless_planning_msgs::msg::RoadSegments>::SharedPtr
     road_subscriber_;
+
+  rclcpp::TimerBase::SharedPtr shm_timer_;
+
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr trace_dump_service_;
 };
 }  // namespace autoware::mapless_architecture
 
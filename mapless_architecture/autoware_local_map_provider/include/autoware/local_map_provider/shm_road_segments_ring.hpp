@@ -0,0 +1,196 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MAP_PROVIDER__SHM_ROAD_SEGMENTS_RING_HPP_
+#define AUTOWARE__LOCAL_MAP_PROVIDER__SHM_ROAD_SEGMENTS_RING_HPP_
+
+#include "autoware_mapless_planning_msgs/msg/road_segments.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Binary layout of the shared-memory ring for RoadSegments (version 1).
+ *
+ * All values are stored in the byte order of the host (both processes run on the same ECU). The
+ * shared-memory object (shm_open() name, e.g. "/mapless_road_segments") consists of:
+ *
+ * - ShmRingHeader (64 bytes) at offset 0
+ * - n_slots slots of slot_size bytes each (multiple of 64), slot i at offset 64 + i * slot_size
+ *
+ * Each slot starts with a ShmSlotHeader (16 bytes), followed by the payload of one frame:
+ *
+ * - ShmFrameRecord (104 bytes)
+ * - n_segments times:
+ *   - ShmSegmentRecord (24 bytes)
+ *   - int32 successor ids [n_successors], int32 neighbor ids [n_neighbors], zero padding to a
+ *     multiple of 8 bytes
+ *   - double positions [n_poses_left + n_poses_right][3] (x, y, z of the left linestring, then of
+ *     the right linestring; the orientation of the linestring poses is not transported)
+ *
+ * Protocol (single producer, single consumer, the producer never waits): the producer writes frame
+ * k into slot k % n_slots. It sets the slot sequence to 2 * k + 1 (release) before and to
+ * 2 * k + 2 (release) after writing the payload, then it increments write_count (release). The
+ * consumer reads the slot of frame write_count - 1 and discards it if the slot sequence changed
+ * during the read or is odd (the producer overtook the consumer, which only happens if the
+ * consumer is stalled for n_slots frames).
+ */
+struct ShmRingHeader
+{
+  std::uint32_t magic;      // kShmRingMagic
+  std::uint32_t version;    // kShmRingVersion
+  std::uint32_t n_slots;    // Number of slots
+  std::uint32_t slot_size;  // Bytes per slot (incl. ShmSlotHeader)
+
+  // Number of written frames
+  std::atomic<std::uint64_t> write_count;
+  std::uint8_t reserved[40];
+};
+
+struct ShmSlotHeader
+{
+  std::atomic<std::uint64_t> sequence;  // Odd: being written, even: complete (0: never written)
+  std::uint32_t payload_size;           // Bytes of the payload following this header
+  std::uint32_t reserved;
+};
+
+struct ShmFrameRecord
+{
+  std::int32_t stamp_sec;
+  std::uint32_t stamp_nanosec;
+  char frame_id[32];      // Null-terminated
+  double position[3];     // Ego pose (x, y, z)
+  double orientation[4];  // Ego pose (quaternion x, y, z, w)
+  std::uint32_t n_segments;
+  std::uint32_t reserved;
+};
+
+struct ShmSegmentRecord
+{
+  std::uint32_t id;
+  std::uint32_t n_successors;
+  std::uint32_t n_neighbors;
+  std::uint32_t n_poses_left;
+  std::uint32_t n_poses_right;
+  std::uint32_t reserved;
+};
+
+constexpr std::uint32_t kShmRingMagic = 0x53524c4d;  // "MLRS"
+constexpr std::uint32_t kShmRingVersion = 1;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Lock-free atomics are required");
+static_assert(sizeof(ShmRingHeader) == 64, "Unexpected size of ShmRingHeader");
+static_assert(sizeof(ShmSlotHeader) == 16, "Unexpected size of ShmSlotHeader");
+static_assert(sizeof(ShmFrameRecord) == 104, "Unexpected size of ShmFrameRecord");
+static_assert(sizeof(ShmSegmentRecord) == 24, "Unexpected size of ShmSegmentRecord");
+
+/**
+ * @brief Single-producer/single-consumer ring of RoadSegments frames in POSIX shared memory (see
+ * ShmRingHeader for the binary layout), the latest frame is read without serialization middleware.
+ */
+class ShmRoadSegmentsRing
+{
+public:
+  /**
+   * @brief Create the shared-memory object (producer, an existing object is replaced).
+   *
+   * @param name The name of the shared-memory object (e.g. "/mapless_road_segments").
+   * @param n_slots The number of slots (>= 2).
+   * @param slot_size The maximum size of a frame in bytes (rounded up to a multiple of 64).
+   * @param error The error message (output, if nullptr is returned).
+   * @return The ring or nullptr.
+   */
+  static std::unique_ptr<ShmRoadSegmentsRing> Create(
+    const std::string & name, const std::uint32_t n_slots, const std::uint32_t slot_size,
+    std::string & error);
+
+  /**
+   * @brief Open an existing shared-memory object (consumer).
+   *
+   * @param name The name of the shared-memory object.
+   * @param error The error message (output, if nullptr is returned).
+   * @return The ring or nullptr.
+   */
+  static std::unique_ptr<ShmRoadSegmentsRing> Open(const std::string & name, std::string & error);
+
+  ~ShmRoadSegmentsRing();
+
+  ShmRoadSegmentsRing(const ShmRoadSegmentsRing &) = delete;
+  ShmRoadSegmentsRing & operator=(const ShmRoadSegmentsRing &) = delete;
+
+  /**
+   * @brief Write a frame into the next slot (producer).
+   *
+   * @param msg The road segments.
+   * @return False if the frame does not fit into a slot.
+   */
+  bool Write(const autoware_mapless_planning_msgs::msg::RoadSegments & msg);
+
+  /**
+   * @brief Read the latest frame if a new one was written since the last call (consumer).
+   *
+   * @param msg The road segments (output, the capacity of the containers is reused).
+   * @return False if there is no new (complete) frame.
+   */
+  bool ReadLatest(autoware_mapless_planning_msgs::msg::RoadSegments & msg);
+
+  /**
+   * @brief Get the number of frames which were written, but not read by ReadLatest() (because a
+   * newer frame was available or the frame was overwritten during the read).
+   */
+  std::uint64_t GetSkippedFrameCount() const { return n_skipped_frames_; }
+
+  /**
+   * @brief Check whether the shared-memory object was removed or replaced (e.g. by a restarted
+   * producer) since it was opened (consumer).
+   */
+  bool IsReplaced() const;
+
+  /**
+   * @brief Get the payload size of a frame in bytes (e.g. to choose the slot size).
+   */
+  static std::size_t GetPayloadSize(const autoware_mapless_planning_msgs::msg::RoadSegments & msg);
+
+private:
+  ShmRoadSegmentsRing(
+    void * memory, const std::size_t size, const std::string & name, bool owner,
+    const std::uint32_t n_slots, const std::uint32_t slot_size);
+
+  std::uint8_t * Slot(const std::uint64_t frame) const;
+
+  void * memory_;
+  std::size_t size_;
+  std::string name_;
+  bool is_owner_;
+  ShmRingHeader * header_;
+
+  // Ring geometry validated by Create()/Open(), the header in shared memory is not read again (a
+  // faulty producer could change it and move the slots out of the mapping)
+  std::uint32_t n_slots_;
+  std::uint32_t slot_size_;
+  std::uint64_t inode_ = 0;
+
+  std::uint64_t n_read_frames_ = 0;  // write_count at the last successful read
+  std::uint64_t n_skipped_frames_ = 0;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MAP_PROVIDER__SHM_ROAD_SEGMENTS_RING_HPP_
@@ -14,6 +14,13 @@
 
 #include "autoware/local_map_provider/local_map_provider_node.hpp"
 
+#include "autoware/local_mission_planner_common/trace_recorder.hpp"
+#include "autoware/local_mission_planner_common/trace_service.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 namespace autoware::mapless_architecture
 {
 using std::placeholders::_1;
@@ -30,24 +37,108 @@ LocalMapProviderNode::LocalMapProviderNode(const rclcpp::NodeOptions & options)
   map_publisher_ = this->create_publisher<autoware_mapless_planning_msgs::msg::LocalMap>(
     "local_map_provider_node/output/local_map", 1);
 
-  // Initialize subscriber to road segments messages
-  road_subscriber_ = this->create_subscription<autoware_mapless_planning_msgs::msg::RoadSegments>(
-    "local_map_provider_node/input/road_segments", qos,
-    std::bind(&LocalMapProviderNode::CallbackRoadSegmentsMessages_, this, _1));
+  // ROS parameters (will be overwritten by external param file if exists)
+  shm_ring_name_ = declare_parameter<std::string>("shm_ring_name", "");
+  RCLCPP_INFO(
+    this->get_logger(),
+    "Shared-memory ring of the road segments (empty: the input topic is used): %s",
+    shm_ring_name_.c_str());
+
+  const double shm_poll_period_ms = declare_parameter<double>("shm_poll_period_ms", 2.0);
+  RCLCPP_INFO(
+    this->get_logger(), "Poll period of the shared-memory ring: %.1f ms", shm_poll_period_ms);
+
+  simplification_max_lateral_error_ =
+    declare_parameter<double>("simplification_max_lateral_error", 0.0);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "Maximum lateral error of the simplification of the linestrings (0 disables it): %.3f m",
+    simplification_max_lateral_error_);
+
+  if (shm_ring_name_.empty()) {
+    // Initialize subscriber to road segments messages
+    road_subscriber_ =
+      this->create_subscription<autoware_mapless_planning_msgs::msg::RoadSegments>(
+        "local_map_provider_node/input/road_segments", qos,
+        std::bind(&LocalMapProviderNode::CallbackRoadSegmentsMessages_, this, _1));
+  } else {
+    // Poll the shared-memory ring instead (the ring is opened once the producer created it), the
+    // ring is checked for a restarted producer after 1 s without frames
+    const double period_ms = std::max(shm_poll_period_ms, 0.1);
+    n_polls_reopen_check_ = static_cast<std::uint64_t>(std::ceil(1000.0 / period_ms));
+    shm_timer_ = this->create_wall_timer(
+      std::chrono::duration<double, std::milli>(period_ms),
+      std::bind(&LocalMapProviderNode::TimedSharedMemoryCallback_, this));
+  }
+
+  // Service to write the recorded trace events to a file
+  trace_dump_service_ = CreateTraceDumpService(*this);
 }
 
 void LocalMapProviderNode::CallbackRoadSegmentsMessages_(
   const autoware_mapless_planning_msgs::msg::RoadSegments & msg)
 {
+  MAPLESS_TRACE_SCOPE("local_map_provider", "road segments callback");
+
   autoware_mapless_planning_msgs::msg::LocalMap local_map;
 
   // Save road segments in the local map message
   local_map.road_segments = msg;
 
+  // Simplify the linestrings, all later stages process the reduced points
+  if (simplification_max_lateral_error_ > 0.0) {
+    MAPLESS_TRACE_SCOPE("local_map_provider", "simplify");
+    polyline_simplifier_.Simplify(local_map.road_segments, simplification_max_lateral_error_);
+    RCLCPP_INFO_THROTTLE(
+      this->get_logger(), *this->get_clock(), 10000,
+      "Simplification of the linestrings: %.1f %% of the points removed (%zu of %zu)",
+      100.0 * polyline_simplifier_.GetReductionRatio(),
+      static_cast<std::size_t>(
+        polyline_simplifier_.GetInputPointCount() - polyline_simplifier_.GetOutputPointCount()),
+      static_cast<std::size_t>(polyline_simplifier_.GetInputPointCount()));
+  }
+
   // Publish the LocalMap message
+  MAPLESS_TRACE_SCOPE("local_map_provider", "publish");
   map_publisher_->publish(
     local_map);  // Outlook: Add global map, sign detection etc. to the message
 }
+
+void LocalMapProviderNode::TimedSharedMemoryCallback_()
+{
+  if (!shm_ring_) {
+    std::string error;
+    shm_ring_ = ShmRoadSegmentsRing::Open(shm_ring_name_, error);
+    if (!shm_ring_) {
+      RCLCPP_WARN_THROTTLE(
+        this->get_logger(), *this->get_clock(), 5000,
+        "Waiting for the shared-memory ring of the road segments: %s", error.c_str());
+      return;
+    }
+    RCLCPP_INFO(
+      this->get_logger(), "Opened the shared-memory ring of the road segments: %s",
+      shm_ring_name_.c_str());
+    n_polls_without_frame_ = 0;
+  }
+
+  if (shm_ring_->ReadLatest(shm_road_segments_)) {
+    n_polls_without_frame_ = 0;
+    CallbackRoadSegmentsMessages_(shm_road_segments_);
+    return;
+  }
+
+  // Reopen the ring if the producer was restarted (it replaces the shared-memory object)
+  if (++n_polls_without_frame_ >= n_polls_reopen_check_) {
+    n_polls_without_frame_ = 0;
+    if (shm_ring_->IsReplaced()) {
+      RCLCPP_WARN(
+        this->get_logger(),
+        "The shared-memory ring of the road segments was replaced, skipped frames: %zu",
+        static_cast<std::size_t>(shm_ring_->GetSkippedFrameCount()));
+      shm_ring_.reset();
+    }
+  }
+}
 }  // namespace autoware::mapless_architecture
 
 #include "rclcpp_components/register_node_macro.hpp"
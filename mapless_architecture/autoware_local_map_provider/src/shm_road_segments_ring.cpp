@@ -0,0 +1,396 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_map_provider/shm_road_segments_ring.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace autoware::mapless_architecture
+{
+
+namespace
+{
+
+constexpr std::size_t kAlignment = 64;
+
+std::size_t AlignUp(const std::size_t value, const std::size_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// Sequential writer into a slot payload (bounds are checked by the caller via GetPayloadSize())
+class PayloadWriter
+{
+public:
+  explicit PayloadWriter(std::uint8_t * data) : data_(data) {}
+
+  template <typename T>
+  void Put(const T & value)
+  {
+    std::memcpy(data_ + pos_, &value, sizeof(T));
+    pos_ += sizeof(T);
+  }
+
+  void PadTo8()
+  {
+    while (pos_ % 8 != 0) data_[pos_++] = 0;
+  }
+
+  std::size_t GetSize() const { return pos_; }
+
+private:
+  std::uint8_t * data_;
+  std::size_t pos_ = 0;
+};
+
+// Sequential reader of a slot payload, all reads are bounds-checked (the payload may be
+// overwritten by the producer during the read)
+class PayloadReader
+{
+public:
+  PayloadReader(const std::uint8_t * data, const std::size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  bool Get(T & value)
+  {
+    if (size_ - pos_ < sizeof(T)) return false;
+    std::memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool SkipTo8()
+  {
+    pos_ = AlignUp(pos_, 8);
+    return pos_ <= size_;
+  }
+
+  std::size_t GetRemaining() const { return size_ - pos_; }
+
+private:
+  const std::uint8_t * data_;
+  std::size_t size_;
+  std::size_t pos_ = 0;
+};
+
+std::string GetErrnoString(const std::string & what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+}  // namespace
+
+std::unique_ptr<ShmRoadSegmentsRing> ShmRoadSegmentsRing::Create(
+  const std::string & name, const std::uint32_t n_slots, const std::uint32_t slot_size,
+  std::string & error)
+{
+  if (n_slots < 2) {
+    error = "At least 2 slots are required";
+    return nullptr;
+  }
+  const std::size_t slot_size_aligned =
+    AlignUp(static_cast<std::size_t>(slot_size) + sizeof(ShmSlotHeader), kAlignment);
+  const std::size_t size = sizeof(ShmRingHeader) + n_slots * slot_size_aligned;
+
+  // Replace an existing object (e.g. of a previous run), the consumer detects the replacement
+  shm_unlink(name.c_str());
+  const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+  if (fd < 0) {
+    error = GetErrnoString("shm_open(" + name + ")");
+    return nullptr;
+  }
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    error = GetErrnoString("ftruncate");
+    close(fd);
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  void * memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    error = GetErrnoString("mmap");
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+
+  // The memory is zero-initialized (write_count and all slot sequences are 0), the magic is
+  // written last, so a consumer never sees a partially initialized header
+  ShmRingHeader * header = new (memory) ShmRingHeader;
+  header->version = kShmRingVersion;
+  header->n_slots = n_slots;
+  header->slot_size = static_cast<std::uint32_t>(slot_size_aligned);
+  header->write_count.store(0, std::memory_order_relaxed);
+  for (std::uint32_t i = 0; i < n_slots; i++) {
+    new (static_cast<std::uint8_t *>(memory) + sizeof(ShmRingHeader) + i * slot_size_aligned)
+      ShmSlotHeader{};
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = kShmRingMagic;
+
+  return std::unique_ptr<ShmRoadSegmentsRing>(new ShmRoadSegmentsRing(
+    memory, size, name, true, n_slots, static_cast<std::uint32_t>(slot_size_aligned)));
+}
+
+std::unique_ptr<ShmRoadSegmentsRing> ShmRoadSegmentsRing::Open(
+  const std::string & name, std::string & error)
+{
+  const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    error = GetErrnoString("shm_open(" + name + ")");
+    return nullptr;
+  }
+  struct stat stat_buffer;
+  if (fstat(fd, &stat_buffer) != 0) {
+    error = GetErrnoString("fstat");
+    close(fd);
+    return nullptr;
+  }
+  const std::size_t size = static_cast<std::size_t>(stat_buffer.st_size);
+  if (size < sizeof(ShmRingHeader)) {
+    error = "Shared-memory object is not initialized yet";
+    close(fd);
+    return nullptr;
+  }
+  void * memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    error = GetErrnoString("mmap");
+    return nullptr;
+  }
+
+  // Validate the header (each value is read once, the validated values are used from here on)
+  const ShmRingHeader * header = static_cast<const ShmRingHeader *>(memory);
+  const std::uint32_t magic = header->magic;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const std::uint32_t version = header->version;
+  const std::uint32_t n_slots = header->n_slots;
+  const std::uint32_t slot_size = header->slot_size;
+  if (magic != kShmRingMagic) {
+    error = "Shared-memory object is not initialized yet";
+  } else if (version != kShmRingVersion) {
+    error = "Unsupported layout version " + std::to_string(version);
+  } else if (
+    n_slots < 2 || slot_size % kAlignment != 0 || slot_size <= sizeof(ShmSlotHeader) ||
+    size < sizeof(ShmRingHeader) + static_cast<std::size_t>(n_slots) * slot_size) {
+    error = "Invalid ring header";
+  } else {
+    auto ring = std::unique_ptr<ShmRoadSegmentsRing>(
+      new ShmRoadSegmentsRing(memory, size, name, false, n_slots, slot_size));
+    ring->inode_ = stat_buffer.st_ino;
+    return ring;
+  }
+  munmap(memory, size);
+  return nullptr;
+}
+
+ShmRoadSegmentsRing::ShmRoadSegmentsRing(
+  void * memory, const std::size_t size, const std::string & name, bool owner,
+  const std::uint32_t n_slots, const std::uint32_t slot_size)
+: memory_(memory),
+  size_(size),
+  name_(name),
+  is_owner_(owner),
+  header_(static_cast<ShmRingHeader *>(memory)),
+  n_slots_(n_slots),
+  slot_size_(slot_size)
+{
+}
+
+ShmRoadSegmentsRing::~ShmRoadSegmentsRing()
+{
+  munmap(memory_, size_);
+  if (is_owner_) shm_unlink(name_.c_str());
+}
+
+std::uint8_t * ShmRoadSegmentsRing::Slot(const std::uint64_t frame) const
+{
+  return static_cast<std::uint8_t *>(memory_) + sizeof(ShmRingHeader) +
+         (frame % n_slots_) * static_cast<std::size_t>(slot_size_);
+}
+
+std::size_t ShmRoadSegmentsRing::GetPayloadSize(
+  const autoware_mapless_planning_msgs::msg::RoadSegments & msg)
+{
+  std::size_t size = sizeof(ShmFrameRecord);
+  for (const auto & segment : msg.segments) {
+    size += sizeof(ShmSegmentRecord);
+    size += AlignUp(
+      sizeof(std::int32_t) *
+        (segment.successor_segment_id.size() + segment.neighboring_segment_id.size()),
+      8);
+    size += 3 * sizeof(double) *
+            (segment.linestrings[0].poses.size() + segment.linestrings[1].poses.size());
+  }
+  return size;
+}
+
+bool ShmRoadSegmentsRing::Write(const autoware_mapless_planning_msgs::msg::RoadSegments & msg)
+{
+  if (
+    GetPayloadSize(msg) > slot_size_ - sizeof(ShmSlotHeader) ||
+    msg.header.frame_id.size() >= sizeof(ShmFrameRecord::frame_id)) {
+    return false;
+  }
+
+  // Single producer, i.e. write_count is only modified here
+  const std::uint64_t frame = header_->write_count.load(std::memory_order_relaxed);
+  std::uint8_t * slot = Slot(frame);
+  ShmSlotHeader * slot_header = reinterpret_cast<ShmSlotHeader *>(slot);
+
+  // Mark the slot as being written before the payload is modified
+  slot_header->sequence.store(2 * frame + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  PayloadWriter writer(slot + sizeof(ShmSlotHeader));
+
+  ShmFrameRecord frame_record{};
+  frame_record.stamp_sec = msg.header.stamp.sec;
+  frame_record.stamp_nanosec = msg.header.stamp.nanosec;
+  std::memcpy(frame_record.frame_id, msg.header.frame_id.data(), msg.header.frame_id.size());
+  frame_record.position[0] = msg.pose.position.x;
+  frame_record.position[1] = msg.pose.position.y;
+  frame_record.position[2] = msg.pose.position.z;
+  frame_record.orientation[0] = msg.pose.orientation.x;
+  frame_record.orientation[1] = msg.pose.orientation.y;
+  frame_record.orientation[2] = msg.pose.orientation.z;
+  frame_record.orientation[3] = msg.pose.orientation.w;
+  frame_record.n_segments = static_cast<std::uint32_t>(msg.segments.size());
+  writer.Put(frame_record);
+
+  for (const auto & segment : msg.segments) {
+    ShmSegmentRecord segment_record{};
+    segment_record.id = segment.id;
+    segment_record.n_successors = static_cast<std::uint32_t>(segment.successor_segment_id.size());
+    segment_record.n_neighbors = static_cast<std::uint32_t>(segment.neighboring_segment_id.size());
+    segment_record.n_poses_left = static_cast<std::uint32_t>(segment.linestrings[0].poses.size());
+    segment_record.n_poses_right = static_cast<std::uint32_t>(segment.linestrings[1].poses.size());
+    writer.Put(segment_record);
+
+    for (const std::int32_t id : segment.successor_segment_id) writer.Put(id);
+    for (const std::int32_t id : segment.neighboring_segment_id) writer.Put(id);
+    writer.PadTo8();
+
+    for (const auto & linestring : segment.linestrings) {
+      for (const auto & pose : linestring.poses) {
+        writer.Put(pose.position.x);
+        writer.Put(pose.position.y);
+        writer.Put(pose.position.z);
+      }
+    }
+  }
+  slot_header->payload_size = static_cast<std::uint32_t>(writer.GetSize());
+
+  // Publish the frame
+  slot_header->sequence.store(2 * frame + 2, std::memory_order_release);
+  header_->write_count.store(frame + 1, std::memory_order_release);
+  return true;
+}
+
+bool ShmRoadSegmentsRing::ReadLatest(autoware_mapless_planning_msgs::msg::RoadSegments & msg)
+{
+  const std::uint64_t n_written = header_->write_count.load(std::memory_order_acquire);
+  if (n_written == n_read_frames_) return false;
+
+  const std::uint64_t frame = n_written - 1;
+  const std::uint8_t * slot = Slot(frame);
+  const ShmSlotHeader * slot_header = reinterpret_cast<const ShmSlotHeader *>(slot);
+
+  const std::uint64_t sequence = slot_header->sequence.load(std::memory_order_acquire);
+  if (sequence != 2 * frame + 2) return false;  // Already overwritten, retry with the next call
+
+  const std::size_t payload_size = std::min<std::size_t>(
+    slot_header->payload_size, slot_size_ - sizeof(ShmSlotHeader));
+  PayloadReader reader(slot + sizeof(ShmSlotHeader), payload_size);
+
+  // Decode (the counts are bounded by the remaining payload, so a torn read cannot overflow)
+  bool is_ok = true;
+  ShmFrameRecord frame_record;
+  is_ok = reader.Get(frame_record);
+  if (is_ok) {
+    frame_record.frame_id[sizeof(frame_record.frame_id) - 1] = '\0';
+    msg.header.stamp.sec = frame_record.stamp_sec;
+    msg.header.stamp.nanosec = frame_record.stamp_nanosec;
+    msg.header.frame_id = frame_record.frame_id;
+    msg.pose.position.x = frame_record.position[0];
+    msg.pose.position.y = frame_record.position[1];
+    msg.pose.position.z = frame_record.position[2];
+    msg.pose.orientation.x = frame_record.orientation[0];
+    msg.pose.orientation.y = frame_record.orientation[1];
+    msg.pose.orientation.z = frame_record.orientation[2];
+    msg.pose.orientation.w = frame_record.orientation[3];
+    is_ok = frame_record.n_segments <= reader.GetRemaining() / sizeof(ShmSegmentRecord);
+  }
+  if (is_ok) msg.segments.resize(frame_record.n_segments);
+
+  for (std::size_t i = 0; is_ok && i < msg.segments.size(); i++) {
+    auto & segment = msg.segments[i];
+    ShmSegmentRecord segment_record;
+    is_ok = reader.Get(segment_record) &&
+            static_cast<std::size_t>(segment_record.n_successors) + segment_record.n_neighbors <=
+              reader.GetRemaining() / sizeof(std::int32_t);
+    if (!is_ok) break;
+
+    segment.id = static_cast<std::uint16_t>(segment_record.id);
+    segment.successor_segment_id.resize(segment_record.n_successors);
+    for (auto & id : segment.successor_segment_id) reader.Get(id);
+    segment.neighboring_segment_id.resize(segment_record.n_neighbors);
+    for (auto & id : segment.neighboring_segment_id) reader.Get(id);
+    is_ok = reader.SkipTo8() && static_cast<std::size_t>(segment_record.n_poses_left) +
+                                    segment_record.n_poses_right <=
+                                  reader.GetRemaining() / (3 * sizeof(double));
+    if (!is_ok) break;
+
+    const std::uint32_t n_poses[2] = {segment_record.n_poses_left, segment_record.n_poses_right};
+    for (std::size_t j = 0; j < 2; j++) {
+      auto & poses = segment.linestrings[j].poses;
+      poses.resize(n_poses[j]);
+      for (auto & pose : poses) {
+        reader.Get(pose.position.x);
+        reader.Get(pose.position.y);
+        reader.Get(pose.position.z);
+        pose.orientation = geometry_msgs::msg::Quaternion();
+      }
+    }
+  }
+
+  // The frame is valid if the producer did not overwrite the slot during the read
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (!is_ok || slot_header->sequence.load(std::memory_order_relaxed) != sequence) return false;
+
+  n_skipped_frames_ += n_written - n_read_frames_ - 1;
+  n_read_frames_ = n_written;
+  return true;
+}
+
+bool ShmRoadSegmentsRing::IsReplaced() const
+{
+  const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) return true;
+
+  struct stat stat_buffer;
+  const bool is_replaced = fstat(fd, &stat_buffer) != 0 || stat_buffer.st_ino != inode_;
+  close(fd);
+  return is_replaced;
+}
+
+}  // namespace autoware::mapless_architecture
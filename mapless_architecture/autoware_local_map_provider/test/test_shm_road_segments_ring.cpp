@@ -0,0 +1,313 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_map_provider/shm_road_segments_ring.hpp"
+#include "gtest/gtest.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace autoware::mapless_architecture
+{
+
+namespace
+{
+
+// Road segments whose content depends on the index of the frame (all values of a frame can be
+// checked for consistency, see IsConsistent())
+autoware_mapless_planning_msgs::msg::RoadSegments CreateRoadSegments(const int id_frame)
+{
+  autoware_mapless_planning_msgs::msg::RoadSegments msg;
+  msg.header.frame_id = "map";
+  msg.header.stamp.sec = id_frame;
+  msg.pose.position.x = id_frame;
+  msg.pose.orientation.w = 1.0;
+
+  const int n_segments = 1 + id_frame % 4;
+  for (int i = 0; i < n_segments; i++) {
+    autoware_mapless_planning_msgs::msg::Segment segment;
+    segment.id = static_cast<std::uint16_t>(i);
+    segment.successor_segment_id.push_back(i + 1 < n_segments ? i + 1 : -1);
+    segment.neighboring_segment_id = {-1, -1};
+    for (int j = 0; j < 2; j++) {
+      for (int k = 0; k < 3 + i; k++) {
+        geometry_msgs::msg::Pose pose;
+        pose.position.x = 10.0 * i + k;
+        pose.position.y = j == 0 ? 1.75 : -1.75;
+        pose.position.z = id_frame;
+        segment.linestrings[j].poses.push_back(pose);
+      }
+    }
+    msg.segments.push_back(segment);
+  }
+  return msg;
+}
+
+// Check that a read frame equals the frame written by CreateRoadSegments()
+bool IsConsistent(const autoware_mapless_planning_msgs::msg::RoadSegments & msg)
+{
+  const auto expected = CreateRoadSegments(msg.header.stamp.sec);
+  if (
+    msg.header.frame_id != expected.header.frame_id ||
+    msg.pose.position.x != expected.pose.position.x ||
+    msg.segments.size() != expected.segments.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < msg.segments.size(); i++) {
+    const auto & segment = msg.segments[i];
+    const auto & segment_expected = expected.segments[i];
+    if (
+      segment.id != segment_expected.id ||
+      segment.successor_segment_id != segment_expected.successor_segment_id ||
+      segment.neighboring_segment_id != segment_expected.neighboring_segment_id) {
+      return false;
+    }
+    for (std::size_t j = 0; j < 2; j++) {
+      const auto & poses = segment.linestrings[j].poses;
+      const auto & poses_expected = segment_expected.linestrings[j].poses;
+      if (poses.size() != poses_expected.size()) return false;
+      for (std::size_t k = 0; k < poses.size(); k++) {
+        if (
+          poses[k].position.x != poses_expected[k].position.x ||
+          poses[k].position.y != poses_expected[k].position.y ||
+          poses[k].position.z != poses_expected[k].position.z) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Writable mapping of a shared-memory object (simulates a faulty producer)
+class RawMapping
+{
+public:
+  RawMapping(const std::string & name, const std::size_t size, const bool create) : size_(size)
+  {
+    const int fd = shm_open(name.c_str(), create ? O_CREAT | O_RDWR : O_RDWR, 0660);
+    if (fd < 0) return;
+    if (!create || ftruncate(fd, static_cast<off_t>(size)) == 0) {
+      void * memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (memory != MAP_FAILED) data_ = static_cast<std::uint8_t *>(memory);
+    }
+    close(fd);
+  }
+
+  ~RawMapping()
+  {
+    if (data_ != nullptr) munmap(data_, size_);
+  }
+
+  std::uint8_t * GetData() const { return data_; }
+
+  ShmRingHeader * GetHeader() const { return reinterpret_cast<ShmRingHeader *>(data_); }
+
+  ShmSlotHeader * GetSlotHeader(const std::size_t index) const
+  {
+    return reinterpret_cast<ShmSlotHeader *>(
+      data_ + sizeof(ShmRingHeader) + index * GetHeader()->slot_size);
+  }
+
+private:
+  std::uint8_t * data_ = nullptr;
+  std::size_t size_;
+};
+
+// Unique shared-memory name per test (tests may run in parallel)
+std::string GetShmName(const std::string & test_name)
+{
+  return "/mapless_test_" + test_name + "_" + std::to_string(getpid());
+}
+
+}  // namespace
+
+TEST(ShmRoadSegmentsRingTest, TestRoundTrip)
+{
+  const std::string name = GetShmName("round_trip");
+  std::string error;
+  auto producer = ShmRoadSegmentsRing::Create(name, 4, 4096, error);
+  ASSERT_NE(producer, nullptr) << error;
+  auto consumer = ShmRoadSegmentsRing::Open(name, error);
+  ASSERT_NE(consumer, nullptr) << error;
+
+  // No frame written yet
+  autoware_mapless_planning_msgs::msg::RoadSegments msg;
+  EXPECT_FALSE(consumer->ReadLatest(msg));
+
+  // Each frame is read once
+  ASSERT_TRUE(producer->Write(CreateRoadSegments(1)));
+  ASSERT_TRUE(consumer->ReadLatest(msg));
+  EXPECT_EQ(msg.header.stamp.sec, 1);
+  EXPECT_TRUE(IsConsistent(msg));
+  EXPECT_FALSE(consumer->ReadLatest(msg));
+
+  // Only the latest frame is read, the older frames are counted as skipped
+  for (int i = 2; i < 9; i++) ASSERT_TRUE(producer->Write(CreateRoadSegments(i)));
+  ASSERT_TRUE(consumer->ReadLatest(msg));
+  EXPECT_EQ(msg.header.stamp.sec, 8);
+  EXPECT_TRUE(IsConsistent(msg));
+  EXPECT_EQ(consumer->GetSkippedFrameCount(), 6u);
+  EXPECT_FALSE(consumer->IsReplaced());
+
+  // A restarted producer replaces the object
+  producer.reset();
+  producer = ShmRoadSegmentsRing::Create(name, 4, 4096, error);
+  ASSERT_NE(producer, nullptr) << error;
+  EXPECT_TRUE(consumer->IsReplaced());
+}
+
+TEST(ShmRoadSegmentsRingTest, TestOverwriteDuringRead)
+{
+  const std::string name = GetShmName("overwrite");
+  std::string error;
+  auto producer = ShmRoadSegmentsRing::Create(name, 2, 4096, error);
+  ASSERT_NE(producer, nullptr) << error;
+  auto consumer = ShmRoadSegmentsRing::Open(name, error);
+  ASSERT_NE(consumer, nullptr) << error;
+
+  // A slot which is being written (odd sequence) is not read
+  ASSERT_TRUE(producer->Write(CreateRoadSegments(0)));
+  RawMapping mapping(name, sizeof(ShmRingHeader) + 2 * 4160, false);
+  ASSERT_NE(mapping.GetData(), nullptr);
+  ShmSlotHeader * slot_header = mapping.GetSlotHeader(0);
+  slot_header->sequence.store(3, std::memory_order_release);
+  autoware_mapless_planning_msgs::msg::RoadSegments msg;
+  EXPECT_FALSE(consumer->ReadLatest(msg));
+
+  // The slot is readable once it is complete
+  slot_header->sequence.store(2, std::memory_order_release);
+  EXPECT_TRUE(consumer->ReadLatest(msg));
+  EXPECT_TRUE(IsConsistent(msg));
+
+  // Concurrent producer (overtakes the consumer often with two slots), every frame which is read
+  // must be consistent
+  std::atomic<bool> is_done{false};
+  std::thread producer_thread([&] {
+    for (int i = 1; i < 20000; i++) producer->Write(CreateRoadSegments(i));
+    is_done = true;
+  });
+  int n_inconsistent = 0;
+  while (!is_done) {
+    if (consumer->ReadLatest(msg) && !IsConsistent(msg)) n_inconsistent++;
+  }
+  producer_thread.join();
+  EXPECT_EQ(n_inconsistent, 0);
+
+  // The last frame is read once the producer is done (unless it was already read in the loop)
+  consumer->ReadLatest(msg);
+  EXPECT_EQ(msg.header.stamp.sec, 19999);
+  EXPECT_TRUE(IsConsistent(msg));
+}
+
+TEST(ShmRoadSegmentsRingTest, TestOversizedFrame)
+{
+  const std::string name = GetShmName("oversized");
+  std::string error;
+  auto producer = ShmRoadSegmentsRing::Create(name, 2, 256, error);
+  ASSERT_NE(producer, nullptr) << error;
+  auto consumer = ShmRoadSegmentsRing::Open(name, error);
+  ASSERT_NE(consumer, nullptr) << error;
+
+  // Four segments do not fit into the slot, the frame is not written
+  const auto msg_large = CreateRoadSegments(3);
+  ASSERT_GT(ShmRoadSegmentsRing::GetPayloadSize(msg_large), 256u);
+  EXPECT_FALSE(producer->Write(msg_large));
+  autoware_mapless_planning_msgs::msg::RoadSegments msg;
+  EXPECT_FALSE(consumer->ReadLatest(msg));
+
+  // Too long frame ids are rejected as well
+  auto msg_frame_id = CreateRoadSegments(0);
+  msg_frame_id.header.frame_id = std::string(40, 'x');
+  EXPECT_FALSE(producer->Write(msg_frame_id));
+
+  // A single segment fits
+  EXPECT_TRUE(producer->Write(CreateRoadSegments(0)));
+  EXPECT_TRUE(consumer->ReadLatest(msg));
+  EXPECT_TRUE(IsConsistent(msg));
+}
+
+TEST(ShmRoadSegmentsRingTest, TestInvalidHeader)
+{
+  const std::string name = GetShmName("invalid_header");
+  const std::size_t size = sizeof(ShmRingHeader) + 2 * 128;
+  shm_unlink(name.c_str());
+  {
+    RawMapping mapping(name, size, true);
+    ASSERT_NE(mapping.GetData(), nullptr);
+    ShmRingHeader * header = mapping.GetHeader();
+    header->n_slots = 2;
+    header->slot_size = 128;
+
+    // Wrong magic
+    header->magic = 0x12345678;
+    header->version = kShmRingVersion;
+    std::string error;
+    EXPECT_EQ(ShmRoadSegmentsRing::Open(name, error), nullptr);
+    EXPECT_FALSE(error.empty());
+
+    // Wrong version
+    header->magic = kShmRingMagic;
+    header->version = kShmRingVersion + 1;
+    error.clear();
+    EXPECT_EQ(ShmRoadSegmentsRing::Open(name, error), nullptr);
+    EXPECT_NE(error.find("version"), std::string::npos);
+
+    // Slots beyond the end of the object
+    header->version = kShmRingVersion;
+    header->n_slots = 3;
+    error.clear();
+    EXPECT_EQ(ShmRoadSegmentsRing::Open(name, error), nullptr);
+    EXPECT_FALSE(error.empty());
+
+    // Valid header
+    header->n_slots = 2;
+    EXPECT_NE(ShmRoadSegmentsRing::Open(name, error), nullptr) << error;
+  }
+  shm_unlink(name.c_str());
+}
+
+TEST(ShmRoadSegmentsRingTest, TestHeaderChangedAfterOpen)
+{
+  const std::string name = GetShmName("header_changed");
+  std::string error;
+  auto producer = ShmRoadSegmentsRing::Create(name, 2, 4096, error);
+  ASSERT_NE(producer, nullptr) << error;
+  auto consumer = ShmRoadSegmentsRing::Open(name, error);
+  ASSERT_NE(consumer, nullptr) << error;
+  ASSERT_TRUE(producer->Write(CreateRoadSegments(1)));
+  ASSERT_TRUE(producer->Write(CreateRoadSegments(2)));
+
+  // The consumer keeps the geometry validated by Open() (the slot of the second frame stays inside
+  // the mapping)
+  RawMapping mapping(name, sizeof(ShmRingHeader), false);
+  ASSERT_NE(mapping.GetData(), nullptr);
+  mapping.GetHeader()->n_slots = 1000000;
+  mapping.GetHeader()->slot_size = 0xffffffc0;
+
+  autoware_mapless_planning_msgs::msg::RoadSegments msg;
+  ASSERT_TRUE(consumer->ReadLatest(msg));
+  EXPECT_EQ(msg.header.stamp.sec, 2);
+  EXPECT_TRUE(IsConsistent(msg));
+}
+
+}  // namespace autoware::mapless_architecture
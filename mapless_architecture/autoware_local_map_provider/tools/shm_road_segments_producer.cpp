@@ -0,0 +1,146 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Test producer for the shared-memory input of the LocalMapProviderNode: writes a synthetic road
+// (parallel straight lanes, split into segments) into the ring at a fixed rate.
+//
+// Usage: shm_road_segments_producer [name] [rate_hz] [n_lanes] [n_segments_per_lane]
+//        [n_points_per_linestring]
+
+#include "autoware/local_map_provider/shm_road_segments_ring.hpp"
+
+#include "autoware_mapless_planning_msgs/msg/road_segments.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+using autoware::mapless_architecture::ShmRoadSegmentsRing;
+
+namespace
+{
+
+volatile std::sig_atomic_t g_is_running = 1;
+
+void HandleSignal(int) { g_is_running = 0; }
+
+// Lane i (from right to left) is 3.5 m wide, segment j of a lane covers x = [j * 10 m, (j + 1) * 10
+// m], the segment id is i * n_segments_per_lane + j
+autoware_mapless_planning_msgs::msg::RoadSegments CreateRoad(
+  const int n_lanes, const int n_segments_per_lane, const int n_points_per_linestring)
+{
+  const double lane_width = 3.5;
+  const double segment_length = 10.0;
+
+  autoware_mapless_planning_msgs::msg::RoadSegments msg;
+  msg.header.frame_id = "map";
+  msg.pose.orientation.w = 1.0;
+
+  for (int i = 0; i < n_lanes; i++) {
+    for (int j = 0; j < n_segments_per_lane; j++) {
+      const int id = i * n_segments_per_lane + j;
+
+      autoware_mapless_planning_msgs::msg::Segment segment;
+      segment.id = static_cast<std::uint16_t>(id);
+
+      for (int side = 0; side < 2; side++) {
+        const double y = (i + (side == 0 ? 0.5 : -0.5)) * lane_width;
+        for (int k = 0; k < n_points_per_linestring; k++) {
+          geometry_msgs::msg::Pose pose;
+          pose.position.x =
+            (j + static_cast<double>(k) / std::max(n_points_per_linestring - 1, 1)) *
+            segment_length;
+          pose.position.y = y;
+          segment.linestrings[side].poses.push_back(pose);
+        }
+      }
+
+      segment.successor_segment_id.push_back(j + 1 < n_segments_per_lane ? id + 1 : -1);
+      segment.neighboring_segment_id.push_back(i + 1 < n_lanes ? id + n_segments_per_lane : -1);
+      segment.neighboring_segment_id.push_back(i > 0 ? id - n_segments_per_lane : -1);
+
+      msg.segments.push_back(segment);
+    }
+  }
+  return msg;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  const std::string name = argc > 1 ? argv[1] : "/mapless_road_segments";
+  const double rate_hz = argc > 2 ? std::atof(argv[2]) : 10.0;
+  const int n_lanes = argc > 3 ? std::atoi(argv[3]) : 3;
+  const int n_segments_per_lane = argc > 4 ? std::atoi(argv[4]) : 10;
+  const int n_points_per_linestring = argc > 5 ? std::atoi(argv[5]) : 20;
+
+  if (
+    rate_hz <= 0.0 || n_lanes < 1 || n_segments_per_lane < 1 || n_points_per_linestring < 1 ||
+    n_lanes * n_segments_per_lane > UINT16_MAX) {
+    std::fprintf(
+      stderr,
+      "Usage: %s [name] [rate_hz] [n_lanes] [n_segments_per_lane] [n_points_per_linestring]\n",
+      argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  autoware_mapless_planning_msgs::msg::RoadSegments msg =
+    CreateRoad(n_lanes, n_segments_per_lane, n_points_per_linestring);
+
+  // The slots are sized for the synthetic frame
+  const std::size_t payload_size = ShmRoadSegmentsRing::GetPayloadSize(msg);
+  std::string error;
+  auto ring = ShmRoadSegmentsRing::Create(name, 4, static_cast<std::uint32_t>(payload_size), error);
+  if (!ring) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return EXIT_FAILURE;
+  }
+
+  std::signal(SIGINT, HandleSignal);
+  std::signal(SIGTERM, HandleSignal);
+  std::printf(
+    "Writing %zu road segments (%zu bytes) to %s at %.1f Hz, stop with Ctrl+C\n",
+    msg.segments.size(), payload_size, name.c_str(), rate_hz);
+
+  const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+    std::chrono::duration<double>(1.0 / rate_hz));
+  auto next = std::chrono::steady_clock::now();
+  std::uint64_t n_frames = 0;
+  while (g_is_running) {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    msg.header.stamp.sec = static_cast<std::int32_t>(nanoseconds / 1000000000);
+    msg.header.stamp.nanosec = static_cast<std::uint32_t>(nanoseconds % 1000000000);
+
+    if (!ring->Write(msg)) {
+      std::fprintf(stderr, "The frame does not fit into a slot\n");
+      return EXIT_FAILURE;
+    }
+    n_frames++;
+
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+
+  // The shared-memory object is removed by the destructor of the ring
+  std::printf("Wrote %zu frames\n", static_cast<std::size_t>(n_frames));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER__BATCH_MISSION_PLANNER_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER__BATCH_MISSION_PLANNER_HPP_
+
+#include "autoware/local_mission_planner/mission_planner_core.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Plans independent inputs of the mission planner (e.g. scenarios of a simulation or a
+ * replay) on a pool of worker threads.
+ *
+ * Each worker owns a MissionPlannerCore, the inputs are distributed dynamically (the next input is
+ * taken by the first idle worker). As each input carries its own state, the outputs do not depend
+ * on the number of workers or the distribution, i.e. they equal sequential
+ * MissionPlannerCore::Plan() calls of a core without frame budget. The frame budget is disabled
+ * for the cores of the workers (frame_budget_ms is ignored), as the shedding depends on the wall
+ * clock and on the runtime estimates of the previous inputs of a worker. An exception thrown while
+ * planning an input is stored in the error of its output (the other inputs are still planned).
+ * The workers are started once and wait between the batches.
+ */
+class BatchMissionPlanner
+{
+public:
+  /**
+   * @brief Constructor (starts the workers).
+   *
+   * @param parameters The parameters of the cores (the frame budget is disabled).
+   * @param n_threads The number of worker threads (0: number of hardware threads).
+   */
+  explicit BatchMissionPlanner(
+    const MissionPlannerParameters & parameters = MissionPlannerParameters(),
+    const std::size_t n_threads = 0);
+
+  /**
+   * @brief Destructor (stops the workers).
+   */
+  ~BatchMissionPlanner();
+
+  BatchMissionPlanner(const BatchMissionPlanner &) = delete;
+  BatchMissionPlanner & operator=(const BatchMissionPlanner &) = delete;
+
+  /**
+   * @brief Plan a batch of independent inputs (blocks until all inputs are planned, must not be
+   * called by several threads at the same time).
+   *
+   * @param inputs The inputs.
+   * @return The outputs (in the order of the inputs, an output whose error is set holds the
+   * exception thrown while planning its input and is otherwise default constructed).
+   */
+  std::vector<MissionPlannerOutput> Plan(const std::vector<MissionPlannerInput> & inputs);
+
+  /**
+   * @brief Get the number of worker threads.
+   */
+  std::size_t GetThreadCount() const { return workers_.size(); }
+
+private:
+  void RunWorker(const std::size_t worker_index);
+
+  std::vector<std::unique_ptr<MissionPlannerCore>> cores_;
+  std::vector<std::thread> workers_;
+
+  // Current batch (set by Plan() while the workers wait)
+  const std::vector<MissionPlannerInput> * inputs_ = nullptr;
+  std::vector<MissionPlannerOutput> * outputs_ = nullptr;
+  std::atomic<std::size_t> next_input_{0};
+
+  std::mutex mutex_;
+  std::condition_variable batch_started_;
+  std::condition_variable batch_finished_;
+  std::size_t generation_ = 0;
+  std::size_t n_workers_busy_ = 0;
+  bool is_stopping_ = false;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER__BATCH_MISSION_PLANNER_HPP_
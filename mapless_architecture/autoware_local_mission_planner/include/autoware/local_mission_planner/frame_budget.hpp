@@ -0,0 +1,132 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER__FRAME_BUDGET_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER__FRAME_BUDGET_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Optional work of a frame, in the order in which it is shed when the budget is at risk.
+ */
+enum SheddableWork { kVisualization = 0, kOuterLanes = 1, kCorridorDensity = 2 };
+
+/**
+ * @brief Stages of a frame whose runtime is estimated to predict whether the budget is at risk.
+ */
+enum BudgetStage { kCoreCorridors = 0, kOuterCorridors = 1, kCorridorVisualization = 2 };
+
+/**
+ * @brief Per-frame compute budget with deadline-aware shedding of optional work.
+ *
+ * The runtime of the remaining stages of a frame is predicted with an exponential moving average
+ * of their previous runtimes. If the elapsed time plus the predicted runtime exceeds the budget,
+ * optional work is shed in the order of SheddableWork until the prediction fits (or nothing is
+ * left to shed).
+ */
+class FrameBudget
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param budget_ms The compute budget per frame in milliseconds (<= 0 disables shedding).
+   */
+  explicit FrameBudget(const double budget_ms = 0.0);
+
+  void SetBudget(const double budget_ms);
+  double GetBudget() const;
+  bool IsEnabled() const;
+
+  /**
+   * @brief Start a new frame (resets the elapsed time and the shed work).
+   */
+  void StartFrame();
+
+  /**
+   * @brief Get the time since StartFrame() in milliseconds.
+   */
+  double GetElapsedMs() const;
+
+  /**
+   * @brief Update the runtime estimate of a stage with a measured runtime.
+   *
+   * @param stage The stage.
+   * @param runtime_ms The measured runtime in milliseconds (of the full, not degraded stage).
+   */
+  void UpdateEstimate(const BudgetStage stage, const double runtime_ms);
+
+  /**
+   * @brief Get the runtime estimate of a stage in milliseconds.
+   */
+  double GetEstimate(const BudgetStage stage) const;
+
+  /**
+   * @brief Decide which optional work of the current frame is shed, based on the elapsed time and
+   * the runtime estimates of the remaining stages.
+   */
+  void PlanOptionalWork();
+
+  /**
+   * @brief Decide which optional work is shed for a given elapsed time (see PlanOptionalWork()).
+   *
+   * @param elapsed_ms The time already spent in the current frame in milliseconds.
+   */
+  void PlanOptionalWork(const double elapsed_ms);
+
+  /**
+   * @brief Check whether optional work is shed in the current frame.
+   */
+  bool IsShed(const SheddableWork work) const;
+
+  /**
+   * @brief Check whether any optional work is shed in the current frame.
+   */
+  bool HasShedWork() const;
+
+  /**
+   * @brief Get a comma-separated list of the work shed in the current frame (e.g.
+   * "visualization, outer lanes").
+   */
+  std::string GetShedReport() const;
+
+  /**
+   * @brief Get the number of frames in which the given work was shed.
+   */
+  std::uint64_t GetShedCount(const SheddableWork work) const;
+
+private:
+  static constexpr std::size_t kNumSheddableWork = 3;
+  static constexpr std::size_t kNumBudgetStages = 3;
+
+  // Weight of a new measurement in the moving average of the stage runtimes
+  static constexpr double kEstimateSmoothing = 0.2;
+
+  double budget_ms_;
+  std::chrono::steady_clock::time_point t_frame_start_;
+  std::array<double, kNumBudgetStages> estimates_ms_{};
+  std::array<bool, kNumBudgetStages> has_estimate_{};
+  std::array<bool, kNumSheddableWork> is_shed_{};
+  std::array<std::uint64_t, kNumSheddableWork> shed_count_{};
+};
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER__FRAME_BUDGET_HPP_
@@ -0,0 +1,432 @@
+// Copyright 2024 driveblocks GmbH, authors: Simon Eisenmann, Thomas Herrmann
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER__MISSION_PLANNER_CORE_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER__MISSION_PLANNER_CORE_HPP_
+
+#include "autoware/local_mission_planner/frame_budget.hpp"
+#include "autoware/local_mission_planner_common/helper_functions.hpp"
+#include "autoware/local_mission_planner_common/lane_branch_enumerator.hpp"
+#include "autoware/local_mission_planner_common/lane_membership_table.hpp"
+#include "autoware/local_mission_planner_common/lanelet_graph_validation.hpp"
+#include "autoware/local_mission_planner_common/lanelet_polygon_table.hpp"
+#include "autoware/local_mission_planner_common/occupied_lanelet_tracker.hpp"
+#include "autoware/local_mission_planner_common/stage_profiler.hpp"
+#include "lanelet2_core/geometry/LineString.h"
+
+#include "autoware_mapless_planning_msgs/msg/local_map.hpp"
+#include "autoware_mapless_planning_msgs/msg/mission.hpp"
+#include "autoware_mapless_planning_msgs/msg/mission_lanes_stamped.hpp"
+#include "autoware_mapless_planning_msgs/msg/road_segments.hpp"
+#include "nav_msgs/msg/odometry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+// Direction data type
+typedef int Direction;
+const Direction stay = 0;
+const Direction left = 1;
+const Direction right = 2;
+const Direction left_most = 3;
+const Direction right_most = 4;
+
+// Lanes data type
+struct Lanes
+{
+  int ego_lanelet_index = -1;  // Lanelet occupied by the ego vehicle (-1 if no match)
+  LaneIndices ego;
+  std::vector<LaneIndices> ego_alternatives;
+  std::vector<LaneIndices> left;
+  std::vector<LaneIndices> right;
+};
+
+/**
+ * @brief Parameters of the mission planner (see the node parameters).
+ */
+struct MissionPlannerParameters
+{
+  float distance_to_centerline_threshold = 0.2;
+  float projection_distance_on_goallane = 30.0;
+  int retrigger_attempts_max = 10;
+  int recenter_period = 10;
+  std::string local_map_frame = "map";
+  double frame_budget_ms = 0.0;
+  int budget_corridor_point_step = 2;
+  int neighbor_lanes_decimation = 1;
+  LaneBranchBudget lane_branch_budget;
+  CorridorHorizon corridor_horizon;
+};
+
+/**
+ * @brief State of the mission planner which is carried from one input to the next.
+ */
+struct MissionPlannerState
+{
+  // Pose of the previous odometry update
+  Pose2D pose_prev;
+  bool pose_prev_init = false;
+  bool received_motion_update_once = false;
+
+  // Mission and lane change
+  bool lane_change_trigger_success = true;
+  Direction target_lane = stay;
+  Direction mission = stay;
+  Direction lane_change_direction = stay;
+  int retry_attempts = 0;
+  int recenter_counter = 0;
+  float deadline_target_lane = 1000;
+  lanelet::BasicPoint2d goal_point = lanelet::BasicPoint2d(0.0, 0.0);
+
+  // Priority of the last accepted mission (see autoware_mapless_planning_msgs::msg::Mission)
+  std::uint8_t mission_priority = autoware_mapless_planning_msgs::msg::Mission::PRIORITY_NORMAL;
+
+  // Lanes and lanelets of the last accepted local map
+  LaneIndices ego_lane;
+  LaneIndices lane_left;
+  LaneIndices lane_right;
+  std::vector<lanelet::Lanelet> current_lanelets;
+  std::vector<LaneletConnection> current_lanelet_connections;
+
+  // Lanelets of the last lookups of the ego vehicle and the goal point
+  OccupiedLaneletTracker ego_lanelet_tracker;
+  OccupiedLaneletTracker goal_lanelet_tracker;
+
+  // Lane keeping fast mode
+  int frames_since_neighbor_lanes = 0;
+  bool neighbor_lanes_requested = false;
+
+  std::size_t n_rejected_local_maps = 0;
+};
+
+/**
+ * @brief Events of a call of the MissionPlannerCore, which the caller may report (e.g. log).
+ */
+struct MissionPlannerReport
+{
+  // The mission was rejected because the active mission has a higher priority or because its
+  // priority is unknown (is_mission_priority_invalid)
+  bool is_mission_rejected = false;
+  bool is_mission_priority_invalid = false;
+
+  // The local map was rejected because of a malformed lanelet graph (see graph_report)
+  bool is_local_map_rejected = false;
+  LaneletGraphReport graph_report;
+
+  // A lane change was triggered or could not be triggered because the neighbor lane is empty
+  bool is_lane_change_triggered = false;
+  bool is_neighbor_lane_empty = false;
+
+  // The lane change failed after the given number of attempts (must be re-triggered manually)
+  bool is_lane_change_failed = false;
+  int lane_change_attempts = 0;
+
+  // The lanelet of the goal point was lost (the mission was reset)
+  bool is_goal_lanelet_lost = false;
+
+  // A point on an empty lane was requested (the point was not set)
+  bool is_point_on_empty_lane = false;
+
+  // The odometry is not a transformation from the local map frame to base_link
+  bool is_odometry_frame_unexpected = false;
+
+  // The odometry moved the goal point (i.e. it was not the first odometry update)
+  bool is_motion_update = false;
+};
+
+/**
+ * @brief Input of the mission planner: the state and the messages which are processed in the
+ * order missions, odometry, local map.
+ */
+struct MissionPlannerInput
+{
+  MissionPlannerState state;
+  std::vector<autoware_mapless_planning_msgs::msg::Mission> missions;
+  std::vector<nav_msgs::msg::Odometry> odometry;
+  autoware_mapless_planning_msgs::msg::LocalMap local_map;
+};
+
+/**
+ * @brief Output of the mission planner for an input.
+ */
+struct MissionPlannerOutput
+{
+  MissionPlannerState state;
+
+  // The mission lanes (only valid if the local map was accepted, the header stamp is the stamp of
+  // the local map)
+  autoware_mapless_planning_msgs::msg::MissionLanesStamped mission_lanes;
+
+  MissionPlannerReport report;
+
+  // The exception thrown while planning the input (only set by BatchMissionPlanner, which does not
+  // rethrow it)
+  std::exception_ptr error;
+};
+
+/**
+ * @brief Planning logic of the mission planner without middleware (no node, logger, clock or
+ * publisher).
+ *
+ * The state which is carried between the inputs is held in a MissionPlannerState, which can be
+ * read and replaced, i.e. the core can plan independent scenarios one after another. The other
+ * members are per-frame buffers, the frame budget and the stage profiler. The events which the
+ * node logs are returned in a MissionPlannerReport. A core must not be used by several threads at
+ * the same time (see BatchMissionPlanner).
+ */
+class MissionPlannerCore
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param parameters The parameters.
+   * @param profiler_category The category of the trace events of the stages (must outlive the
+   * core, e.g. a string literal).
+   */
+  explicit MissionPlannerCore(
+    const MissionPlannerParameters & parameters = MissionPlannerParameters(),
+    const char * profiler_category = "mission_planner");
+
+  /**
+   * @brief Plan an input: the state of the input is set, the messages are processed and the
+   * resulting state and mission lanes are returned.
+   *
+   * @param input The input.
+   * @return The output.
+   */
+  MissionPlannerOutput Plan(const MissionPlannerInput & input);
+
+  /**
+   * @brief Process a Mission message.
+   *
+   * @param msg The autoware_mapless_planning_msgs::msg::Mission message.
+   * @return The events.
+   */
+  MissionPlannerReport ProcessMission(const autoware_mapless_planning_msgs::msg::Mission & msg);
+
+  /**
+   * @brief Process an odometry message (moves the goal point).
+   *
+   * @param msg The odometry message (nav_msgs::msg::Odometry).
+   * @return The events.
+   */
+  MissionPlannerReport ProcessOdometry(const nav_msgs::msg::Odometry & msg);
+
+  /**
+   * @brief Process a LocalMap message.
+   *
+   * @param msg The autoware_mapless_planning_msgs::msg::LocalMap message.
+   * @param out_lanes The mission lanes (output, unchanged if the local map is rejected).
+   * @return The events.
+   */
+  MissionPlannerReport ProcessLocalMap(
+    const autoware_mapless_planning_msgs::msg::LocalMap & msg,
+    autoware_mapless_planning_msgs::msg::MissionLanesStamped & out_lanes);
+
+  /**
+    * @brief Function which checks if the vehicle is on the goal lane.
+    * This functions returns a bool depending on whether the vehicle is on the
+    goal lane or not (i.e. whether the ego lanelet is the goal lanelet or one of its predecessors).
+    * The answer is an O(1) lookup in the lane membership table of the frame, which is rebuilt if it
+    * was built from other lanelet connections.
+    *
+    * @param ego_lanelet_index The index of the ego lanelet (int).
+    * @param goal_point The goal point (lanelet::BasicPoint2d).
+    * @param converted_lanelets The lanelets from the road model
+    (std::vector<lanelet::Lanelet>).
+    * @param lanelet_connections The lanelet connections from the road model
+    (std::vector<LaneletConnection>).
+    * @return bool (is on goal lane or not).
+    */
+  bool IsOnGoalLane(
+    const int ego_lanelet_index, const lanelet::BasicPoint2d & goal_point,
+    const std::vector<lanelet::Lanelet> & converted_lanelets,
+    const std::vector<LaneletConnection> & lanelet_connections);
+
+  /**
+   * @brief Function which checks if the goal point has a negative x value und
+   * must be therefore reset. If the x value is negative the goal point is reset
+   * with GetPointOnLane().
+   *
+   * @param converted_lanelets The lanelets from the road model
+    (std::vector<lanelet::Lanelet>).
+   * @param lanelet_connections The lanelet connections from the road model
+    (std::vector<LaneletConnection>).
+   */
+  void CheckIfGoalPointShouldBeReset(
+    const lanelet::Lanelets & converted_lanelets,
+    const std::vector<LaneletConnection> & lanelet_connections);
+
+  /**
+   * @brief Function for calculating lanes.
+   *
+   * @param converted_lanelets The lanelets given from the road model.
+   * @param lanelet_connections The lanelet connections given from the road
+   * model.
+   * @return Lanes: ego lanelet, ego lane, alternative successor branches of the ego lane (best
+   * first, bounded by the lane branch budget), all left lanes, all right lanes.
+   */
+  Lanes CalculateLanes(
+    const std::vector<lanelet::Lanelet> & converted_lanelets,
+    std::vector<LaneletConnection> & lanelet_connections);
+
+  /**
+   * @brief Function for calculating lanes from a known ego lanelet (see CalculateLanes()).
+   *
+   * @param converted_lanelets The lanelets given from the road model.
+   * @param lanelet_connections The lanelet connections given from the road model.
+   * @param ego_lanelet_index The index of the lanelet of the ego vehicle (-1 if no match).
+   * @return Lanes.
+   */
+  Lanes CalculateLanes(
+    const std::vector<lanelet::Lanelet> & converted_lanelets,
+    std::vector<LaneletConnection> & lanelet_connections, const int ego_lanelet_index);
+
+  /**
+   * @brief Convert RoadSegments into lanelets.
+   *
+   * The lanelet connections are validated and normalized first (see NormalizeLaneletConnections()),
+   * the lanelets are only created if the lanelet graph is valid.
+   *
+   * @param msg The message (autoware_mapless_planning_msgs::msg::RoadSegments).
+   * @param out_lanelets The lanelets (output).
+   * @param out_lanelet_connections The lanelet connections (output).
+   * @return The defects of the lanelet graph.
+   */
+  LaneletGraphReport ConvertInput2LaneletFormat(
+    const autoware_mapless_planning_msgs::msg::RoadSegments & msg,
+    std::vector<lanelet::Lanelet> & out_lanelets,
+    std::vector<LaneletConnection> & out_lanelet_connections);
+
+  /**
+   * @brief Get a point on the given lane that is x meters away in x direction
+   * (using a projection).
+   *
+   * @param lane The given lane (LaneIndices) on which the point is
+   * created.
+   * @param x_distance The point is created x_distance meters (float) away from
+   * the vehicle (in x direction using a projection).
+   * @param converted_lanelets The lanelets (std::vector<lanelet::Lanelet>) from
+   * the road model.
+   * @return lanelet::BasicPoint2d.
+   */
+  lanelet::BasicPoint2d GetPointOnLane(
+    const LaneIndices & lane, const float x_distance,
+    const std::vector<lanelet::Lanelet> & converted_lanelets);
+
+  /**
+   * @brief Calculate the distance between a point and a LineString (Euclidean
+   * distance).
+   *
+   * @param linestring The LineString.
+   * @param point The point.
+   * @return double.
+   */
+  double CalculateDistanceBetweenPointAndLineString(
+    const lanelet::ConstLineString2d & linestring, const lanelet::BasicPoint2d & point);
+
+  /**
+   * @brief Initiate a lane change.
+   *
+   * @param direction The direction of the lane change (-1 for left and +1 for
+   * right).
+   * @param neighboring_lane The neighboring lane.
+   */
+  void InitiateLaneChange(const Direction direction, const LaneIndices & neighboring_lane);
+
+  /**
+   * @brief Get the state.
+   */
+  const MissionPlannerState & GetState() const { return state_; }
+  MissionPlannerState & GetState() { return state_; }
+
+  /**
+   * @brief Replace the state (e.g. to plan another scenario).
+   */
+  void SetState(MissionPlannerState state) { state_ = std::move(state); }
+
+  /**
+   * @brief Get the parameters.
+   */
+  const MissionPlannerParameters & GetParameters() const { return parameters_; }
+
+  /**
+   * @brief Get the frame budget (the optional work of the caller, e.g. the visualization, is
+   * planned with it as well).
+   */
+  FrameBudget & GetFrameBudget() { return frame_budget_; }
+
+  /**
+   * @brief Get the stage profiler.
+   */
+  StageProfiler & GetProfiler() { return profiler_; }
+
+  /**
+   * @brief Get the lane membership table of the last local map (goal lane check and lane id of
+   * each lanelet).
+   */
+  const LaneMembershipTable & GetLaneMembership() const { return lane_membership_; }
+
+private:
+  // Find the lanelets of the ego vehicle and of the goal point (only if is_goal_located, otherwise
+  // goal_lanelet_index is -1) with their trackers and one batched lookup of the misses in the
+  // polygon table of the frame (which must be built from the lanelets of the connections)
+  void FindTrackedLanelets(
+    const std::vector<LaneletConnection> & lanelet_connections, const bool is_goal_located,
+    int & ego_lanelet_index, int & goal_lanelet_index);
+
+  // Same as the public CheckIfGoalPointShouldBeReset() with the lanelet of the goal point, returns
+  // true if the goal point was reset
+  bool CheckIfGoalPointShouldBeReset(
+    const lanelet::Lanelets & converted_lanelets,
+    const std::vector<LaneletConnection> & lanelet_connections, const int goal_lanelet_index);
+
+  // Find the lanelet which contains a tracked point with the polygon table of the frame (the table
+  // is rebuilt if it was built from other lanelets)
+  int FindLaneletContainingPoint(
+    OccupiedLaneletTracker & tracker, const std::vector<lanelet::Lanelet> & converted_lanelets,
+    const std::vector<LaneletConnection> & lanelet_connections,
+    const lanelet::BasicPoint2d & point);
+
+  // Processing of the messages (the events are added to report_)
+  void HandleMission(const autoware_mapless_planning_msgs::msg::Mission & msg);
+  void HandleOdometry(const nav_msgs::msg::Odometry & msg);
+  void HandleLocalMap(
+    const autoware_mapless_planning_msgs::msg::LocalMap & msg,
+    autoware_mapless_planning_msgs::msg::MissionLanesStamped & out_lanes);
+
+  MissionPlannerParameters parameters_;
+  MissionPlannerState state_;
+  MissionPlannerReport report_;
+
+  // Per-frame buffers (rebuilt for each local map)
+  LaneletPolygonTable lanelet_polygons_;
+  std::vector<int> miss_lanelet_ids_;
+  LaneMembershipTable lane_membership_;
+
+  FrameBudget frame_budget_;
+  StageProfiler profiler_;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER__MISSION_PLANNER_CORE_HPP_
@@ -15,8 +15,8 @@
 #ifndef AUTOWARE__LOCAL_MISSION_PLANNER__MISSION_PLANNER_NODE_HPP_
 #define AUTOWARE__LOCAL_MISSION_PLANNER__MISSION_PLANNER_NODE_HPP_
 
-#include "autoware/local_mission_planner_common/helper_functions.hpp"
-#include "lanelet2_core/geometry/LineString.h"
+#include "autoware/local_mission_planner/mission_planner_core.hpp"
+#include "diagnostic_updater/diagnostic_updater.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "tf2_ros/buffer.h"
 #include "tf2_ros/transform_listener.h"
@@ -24,45 +24,28 @@
 #include "autoware_mapless_planning_msgs/msg/driving_corridor.hpp"
 #include "autoware_mapless_planning_msgs/msg/local_map.hpp"
 #include "autoware_mapless_planning_msgs/msg/mission.hpp"
+#include "autoware_mapless_planning_msgs/msg/mission_ack.hpp"
 #include "autoware_mapless_planning_msgs/msg/mission_lanes_stamped.hpp"
 #include "geometry_msgs/msg/point.hpp"
 #include "nav_msgs/msg/odometry.hpp"
+#include "std_srvs/srv/trigger.hpp"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 #include "visualization_msgs/msg/marker.hpp"
 #include "visualization_msgs/msg/marker_array.hpp"
 
-#include <map>
+#include <cstddef>
 #include <memory>
 #include <string>
-#include <tuple>
 #include <vector>
 
 namespace autoware::mapless_architecture
 {
 
-// Direction data type
-typedef int Direction;
-const Direction stay = 0;
-const Direction left = 1;
-const Direction right = 2;
-const Direction left_most = 3;
-const Direction right_most = 4;
-
-// Lanes data type
-struct Lanes
-{
-  std::vector<int> ego;
-  std::vector<std::vector<int>> left;
-  std::vector<std::vector<int>> right;
-};
-
 /**
- * Node for mission planner.
+ * Node for mission planner (adapter of the MissionPlannerCore to the middleware).
  */
 class MissionPlannerNode : public rclcpp::Node
 {
-  friend class MissionPlannerNodeMock;
-
 public:
   /**
    * @brief Constructor for the MissionPlannerNode class.
@@ -76,64 +59,6 @@ public:
   MissionPlannerNode(
     const rclcpp::NodeOptions & options, const bool init_publishers_and_subscribers = true);
 
-  /**
-    * @brief Function which checks if the vehicle is on the goal lane.
-    * This functions returns a bool depending on whether the vehicle is on the
-    goal lane or not.
-    *
-    * @param ego_lanelet_index The index of the ego lanelet (int).
-    * @param goal_point The goal point (lanelet::BasicPoint2d).
-    * @param converted_lanelets The lanelets from the road model
-    (std::vector<lanelet::Lanelet>).
-    * @param lanelet_connections The lanelet connections from the road model
-    (std::vector<LaneletConnection>).
-    * @return bool (is on goal lane or not).
-    */
-  bool IsOnGoalLane(
-    const int ego_lanelet_index, const lanelet::BasicPoint2d & goal_point,
-    const std::vector<lanelet::Lanelet> & converted_lanelets,
-    const std::vector<LaneletConnection> & lanelet_connections);
-
-  /**
-   * @brief Function which checks if the goal point has a negative x value und
-   * must be therefore reset. If the x value is negative the goal point is reset
-   * with GetPointOnLane().
-   *
-   * @param converted_lanelets The lanelets from the road model
-    (std::vector<lanelet::Lanelet>).
-   * @param lanelet_connections The lanelet connections from the road model
-    (std::vector<LaneletConnection>).
-   */
-  void CheckIfGoalPointShouldBeReset(
-    const lanelet::Lanelets & converted_lanelets,
-    const std::vector<LaneletConnection> & lanelet_connections);
-
-  /**
-   * @brief Function for calculating lanes.
-   *
-   * @param converted_lanelets The lanelets given from the road model.
-   * @param lanelet_connections The lanelet connections given from the road
-   * model.
-   * @return Lanes: ego lane, all left lanes, all right lanes.
-   */
-  Lanes CalculateLanes(
-    const std::vector<lanelet::Lanelet> & converted_lanelets,
-    std::vector<LaneletConnection> & lanelet_connections);
-
-  /**
-   * @brief Getter for goal_point_.
-   *
-   * @return lanelet::BasicPoint2d.
-   */
-  lanelet::BasicPoint2d goal_point();
-
-  /**
-   * @brief Setter for goal_point_.
-   *
-   * @param goal_point The new value for the goal_point_.
-   */
-  void goal_point(const lanelet::BasicPoint2d & goal_point);
-
   /**
    * @brief The callback for the Mission messages.
    *
@@ -149,71 +74,55 @@ public:
   void CallbackLocalMapMessages(const autoware_mapless_planning_msgs::msg::LocalMap & msg);
 
   /**
-   * @brief Convert RoadSegments into lanelets.
+   * @brief Function for the visualization of the centerline of a driving corridor.
    *
-   * @param msg The message (autoware_mapless_planning_msgs::msg::RoadSegments).
-   * @param out_lanelets The lanelets (output).
-   * @param out_lanelet_connections The lanelet connections (output).
+   * @param msg The autoware_mapless_planning_msgs::msg::RoadSegments message.
+   * @param driving_corridor The considered driving corridor for which the centerline is visualized.
    */
-  void ConvertInput2LaneletFormat(
+  void VisualizeCenterlineOfDrivingCorridor(
     const autoware_mapless_planning_msgs::msg::RoadSegments & msg,
-    std::vector<lanelet::Lanelet> & out_lanelets,
-    std::vector<LaneletConnection> & out_lanelet_connections);
+    const autoware_mapless_planning_msgs::msg::DrivingCorridor & driving_corridor);
 
   /**
-   * @brief Get a point on the given lane that is x meters away in x direction
-   * (using a projection).
+   * @brief Callback for the odometry messages.
    *
-   * @param lane The given lane (std::vector<int>) on which the point is
-   * created.
-   * @param x_distance The point is created x_distance meters (float) away from
-   * the vehicle (in x direction using a projection).
-   * @param converted_lanelets The lanelets (std::vector<lanelet::Lanelet>) from
-   * the road model.
-   * @return lanelet::BasicPoint2d.
+   * @param msg The odometry message (nav_msgs::msg::Odometry).
    */
-  lanelet::BasicPoint2d GetPointOnLane(
-    const std::vector<int> & lane, const float x_distance,
-    const std::vector<lanelet::Lanelet> & converted_lanelets);
+  void CallbackOdometryMessages(const nav_msgs::msg::Odometry & msg);
 
   /**
-   * @brief Calculate the distance between a point and a LineString (Euclidean
-   * distance).
-   *
-   * @param linestring The LineString.
-   * @param point The point.
-   * @return double.
+   * @brief Get the planning core (its state holds the mission, goal point and lanes).
    */
-  double CalculateDistanceBetweenPointAndLineString(
-    const lanelet::ConstLineString2d & linestring, const lanelet::BasicPoint2d & point);
+  MissionPlannerCore & GetCore() { return core_; }
 
   /**
-   * @brief Function for the visualization of the centerline of a driving corridor.
-   *
-   * @param msg The autoware_mapless_planning_msgs::msg::RoadSegments message.
-   * @param driving_corridor The considered driving corridor for which the centerline is visualized.
+   * @brief Get the number of local maps which were rejected because of a malformed lanelet graph.
    */
-  void VisualizeCenterlineOfDrivingCorridor(
-    const autoware_mapless_planning_msgs::msg::RoadSegments & msg,
-    const autoware_mapless_planning_msgs::msg::DrivingCorridor & driving_corridor);
+  std::size_t GetRejectedLocalMapCount() const { return core_.GetState().n_rejected_local_maps; }
 
   /**
-   * @brief Callback for the odometry messages.
-   *
-   * @param msg The odometry message (nav_msgs::msg::Odometry).
+   * @brief Get the tracker of the ego lanelet (e.g. for its hit rate).
    */
-  void CallbackOdometryMessages(const nav_msgs::msg::Odometry & msg);
+  const OccupiedLaneletTracker & GetEgoLaneletTracker() const
+  {
+    return core_.GetState().ego_lanelet_tracker;
+  }
 
   /**
-   * @brief Initiate a lane change.
-   *
-   * @param direction The direction of the lane change (-1 for left and +1 for
-   * right).
-   * @param neighboring_lane The neighboring lane.
+   * @brief Get the tracker of the goal lanelet (e.g. for its hit rate).
    */
-  void InitiateLaneChange(const Direction direction, const std::vector<int> & neighboring_lane);
+  const OccupiedLaneletTracker & GetGoalLaneletTracker() const
+  {
+    return core_.GetState().goal_lanelet_tracker;
+  }
 
 private:
+  // Read the parameters of the planning core
+  MissionPlannerParameters DeclareParameters();
+
+  // Log the lane change events of the core
+  void LogLaneChangeEvents(const MissionPlannerReport & report);
+
   //  Declare ROS2 publisher and subscriber
   rclcpp::Subscription<autoware_mapless_planning_msgs::msg::LocalMap>::SharedPtr mapSubscriber_;
 
@@ -229,6 +138,9 @@ private:
   rclcpp::Publisher<autoware_mapless_planning_msgs::msg::MissionLanesStamped>::SharedPtr
     missionLanesStampedPublisher_;
 
+  rclcpp::Publisher<autoware_mapless_planning_msgs::msg::MissionAck>::SharedPtr
+    missionAckPublisher_;
+
   // ROS buffer interface (for TF transforms)
   std::unique_ptr<tf2_ros::Buffer> tf_buffer_;
   std::unique_ptr<tf2_ros::TransformListener> tf_listener_;
@@ -236,33 +148,19 @@ private:
   // Store previous odometry message
   nav_msgs::msg::Odometry last_odom_msg_;
 
-  // Initialize some variables
-  Pose2D pose_prev_;
-  bool pose_prev_init_ = false;
   bool b_input_odom_frame_error_ = false;
-  bool received_motion_update_once_ = false;
-  bool lane_change_trigger_success_ = true;
-  Direction target_lane_ = stay;
-  Direction mission_ = stay;
-  Direction lane_change_direction_ = stay;
-  int retry_attempts_ = 0;
-  int recenter_counter_ = 0;
-  float deadline_target_lane_ = 1000;
-  lanelet::BasicPoint2d goal_point_;
-  std::vector<int> ego_lane_;
-  std::vector<int> lane_left_;
-  std::vector<int> lane_right_;
-  std::vector<lanelet::Lanelet> current_lanelets_;
 
-  // ROS parameters
-  float distance_to_centerline_threshold_;
-  float projection_distance_on_goallane_;
-  int retrigger_attempts_max_;
-  int recenter_period_;
-  std::string local_map_frame_;
+  // Planning logic and state (without middleware)
+  MissionPlannerCore core_;
 
   // Unique ID for each marker
   ID centerline_marker_id_;
+
+  // Stage profiling statistics of the core (published on /diagnostics if compiled in)
+  std::unique_ptr<diagnostic_updater::Updater> diagnostic_updater_;
+
+  // Trace dump service
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr trace_dump_service_;
 };
 }  // namespace autoware::mapless_architecture
 
@@ -53,6 +53,10 @@ def generate_launch_description():
                         "mission_planner_node/output/mission_lanes_stamped",
                         "mission_planner_node/output/mission_lanes_stamped",
                     ),
+                    (
+                        "mission_planner_node/output/mission_ack",
+                        "mission_planner_node/output/mission_ack",
+                    ),
                     (
                         "mission_planner_node/input/local_map",
                         "local_map_provider_node/output/local_map",
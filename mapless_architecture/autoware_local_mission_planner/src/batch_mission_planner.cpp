@@ -0,0 +1,118 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner/batch_mission_planner.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace autoware::mapless_architecture
+{
+
+BatchMissionPlanner::BatchMissionPlanner(
+  const MissionPlannerParameters & parameters, const std::size_t n_threads)
+{
+  const std::size_t n_workers =
+    n_threads > 0 ? n_threads : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+  // Disable the frame budget, otherwise the shed work would depend on the wall clock and on the
+  // inputs planned before by the same worker
+  MissionPlannerParameters parameters_batch = parameters;
+  parameters_batch.frame_budget_ms = 0.0;
+
+  cores_.reserve(n_workers);
+  for (std::size_t i = 0; i < n_workers; i++) {
+    cores_.push_back(
+      std::make_unique<MissionPlannerCore>(parameters_batch, "batch_mission_planner"));
+  }
+
+  workers_.reserve(n_workers);
+  for (std::size_t i = 0; i < n_workers; i++) {
+    workers_.emplace_back(&BatchMissionPlanner::RunWorker, this, i);
+  }
+}
+
+BatchMissionPlanner::~BatchMissionPlanner()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  batch_started_.notify_all();
+
+  for (std::thread & worker : workers_) worker.join();
+}
+
+std::vector<MissionPlannerOutput> BatchMissionPlanner::Plan(
+  const std::vector<MissionPlannerInput> & inputs)
+{
+  std::vector<MissionPlannerOutput> outputs(inputs.size());
+  if (inputs.empty()) return outputs;
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    inputs_ = &inputs;
+    outputs_ = &outputs;
+    next_input_.store(0, std::memory_order_relaxed);
+    n_workers_busy_ = workers_.size();
+    generation_++;
+    batch_started_.notify_all();
+
+    // Wait until all workers are done with this batch (the buffers are only valid in this call)
+    batch_finished_.wait(lock, [this] { return n_workers_busy_ == 0; });
+    inputs_ = nullptr;
+    outputs_ = nullptr;
+  }
+
+  return outputs;
+}
+
+void BatchMissionPlanner::RunWorker(const std::size_t worker_index)
+{
+  MissionPlannerCore & core = *cores_[worker_index];
+  std::size_t generation_done = 0;
+
+  while (true) {
+    const std::vector<MissionPlannerInput> * inputs = nullptr;
+    std::vector<MissionPlannerOutput> * outputs = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      batch_started_.wait(lock, [&] { return is_stopping_ || generation_ != generation_done; });
+      if (is_stopping_) return;
+      generation_done = generation_;
+      inputs = inputs_;
+      outputs = outputs_;
+    }
+
+    // Take the next input until the batch is exhausted (each output is written by one worker)
+    for (std::size_t i = next_input_.fetch_add(1, std::memory_order_relaxed); i < inputs->size();
+         i = next_input_.fetch_add(1, std::memory_order_relaxed)) {
+      // An exception must not escape the worker (std::terminate), it is returned with the output
+      try {
+        (*outputs)[i] = core.Plan((*inputs)[i]);
+      } catch (...) {
+        (*outputs)[i] = MissionPlannerOutput();
+        (*outputs)[i].error = std::current_exception();
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      n_workers_busy_--;
+      if (n_workers_busy_ == 0) batch_finished_.notify_one();
+    }
+  }
+}
+
+}  // namespace autoware::mapless_architecture
@@ -0,0 +1,130 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner/frame_budget.hpp"
+
+namespace autoware::mapless_architecture
+{
+
+FrameBudget::FrameBudget(const double budget_ms)
+: budget_ms_(budget_ms), t_frame_start_(std::chrono::steady_clock::now())
+{
+}
+
+void FrameBudget::SetBudget(const double budget_ms)
+{
+  budget_ms_ = budget_ms;
+}
+
+double FrameBudget::GetBudget() const
+{
+  return budget_ms_;
+}
+
+bool FrameBudget::IsEnabled() const
+{
+  return budget_ms_ > 0.0;
+}
+
+void FrameBudget::StartFrame()
+{
+  t_frame_start_ = std::chrono::steady_clock::now();
+  is_shed_.fill(false);
+}
+
+double FrameBudget::GetElapsedMs() const
+{
+  return std::chrono::duration<double, std::milli>(
+           std::chrono::steady_clock::now() - t_frame_start_)
+    .count();
+}
+
+void FrameBudget::UpdateEstimate(const BudgetStage stage, const double runtime_ms)
+{
+  if (has_estimate_[stage]) {
+    estimates_ms_[stage] += kEstimateSmoothing * (runtime_ms - estimates_ms_[stage]);
+  } else {
+    // Initialize with the first measurement
+    estimates_ms_[stage] = runtime_ms;
+    has_estimate_[stage] = true;
+  }
+}
+
+double FrameBudget::GetEstimate(const BudgetStage stage) const
+{
+  return estimates_ms_[stage];
+}
+
+void FrameBudget::PlanOptionalWork()
+{
+  PlanOptionalWork(GetElapsedMs());
+}
+
+void FrameBudget::PlanOptionalWork(const double elapsed_ms)
+{
+  is_shed_.fill(false);
+  if (!IsEnabled()) return;
+
+  const double remaining_ms = budget_ms_ - elapsed_ms;
+  double required_ms = estimates_ms_[kCoreCorridors] + estimates_ms_[kOuterCorridors] +
+                       estimates_ms_[kCorridorVisualization];
+
+  // Shed optional work in priority order until the remaining stages fit into the budget
+  if (required_ms > remaining_ms) {
+    is_shed_[kVisualization] = true;
+    required_ms -= estimates_ms_[kCorridorVisualization];
+  }
+  if (required_ms > remaining_ms) {
+    is_shed_[kOuterLanes] = true;
+    required_ms -= estimates_ms_[kOuterCorridors];
+  }
+  if (required_ms > remaining_ms) {
+    is_shed_[kCorridorDensity] = true;
+  }
+
+  for (std::size_t i = 0; i < kNumSheddableWork; i++) {
+    if (is_shed_[i]) shed_count_[i]++;
+  }
+}
+
+bool FrameBudget::IsShed(const SheddableWork work) const
+{
+  return is_shed_[work];
+}
+
+bool FrameBudget::HasShedWork() const
+{
+  return is_shed_[kVisualization] || is_shed_[kOuterLanes] || is_shed_[kCorridorDensity];
+}
+
+std::string FrameBudget::GetShedReport() const
+{
+  const std::array<const char *, kNumSheddableWork> names = {
+    "visualization", "outer lanes", "corridor density"};
+
+  std::string report;
+  for (std::size_t i = 0; i < kNumSheddableWork; i++) {
+    if (!is_shed_[i]) continue;
+    if (!report.empty()) report += ", ";
+    report += names[i];
+  }
+  return report;
+}
+
+std::uint64_t FrameBudget::GetShedCount(const SheddableWork work) const
+{
+  return shed_count_[work];
+}
+
+}  // namespace autoware::mapless_architecture
@@ -0,0 +1,809 @@
+// Copyright 2024 driveblocks GmbH, authors: Simon Eisenmann, Thomas Herrmann
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner/mission_planner_core.hpp"
+
+#include "lanelet2_core/LaneletMap.h"
+#include "lanelet2_core/geometry/Lanelet.h"
+
+#include "geometry_msgs/msg/pose_stamped.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace autoware::mapless_architecture
+{
+
+MissionPlannerCore::MissionPlannerCore(
+  const MissionPlannerParameters & parameters, const char * profiler_category)
+: parameters_(parameters), frame_budget_(parameters.frame_budget_ms), profiler_(profiler_category)
+{
+}
+
+MissionPlannerOutput MissionPlannerCore::Plan(const MissionPlannerInput & input)
+{
+  state_ = input.state;
+  report_ = MissionPlannerReport();
+
+  MissionPlannerOutput output;
+  for (const auto & mission : input.missions) HandleMission(mission);
+  for (const auto & odometry : input.odometry) HandleOdometry(odometry);
+  HandleLocalMap(input.local_map, output.mission_lanes);
+
+  output.state = state_;
+  output.report = report_;
+  return output;
+}
+
+MissionPlannerReport MissionPlannerCore::ProcessMission(
+  const autoware_mapless_planning_msgs::msg::Mission & msg)
+{
+  report_ = MissionPlannerReport();
+  HandleMission(msg);
+  return report_;
+}
+
+MissionPlannerReport MissionPlannerCore::ProcessOdometry(const nav_msgs::msg::Odometry & msg)
+{
+  report_ = MissionPlannerReport();
+  HandleOdometry(msg);
+  return report_;
+}
+
+MissionPlannerReport MissionPlannerCore::ProcessLocalMap(
+  const autoware_mapless_planning_msgs::msg::LocalMap & msg,
+  autoware_mapless_planning_msgs::msg::MissionLanesStamped & out_lanes)
+{
+  report_ = MissionPlannerReport();
+  HandleLocalMap(msg, out_lanes);
+  return report_;
+}
+
+void MissionPlannerCore::HandleLocalMap(
+  const autoware_mapless_planning_msgs::msg::LocalMap & msg,
+  autoware_mapless_planning_msgs::msg::MissionLanesStamped & out_lanes)
+{
+  frame_budget_.StartFrame();
+
+  // Used for output
+  std::vector<LaneletConnection> lanelet_connections;
+  std::vector<lanelet::Lanelet> converted_lanelets;
+
+  report_.graph_report =
+    ConvertInput2LaneletFormat(msg.road_segments, converted_lanelets, lanelet_connections);
+
+  // Reject malformed local maps (the previous mission lanes stay valid)
+  if (!report_.graph_report.IsValid()) {
+    state_.n_rejected_local_maps++;
+    report_.is_local_map_rejected = true;
+    return;
+  }
+
+  // Containment queries of this frame (ego and goal lanelet)
+  lanelet_polygons_.Build(converted_lanelets);
+
+  // Lanelets of the ego vehicle and of the goal point (if a mission is active), the goal point is
+  // located again below if a re-triggered lane change moves it
+  const bool is_goal_located = state_.mission != stay;
+  const lanelet::BasicPoint2d goal_point_located = state_.goal_point;
+  int ego_lanelet_index = -1;
+  int goal_lanelet_index = -1;
+  FindTrackedLanelets(lanelet_connections, is_goal_located, ego_lanelet_index, goal_lanelet_index);
+
+  // Get the lanes
+  Lanes result = CalculateLanes(converted_lanelets, lanelet_connections, ego_lanelet_index);
+
+  // Get the ego lane
+  state_.ego_lane = result.ego;
+
+  const std::vector<LaneIndices> & left_lanes = result.left;
+  if (!left_lanes.empty()) {
+    state_.lane_left = left_lanes[0];  // Store the first left lane (needed for lane change)
+  }
+
+  const std::vector<LaneIndices> & right_lanes = result.right;
+  if (!right_lanes.empty()) {
+    state_.lane_right = right_lanes[0];  // Store the first right lane (needed for lane change)
+  }
+
+  // Save current converted_lanelets
+  state_.current_lanelets = converted_lanelets;
+  state_.current_lanelet_connections = lanelet_connections;
+
+  // Re-trigger lane change if necessary
+  if (
+    state_.lane_change_trigger_success == false &&
+    state_.retry_attempts <= parameters_.retrigger_attempts_max) {
+    if (state_.lane_change_direction == left) {
+      // Lane change to the left
+      InitiateLaneChange(left, state_.lane_left);
+    } else if (state_.lane_change_direction == right) {
+      // Lane change to the right
+      InitiateLaneChange(right, state_.lane_right);
+    }
+  }
+
+  if (state_.retry_attempts > parameters_.retrigger_attempts_max) {
+    // Lane change has failed, must be re-triggered manually
+    report_.is_lane_change_failed = true;
+    report_.lane_change_attempts = state_.retry_attempts;
+
+    // Reset variable
+    state_.lane_change_trigger_success = true;
+    state_.retry_attempts = 0;
+  }
+
+  {
+    MAPLESS_PROFILE_STAGE(profiler_, kStageGoalChecks);
+
+    // Lane membership of the lanelets of this frame (goal lane check and lane ids)
+    lane_membership_.Build(lanelet_connections);
+    lane_membership_.SetLaneId(result.ego, 0);
+    for (std::size_t i = 0; i < left_lanes.size(); i++) {
+      lane_membership_.SetLaneId(left_lanes[i], -static_cast<int>(i + 1));
+    }
+    for (std::size_t i = 0; i < right_lanes.size(); i++) {
+      lane_membership_.SetLaneId(right_lanes[i], static_cast<int>(i + 1));
+    }
+
+    // Goal lanelet of a goal point which was set or moved after the lookup of the tracked points
+    if (state_.mission != stay && (!is_goal_located || state_.goal_point != goal_point_located)) {
+      goal_lanelet_index = FindLaneletContainingPoint(
+        state_.goal_lanelet_tracker, converted_lanelets, lanelet_connections, state_.goal_point);
+    }
+
+    // Check if goal point should be reset, if yes -> reset goal point (and locate it again)
+    if (CheckIfGoalPointShouldBeReset(
+          converted_lanelets, lanelet_connections, goal_lanelet_index)) {
+      goal_lanelet_index = FindLaneletContainingPoint(
+        state_.goal_lanelet_tracker, converted_lanelets, lanelet_connections, state_.goal_point);
+    }
+
+    // Check if lane change was successful, if yes -> reset mission
+    if (state_.mission != stay) {
+      lanelet::BasicPoint2d pointEgo(0,
+                                     0);  // Vehicle is always located at (0, 0)
+
+      if (ego_lanelet_index >= 0) {
+        // The ego lanelet is the goal lanelet or one of its predecessors (false if no goal lanelet)
+        const bool is_on_goal_lane =
+          lane_membership_.IsOnLaneTo(ego_lanelet_index, goal_lanelet_index);
+
+        // Check if successful lane change
+        if (
+          is_on_goal_lane &&
+          CalculateDistanceBetweenPointAndLineString(
+            converted_lanelets[ego_lanelet_index].centerline2d(), pointEgo) <=
+            parameters_.distance_to_centerline_threshold) {
+          // Reset mission to lane keeping
+          state_.mission = stay;
+          state_.target_lane = stay;
+        }
+
+        // Check if we are on the target lane, if yes -> update target_lane
+        if (is_on_goal_lane) {
+          state_.target_lane = stay;
+        } else {
+          state_.target_lane = state_.mission;
+        }
+      }
+    }
+  }
+
+  // Mission lanes
+  autoware_mapless_planning_msgs::msg::MissionLanesStamped lanes;
+  lanes.header = msg.road_segments.header;  // Same frame_id as msg
+
+  // Add target lane
+  switch (state_.target_lane) {
+    case stay:
+      lanes.target_lane = 0;
+      break;
+    case left:
+      lanes.target_lane = -1;
+      break;
+    case right:
+      lanes.target_lane = +1;
+      break;
+    case left_most:
+      lanes.target_lane = -2;
+      break;
+    case right_most:
+      lanes.target_lane = +2;
+      break;
+    default:
+      break;
+  }
+
+  lanes.deadline_target_lane = state_.deadline_target_lane;
+
+  // Lane keeping fast mode: while lane keeping without a pending lane change, the converter only
+  // consumes the ego lane, so the neighbor lanes are only built in every n-th frame (and on demand
+  // when a mission arrives). The neighbor lanelets are still determined every frame, i.e. a lane
+  // change can be initiated immediately.
+  const bool is_lane_change_direction =
+    state_.lane_change_direction == left || state_.lane_change_direction == right;
+  const bool is_lane_change_pending = !state_.lane_change_trigger_success &&
+                                      is_lane_change_direction &&
+                                      state_.retry_attempts <= parameters_.retrigger_attempts_max;
+  bool build_neighbor_lanes = true;
+  if (
+    parameters_.neighbor_lanes_decimation > 1 && state_.mission == stay &&
+    state_.target_lane == stay && !is_lane_change_pending && !state_.neighbor_lanes_requested) {
+    build_neighbor_lanes =
+      state_.frames_since_neighbor_lanes + 1 >= parameters_.neighbor_lanes_decimation;
+  }
+  state_.frames_since_neighbor_lanes =
+    build_neighbor_lanes ? 0 : state_.frames_since_neighbor_lanes + 1;
+  state_.neighbor_lanes_requested = false;
+  lanes.neighbor_lanes_omitted = !build_neighbor_lanes;
+
+  // Decide which optional work is shed to meet the frame budget
+  frame_budget_.PlanOptionalWork();
+  const bool is_density_reduced = frame_budget_.IsShed(kCorridorDensity);
+  const int point_step = is_density_reduced ? parameters_.budget_corridor_point_step : 1;
+  const CorridorHorizon & horizon = parameters_.corridor_horizon;
+
+  {
+    MAPLESS_PROFILE_STAGE(profiler_, kStageCorridorBuild);
+
+    // Create driving corridors and add them to the MissionLanesStamped message (the ego lane and
+    // the first neighbor lanes are always created unless omitted in lane keeping fast mode, the
+    // outer lanes are optional), the corridors are cropped to the horizon
+    const double t_core = frame_budget_.GetElapsedMs();
+    lanes.ego_lane =
+      CreateDrivingCorridor(state_.ego_lane, converted_lanelets, point_step, horizon);
+
+    if (build_neighbor_lanes && !left_lanes.empty()) {
+      lanes.drivable_lanes_left.push_back(
+        CreateDrivingCorridor(left_lanes[0], converted_lanelets, point_step, horizon));
+    }
+
+    if (build_neighbor_lanes && !right_lanes.empty()) {
+      lanes.drivable_lanes_right.push_back(
+        CreateDrivingCorridor(right_lanes[0], converted_lanelets, point_step, horizon));
+    }
+
+    // The estimates refer to frames with neighbor lanes (worst case)
+    if (!is_density_reduced && build_neighbor_lanes) {
+      frame_budget_.UpdateEstimate(kCoreCorridors, frame_budget_.GetElapsedMs() - t_core);
+    }
+
+    if (build_neighbor_lanes && !frame_budget_.IsShed(kOuterLanes)) {
+      const double t_outer = frame_budget_.GetElapsedMs();
+
+      for (std::size_t i = 1; i < left_lanes.size(); i++) {
+        lanes.drivable_lanes_left.push_back(
+          CreateDrivingCorridor(left_lanes[i], converted_lanelets, point_step, horizon));
+      }
+
+      for (std::size_t i = 1; i < right_lanes.size(); i++) {
+        lanes.drivable_lanes_right.push_back(
+          CreateDrivingCorridor(right_lanes[i], converted_lanelets, point_step, horizon));
+      }
+
+      for (const LaneIndices & lane : result.ego_alternatives) {
+        lanes.ego_lane_alternatives.push_back(
+          CreateDrivingCorridor(lane, converted_lanelets, point_step, horizon));
+      }
+
+      if (!is_density_reduced) {
+        frame_budget_.UpdateEstimate(kOuterCorridors, frame_budget_.GetElapsedMs() - t_outer);
+      }
+    }
+  }
+
+  out_lanes = std::move(lanes);
+}
+
+void MissionPlannerCore::HandleOdometry(const nav_msgs::msg::Odometry & msg)
+{
+  // Construct raw odometry pose
+  geometry_msgs::msg::PoseStamped odometry_pose_raw;
+  odometry_pose_raw.header = msg.header;
+  odometry_pose_raw.pose = msg.pose.pose;
+
+  // If the incoming odometry signal is properly filled, i.e. if the frame ids
+  // are given and report an odometry signal, do nothing, else we assume the
+  // odometry signal stems from the GNSS (and is therefore valid in the odom
+  // frame)
+  if (!(msg.header.frame_id == parameters_.local_map_frame && msg.child_frame_id == "base_link")) {
+    report_.is_odometry_frame_unexpected = true;
+  }
+
+  // Calculate yaw for received pose
+  double psi_cur = GetYawFromQuaternion(
+    odometry_pose_raw.pose.orientation.x, odometry_pose_raw.pose.orientation.y,
+    odometry_pose_raw.pose.orientation.z, odometry_pose_raw.pose.orientation.w);
+
+  if (state_.pose_prev_init) {
+    // Calculate and forward relative motion update to driving corridor model
+    const Pose2D pose_cur(
+      odometry_pose_raw.pose.position.x, odometry_pose_raw.pose.position.y, psi_cur);
+    const Pose2D d_pose = TransformToNewCosy2D(state_.pose_prev, pose_cur);
+
+    // Transform the target pose into the new cosy which is given in relation
+    // to the previous origin
+    Pose2D target_pose = {state_.goal_point.x(), state_.goal_point.y()};
+    target_pose = TransformToNewCosy2D(d_pose, target_pose);
+
+    // Overwrite goal point
+    state_.goal_point.x() = target_pose.get_x();
+    state_.goal_point.y() = target_pose.get_y();
+
+    // Recenter updated goal point to lie on centerline (to get rid of issues with a less accurate
+    // odometry update which could lead to loosing the goal lane), recenter only after a certain
+    // number of steps (recenter_period) to reduce the calling frequency
+    if (state_.recenter_counter >= parameters_.recenter_period) {
+      const lanelet::BasicPoint2d target_point_2d = RecenterGoalPoint(
+        state_.goal_point, state_.current_lanelets,
+        FindLaneletContainingPoint(
+          state_.goal_lanelet_tracker, state_.current_lanelets,
+          state_.current_lanelet_connections, state_.goal_point));
+
+      // Overwrite goal point
+      state_.goal_point.x() = target_point_2d.x();
+      state_.goal_point.y() = target_point_2d.y();
+
+      state_.recenter_counter = 0;
+    } else {
+      state_.recenter_counter++;
+    }
+
+    report_.is_motion_update = true;
+  } else {
+    state_.pose_prev_init = true;
+  }
+
+  // Update pose storage for next iteration
+  state_.pose_prev.set_x(odometry_pose_raw.pose.position.x);
+  state_.pose_prev.set_y(odometry_pose_raw.pose.position.y);
+  state_.pose_prev.set_psi(psi_cur);
+
+  state_.received_motion_update_once = true;
+}
+
+void MissionPlannerCore::HandleMission(const autoware_mapless_planning_msgs::msg::Mission & msg)
+{
+  // Unknown priorities are rejected, otherwise such a mission could not be replaced by any mission
+  if (msg.priority > autoware_mapless_planning_msgs::msg::Mission::PRIORITY_HIGH) {
+    report_.is_mission_rejected = true;
+    report_.is_mission_priority_invalid = true;
+    return;
+  }
+
+  // A mission does not replace an active mission (lane change or exit, also while the lane change
+  // is re-triggered) of a higher priority
+  const bool is_lane_change_pending =
+    !state_.lane_change_trigger_success &&
+    (state_.lane_change_direction == left || state_.lane_change_direction == right) &&
+    state_.retry_attempts <= parameters_.retrigger_attempts_max;
+  const bool is_mission_active =
+    state_.mission != stay || state_.target_lane != stay || is_lane_change_pending;
+  if (is_mission_active && msg.priority < state_.mission_priority) {
+    report_.is_mission_rejected = true;
+    return;
+  }
+  state_.mission_priority = msg.priority;
+
+  // Initialize variables
+  state_.lane_change_trigger_success = false;
+  state_.retry_attempts = 0;
+
+  switch (msg.mission_type) {
+    case autoware_mapless_planning_msgs::msg::Mission::LANE_KEEP:
+      // Keep the lane
+      state_.mission = stay;
+      state_.target_lane = stay;
+      break;
+    case autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_LEFT:
+      // Initiate left lane change
+      state_.lane_change_direction = left;
+      InitiateLaneChange(state_.lane_change_direction, state_.lane_left);
+      break;
+    case autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_RIGHT:
+      // Initiate right lane change
+      state_.lane_change_direction = right;
+      InitiateLaneChange(state_.lane_change_direction, state_.lane_right);
+      break;
+    case autoware_mapless_planning_msgs::msg::Mission::TAKE_NEXT_EXIT_LEFT:
+      // Initiate take next exit
+      state_.target_lane = left_most;  // Set target lane
+      break;
+    case autoware_mapless_planning_msgs::msg::Mission::TAKE_NEXT_EXIT_RIGHT:
+      // Initiate take next exit
+      state_.target_lane = right_most;  // Set target lane
+      break;
+    default:
+      // Nothing happens if mission does not match!
+      break;
+  }
+
+  state_.deadline_target_lane = msg.deadline;
+
+  // Publish the neighbor lanes with the next local map (lane keeping fast mode)
+  state_.neighbor_lanes_requested = true;
+}
+
+void MissionPlannerCore::InitiateLaneChange(
+  const Direction direction, const LaneIndices & neighboring_lane)
+{
+  state_.retry_attempts++;  // Increment retry attempts counter
+  if (neighboring_lane.size() == 0) {
+    // Neighbor lane is empty
+    report_.is_neighbor_lane_empty = true;
+  } else {
+    // Neighbor lane is available, initiate lane change
+    report_.is_lane_change_triggered = true;
+    state_.lane_change_trigger_success = true;
+    state_.mission = direction;
+    state_.target_lane = direction;
+    state_.goal_point = GetPointOnLane(
+      neighboring_lane, parameters_.projection_distance_on_goallane, state_.current_lanelets);
+  }
+}
+
+Lanes MissionPlannerCore::CalculateLanes(
+  const std::vector<lanelet::Lanelet> & converted_lanelets,
+  std::vector<LaneletConnection> & lanelet_connections)
+{
+  // Finds the ID of the ego vehicle occupied lanelet (returns -1 if no match, the vehicle is always
+  // located at (0, 0))
+  const int ego_lanelet_index = FindLaneletContainingPoint(
+    state_.ego_lanelet_tracker, converted_lanelets, lanelet_connections,
+    lanelet::BasicPoint2d(0.0, 0.0));
+
+  return CalculateLanes(converted_lanelets, lanelet_connections, ego_lanelet_index);
+}
+
+Lanes MissionPlannerCore::CalculateLanes(
+  const std::vector<lanelet::Lanelet> & converted_lanelets,
+  std::vector<LaneletConnection> & lanelet_connections, const int ego_lanelet_index)
+{
+  MAPLESS_PROFILE_STAGE(profiler_, kStageLaneCalculation);
+
+  // Initialize variables
+  std::vector<LaneIndices> ego_lane;
+  LaneIndices ego_lane_stripped_idx;
+  std::vector<LaneIndices> ego_alternatives;
+  std::vector<LaneIndices> left_lanes;
+  std::vector<LaneIndices> right_lanes;
+
+  if (ego_lanelet_index >= 0) {
+    // Get ego lane
+    ego_lane = GetAllSuccessorSequences(lanelet_connections, ego_lanelet_index);
+
+    // Extract the first available ego lane
+    if (ego_lane.size() > 0) {
+      ego_lane_stripped_idx = ego_lane[0];
+
+      // Alternative successor branches (e.g. at interchanges), enumerated lazily from the
+      // straightest one with a bounded budget, as full enumeration explodes on complex junctions
+      if (parameters_.lane_branch_budget.max_branches > 1) {
+        // Heading change between consecutive lanelets (straightness)
+        const auto heading_change = [&converted_lanelets](const int from, const int to) {
+          const auto get_heading = [&converted_lanelets](const int id) {
+            const lanelet::ConstLineString2d centerline = converted_lanelets[id].centerline2d();
+            if (centerline.size() < 2) return 0.0;
+            return std::atan2(
+              centerline.back().y() - centerline.front().y(),
+              centerline.back().x() - centerline.front().x());
+          };
+          return std::abs(NormalizePsi(get_heading(to) - get_heading(from)));
+        };
+
+        // The ego lane is one of the max_branches branches. The branches are truncated at the
+        // maximum depth and the budget but the ego lane is not, i.e. a branch which is a prefix of
+        // the ego lane is the ego lane.
+        const std::size_t max_alternatives =
+          static_cast<std::size_t>(parameters_.lane_branch_budget.max_branches - 1);
+        for (LaneIndices & branch : GetBestSuccessorSequences(
+               lanelet_connections, ego_lanelet_index, parameters_.lane_branch_budget,
+               heading_change)) {
+          if (ego_alternatives.size() >= max_alternatives) break;
+
+          const bool is_ego_lane =
+            branch.size() <= ego_lane_stripped_idx.size() &&
+            std::equal(branch.begin(), branch.end(), ego_lane_stripped_idx.begin());
+          if (!is_ego_lane) ego_alternatives.push_back(std::move(branch));
+        }
+      }
+
+      // Get all neighbor lanelets to the ego lanelet on the left side
+      const LaneIndices left_neighbors =
+        GetAllNeighboringLaneletIDs(lanelet_connections, ego_lanelet_index, VehicleSide::kLeft);
+
+      // Initialize current_lane and next_lane
+      LaneIndices current_lane = ego_lane_stripped_idx;
+      LaneIndices neighbor_lane;
+
+      for (size_t i = 0; i < left_neighbors.size(); ++i) {
+        neighbor_lane =
+          GetAllNeighborsOfLane(current_lane, lanelet_connections, VehicleSide::kLeft);
+
+        left_lanes.push_back(neighbor_lane);
+
+        current_lane = neighbor_lane;
+      }
+
+      // Get all neighbor lanelets to the ego lanelet on the right side
+      const LaneIndices right_neighbors =
+        GetAllNeighboringLaneletIDs(lanelet_connections, ego_lanelet_index, VehicleSide::kRight);
+
+      // Reinitialize current_lane
+      current_lane = ego_lane_stripped_idx;
+
+      for (size_t i = 0; i < right_neighbors.size(); ++i) {
+        neighbor_lane =
+          GetAllNeighborsOfLane(current_lane, lanelet_connections, VehicleSide::kRight);
+
+        right_lanes.push_back(neighbor_lane);
+
+        current_lane = neighbor_lane;
+      }
+    }
+  }
+
+  // Add one predecessor lanelet to the ego lane and its alternatives
+  InsertPredecessorLanelet(ego_lane_stripped_idx, lanelet_connections);
+  for (LaneIndices & lane : ego_alternatives) {
+    InsertPredecessorLanelet(lane, lanelet_connections);
+  }
+
+  // Add one predecessor lanelet to each of the left lanes
+  for (LaneIndices & lane : left_lanes) {
+    InsertPredecessorLanelet(lane, lanelet_connections);
+  }
+
+  // Add one predecessor lanelet to each of the right lanes
+  for (LaneIndices & lane : right_lanes) {
+    InsertPredecessorLanelet(lane, lanelet_connections);
+  }
+
+  // Return lanes
+  Lanes lanes;
+  lanes.ego_lanelet_index = ego_lanelet_index;
+  lanes.ego = std::move(ego_lane_stripped_idx);
+  lanes.ego_alternatives = std::move(ego_alternatives);
+  lanes.left = std::move(left_lanes);
+  lanes.right = std::move(right_lanes);
+
+  return lanes;
+}
+
+bool MissionPlannerCore::IsOnGoalLane(
+  const int ego_lanelet_index, const lanelet::BasicPoint2d & goal_point,
+  const std::vector<lanelet::Lanelet> & converted_lanelets,
+  const std::vector<LaneletConnection> & lanelet_connections)
+{
+  // Find the index of the lanelet containing the goal point (returns -1 if no match)
+  int goal_index = FindLaneletContainingPoint(
+    state_.goal_lanelet_tracker, converted_lanelets, lanelet_connections, goal_point);
+
+  if (goal_index < 0) return false;
+
+  // The vehicle is on the goal lane if the ego lanelet is the goal lanelet or one of its
+  // (indirect) predecessors
+  if (!lane_membership_.IsBuiltFrom(lanelet_connections)) {
+    lane_membership_.Build(lanelet_connections);
+  }
+  return lane_membership_.IsOnLaneTo(ego_lanelet_index, goal_index);
+}
+
+void MissionPlannerCore::FindTrackedLanelets(
+  const std::vector<LaneletConnection> & lanelet_connections, const bool is_goal_located,
+  int & ego_lanelet_index, int & goal_lanelet_index)
+{
+  // Tracked points: the ego vehicle (always located at (0, 0)) and the goal point
+  OccupiedLaneletTracker * const trackers[] = {
+    &state_.ego_lanelet_tracker, &state_.goal_lanelet_tracker};
+  const lanelet::BasicPoint2d points[] = {lanelet::BasicPoint2d(0.0, 0.0), state_.goal_point};
+  const std::size_t n_points = is_goal_located ? 2 : 1;
+
+  // The trackers test the remembered lanelets and their neighborhood first, the points they miss
+  // are looked up together in the grid of the polygon table
+  int ids[] = {-1, -1};
+  std::size_t misses[2];
+  double miss_x[2];
+  double miss_y[2];
+  std::size_t n_misses = 0;
+  for (std::size_t i = 0; i < n_points; i++) {
+    ids[i] = trackers[i]->FindNearRemembered(lanelet_polygons_, lanelet_connections, points[i]);
+    if (ids[i] >= 0) continue;
+    misses[n_misses] = i;
+    miss_x[n_misses] = points[i].x();
+    miss_y[n_misses] = points[i].y();
+    n_misses++;
+  }
+  if (n_misses > 0) {
+    lanelet_polygons_.FindContainingPolygons(miss_x, miss_y, n_misses, miss_lanelet_ids_);
+    for (std::size_t k = 0; k < n_misses; k++) {
+      ids[misses[k]] = trackers[misses[k]]->Remember(lanelet_connections, miss_lanelet_ids_[k]);
+    }
+  }
+
+  ego_lanelet_index = ids[0];
+  goal_lanelet_index = ids[1];
+}
+
+int MissionPlannerCore::FindLaneletContainingPoint(
+  OccupiedLaneletTracker & tracker, const std::vector<lanelet::Lanelet> & converted_lanelets,
+  const std::vector<LaneletConnection> & lanelet_connections, const lanelet::BasicPoint2d & point)
+{
+  if (!lanelet_polygons_.IsBuiltFrom(converted_lanelets)) {
+    lanelet_polygons_.Build(converted_lanelets);
+  }
+  return tracker.Find(lanelet_polygons_, lanelet_connections, point);
+}
+
+void MissionPlannerCore::CheckIfGoalPointShouldBeReset(
+  const lanelet::Lanelets & converted_lanelets,
+  const std::vector<LaneletConnection> & lanelet_connections)
+{
+  if (state_.goal_point.x() < 0 && state_.mission != stay) {
+    // Find the index of the lanelet containing the goal point (returns -1 if no match)
+    CheckIfGoalPointShouldBeReset(
+      converted_lanelets, lanelet_connections,
+      FindLaneletContainingPoint(
+        state_.goal_lanelet_tracker, converted_lanelets, lanelet_connections, state_.goal_point));
+  }
+}
+
+bool MissionPlannerCore::CheckIfGoalPointShouldBeReset(
+  const lanelet::Lanelets & converted_lanelets,
+  const std::vector<LaneletConnection> & lanelet_connections, const int goal_lanelet_index)
+{
+  // Check if goal point should be reset: If the x value of the goal point is
+  // negative, then the point is behind the vehicle and must be therefore reset.
+  if (state_.goal_point.x() < 0 && state_.mission != stay) {
+    if (goal_lanelet_index >= 0) {  // Check if -1
+      // Reset goal point
+      state_.goal_point = GetPointOnLane(
+        GetAllSuccessorSequences(lanelet_connections, goal_lanelet_index)[0],
+        parameters_.projection_distance_on_goallane, converted_lanelets);
+      return true;
+    } else {
+      // Reset of goal point not successful -> reset mission and target lane
+      report_.is_goal_lanelet_lost = true;
+
+      state_.target_lane = 0;
+      state_.mission = 0;
+    }
+  }
+  return false;
+}
+
+LaneletGraphReport MissionPlannerCore::ConvertInput2LaneletFormat(
+  const autoware_mapless_planning_msgs::msg::RoadSegments & msg,
+  std::vector<lanelet::Lanelet> & out_lanelets,
+  std::vector<LaneletConnection> & out_lanelet_connections)
+{
+  MAPLESS_PROFILE_STAGE(profiler_, kStageConversion);
+
+  // Local variables
+  const unsigned int n_linestrings_per_lanelet = 2;
+
+  // Left/right boundary of a lanelet
+  std::vector<lanelet::LineString3d> la_linestrings(n_linestrings_per_lanelet);
+
+  // Points per linestring
+  std::vector<lanelet::Point3d> ls_points = {};
+
+  out_lanelets.clear();
+  out_lanelet_connections.clear();
+  out_lanelet_connections.reserve(msg.segments.size());
+
+  // Get successor/neighbor lanelet information (with the original lanelet ids)
+  for (const auto & segment : msg.segments) {
+    out_lanelet_connections.push_back(LaneletConnection());
+    LaneletConnection & lanelet_connection = out_lanelet_connections.back();
+
+    lanelet_connection.original_lanelet_id = segment.id;
+    lanelet_connection.neighbor_lanelet_ids.assign(
+      segment.neighboring_segment_id.begin(), segment.neighboring_segment_id.end());
+    lanelet_connection.successor_lanelet_ids.assign(
+      segment.successor_segment_id.begin(), segment.successor_segment_id.end());
+
+    // The goal_information is not needed in this context, we set it to true for now
+    lanelet_connection.goal_information = true;
+  }
+
+  // Map the ids to the new (index-based) ids, fill the predecessors and validate the lanelet
+  // graph before the geometry is created (malformed local maps are rejected cheaply)
+  LaneletGraphReport report;
+  {
+    MAPLESS_PROFILE_STAGE(profiler_, kStagePredecessors);
+    report = NormalizeLaneletConnections(out_lanelet_connections);
+  }
+  if (!report.IsValid()) return report;
+
+  out_lanelets.reserve(msg.segments.size());
+
+  for (size_t idx_segment = 0; idx_segment < msg.segments.size(); idx_segment++) {
+    for (size_t idx_linestring = 0; idx_linestring < n_linestrings_per_lanelet; idx_linestring++) {
+      ls_points.clear();
+      ls_points.reserve(msg.segments[idx_segment].linestrings[idx_linestring].poses.size());
+      for (size_t id_pose = 0;
+           id_pose < msg.segments[idx_segment].linestrings[idx_linestring].poses.size();
+           id_pose++) {
+        double p1p =
+          msg.segments[idx_segment].linestrings[idx_linestring].poses[id_pose].position.x;
+        double p2p =
+          msg.segments[idx_segment].linestrings[idx_linestring].poses[id_pose].position.y;
+        double p3p =
+          msg.segments[idx_segment].linestrings[idx_linestring].poses[id_pose].position.z;
+
+        lanelet::Point3d p{lanelet::utils::getId(), p1p, p2p, p3p};
+        ls_points.push_back(p);
+      }
+
+      // Create a linestring from the collected points
+      lanelet::LineString3d linestring(lanelet::utils::getId(), ls_points);
+      la_linestrings[idx_linestring] = linestring;
+    }
+
+    // One lanelet consists of 2 boundaries, the centerline is created once per frame from the
+    // paired bounds (lanelet2 keeps it for all centerline() and centerline2d() calls)
+    lanelet::Lanelet lanelet(lanelet::utils::getId(), la_linestrings[0], la_linestrings[1]);
+    lanelet.setCenterline(CreatePairedBoundCenterline(la_linestrings[0], la_linestrings[1]));
+
+    out_lanelets.push_back(lanelet);
+  }
+
+  return report;
+}
+
+lanelet::BasicPoint2d MissionPlannerCore::GetPointOnLane(
+  const LaneIndices & lane, const float x_distance,
+  const std::vector<lanelet::Lanelet> & converted_lanelets)
+{
+  lanelet::BasicPoint2d return_point;  // return value
+
+  if (lane.size() > 0) {
+    lanelet::ConstLineString2d linestring =
+      CreateLineString(CreateDrivingCorridor(lane, converted_lanelets)
+                         .centerline);  // Create linestring for the lane
+
+    // Create point that is float meters in front (x axis)
+    lanelet::BasicPoint2d point(x_distance, 0.0);
+
+    // Get projected point on the linestring
+    lanelet::BasicPoint2d projected_point = lanelet::geometry::project(linestring, point);
+
+    // Overwrite p (return value)
+    return_point.x() = projected_point.x();
+    return_point.y() = projected_point.y();
+  } else {
+    // Overwriting of point may not have occurred properly, lane is probably empty
+    report_.is_point_on_empty_lane = true;
+  }
+
+  // Return point
+  return return_point;
+}
+
+double MissionPlannerCore::CalculateDistanceBetweenPointAndLineString(
+  const lanelet::ConstLineString2d & linestring, const lanelet::BasicPoint2d & point)
+{
+  // Get projected point on the linestring
+  lanelet::BasicPoint2d projected_point = lanelet::geometry::project(linestring, point);
+
+  // Calculate the distance between the two points
+  double distance = lanelet::geometry::distance2d(point, projected_point);
+
+  return distance;
+}
+
+}  // namespace autoware::mapless_architecture
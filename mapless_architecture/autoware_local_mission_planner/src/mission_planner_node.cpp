@@ -14,8 +14,10 @@
 
 #include "autoware/local_mission_planner/mission_planner_node.hpp"
 
-#include "lanelet2_core/LaneletMap.h"
-#include "lanelet2_core/geometry/Lanelet.h"
+#include "autoware/local_mission_planner_common/stage_diagnostics.hpp"
+#include "autoware/local_mission_planner_common/trace_service.hpp"
+
+#include <cinttypes>
 
 namespace autoware::mapless_architecture
 {
@@ -23,7 +25,7 @@ using std::placeholders::_1;
 
 MissionPlannerNode::MissionPlannerNode(
   const rclcpp::NodeOptions & options, const bool init_publishers_and_subscribers)
-: Node("mission_planner_node", options)
+: Node("mission_planner_node", options), core_(DeclareParameters())
 {
   // Set quality of service to best effort (if transmission fails, do not try to resend but rather
   // use new sensor data), the history_depth is set to 1 (message queue size)
@@ -45,14 +47,20 @@ MissionPlannerNode::MissionPlannerNode(
       this->create_publisher<autoware_mapless_planning_msgs::msg::MissionLanesStamped>(
         "mission_planner_node/output/mission_lanes_stamped", 1);
 
+    // Initialize publisher for the acknowledgements of the missions (reliable, every mission is
+    // acknowledged)
+    missionAckPublisher_ = this->create_publisher<autoware_mapless_planning_msgs::msg::MissionAck>(
+      "mission_planner_node/output/mission_ack", 10);
+
     // Initialize subscriber to local map messages
     mapSubscriber_ = this->create_subscription<autoware_mapless_planning_msgs::msg::LocalMap>(
       "mission_planner_node/input/local_map", qos,
       std::bind(&MissionPlannerNode::CallbackLocalMapMessages, this, _1));
 
-    // Initialize subscriber to mission messages
+    // Initialize subscriber to mission messages (reliable with a deeper history, each mission
+    // command matters and is acknowledged)
     missionSubscriber_ = this->create_subscription<autoware_mapless_planning_msgs::msg::Mission>(
-      "mission_planner/input/mission", qos,
+      "mission_planner/input/mission", 10,
       std::bind(&MissionPlannerNode::CallbackMissionMessages, this, _1));
 
     // Initialize subscriber to odometry messages
@@ -65,646 +73,313 @@ MissionPlannerNode::MissionPlannerNode(
   tf_buffer_ = std::make_unique<tf2_ros::Buffer>(this->get_clock());
   tf_listener_ = std::make_unique<tf2_ros::TransformListener>(*tf_buffer_);
 
+  // Publish the stage profiling statistics on /diagnostics (only if compiled in)
+  if (IsProfilingEnabled() && init_publishers_and_subscribers) {
+    diagnostic_updater_ = std::make_unique<diagnostic_updater::Updater>(this, 1.0);
+    diagnostic_updater_->setHardwareID("none");
+    diagnostic_updater_->add(
+      "mission_planner_stage_profiling",
+      [this](diagnostic_updater::DiagnosticStatusWrapper & stat) {
+        ProduceStageDiagnostics(core_.GetProfiler(), stat);
+      });
+  }
+
+  // Service to write the recorded trace events of the processing stages to a file
+  if (init_publishers_and_subscribers) trace_dump_service_ = CreateTraceDumpService(*this);
+}
+
+MissionPlannerParameters MissionPlannerNode::DeclareParameters()
+{
+  MissionPlannerParameters parameters;
+
   // Set ros parameters (DEFAULT values will be overwritten by external parameter file)
-  distance_to_centerline_threshold_ =
+  parameters.distance_to_centerline_threshold =
     declare_parameter<float>("distance_to_centerline_threshold", 0.2);
   RCLCPP_INFO(
     this->get_logger(), "Threshold distance to centerline for successful lane change: %.2f",
-    distance_to_centerline_threshold_);
+    parameters.distance_to_centerline_threshold);
 
-  projection_distance_on_goallane_ =
+  parameters.projection_distance_on_goallane =
     declare_parameter<float>("projection_distance_on_goallane", 30.0);
   RCLCPP_INFO(
     this->get_logger(), "Projection distance for goal point in mission: %.1f",
-    projection_distance_on_goallane_);
+    parameters.projection_distance_on_goallane);
 
-  retrigger_attempts_max_ = declare_parameter<int>("retrigger_attempts_max", 10);
+  parameters.retrigger_attempts_max = declare_parameter<int>("retrigger_attempts_max", 10);
   RCLCPP_INFO(
     this->get_logger(), "Number of attempts for triggering a lane change: %d",
-    retrigger_attempts_max_);
+    parameters.retrigger_attempts_max);
 
-  local_map_frame_ = declare_parameter<std::string>("local_map_frame", "map");
-  RCLCPP_INFO(this->get_logger(), "Local map frame identifier: %s", local_map_frame_.c_str());
+  parameters.local_map_frame = declare_parameter<std::string>("local_map_frame", "map");
+  RCLCPP_INFO(
+    this->get_logger(), "Local map frame identifier: %s", parameters.local_map_frame.c_str());
 
-  recenter_period_ = declare_parameter<int>("recenter_period", 10);
+  parameters.recenter_period = declare_parameter<int>("recenter_period", 10);
   RCLCPP_INFO(
     this->get_logger(),
     "After this number of odometry updates the goal point (used for lane change) is recentered (on "
     "the centerline): %d",
-    recenter_period_);
-}
+    parameters.recenter_period);
 
-void MissionPlannerNode::CallbackLocalMapMessages(
-  const autoware_mapless_planning_msgs::msg::LocalMap & msg)
-{
-  // Used for output
-  std::vector<LaneletConnection> lanelet_connections;
-  std::vector<lanelet::Lanelet> converted_lanelets;
+  parameters.frame_budget_ms = declare_parameter<double>("frame_budget_ms", 0.0);
+  RCLCPP_INFO(
+    this->get_logger(), "Compute budget per local map frame (0 disables the budget): %.1f ms",
+    parameters.frame_budget_ms);
 
-  ConvertInput2LaneletFormat(msg.road_segments, converted_lanelets, lanelet_connections);
+  parameters.budget_corridor_point_step = declare_parameter<int>("budget_corridor_point_step", 2);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "Only every n-th corridor point is kept if the corridor density is reduced to meet the frame "
+    "budget: %d",
+    parameters.budget_corridor_point_step);
 
-  // Get the lanes
-  Lanes result = MissionPlannerNode::CalculateLanes(converted_lanelets, lanelet_connections);
+  parameters.neighbor_lanes_decimation = declare_parameter<int>("neighbor_lanes_decimation", 1);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "While lane keeping, the neighbor lanes are only published in every n-th frame: %d",
+    parameters.neighbor_lanes_decimation);
 
-  // Get the ego lane
-  ego_lane_ = result.ego;
+  parameters.lane_branch_budget.max_branches = declare_parameter<int>("max_lane_branches", 4);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "Maximum number of successor branches of the ego lane (incl. the ego lane itself): %d",
+    parameters.lane_branch_budget.max_branches);
 
-  std::vector<std::vector<int>> left_lanes = result.left;
-  if (!left_lanes.empty()) {
-    lane_left_ = left_lanes[0];  // Store the first left lane (needed for lane change)
-  }
+  parameters.lane_branch_budget.max_depth = declare_parameter<int>("max_lane_branch_depth", 20);
+  RCLCPP_INFO(
+    this->get_logger(), "Maximum number of lanelets per successor branch: %d",
+    parameters.lane_branch_budget.max_depth);
 
-  std::vector<std::vector<int>> right_lanes = result.right;
-  if (!right_lanes.empty()) {
-    lane_right_ = right_lanes[0];  // Store the first right lane (needed for lane change)
-  }
+  parameters.corridor_horizon.forward = declare_parameter<double>("corridor_horizon_forward", -1.0);
+  RCLCPP_INFO(
+    this->get_logger(), "Arc-length horizon of the corridors ahead (negative: unbounded): %.1f m",
+    parameters.corridor_horizon.forward);
 
-  // Save current converted_lanelets
-  current_lanelets_ = converted_lanelets;
-
-  // Re-trigger lane change if necessary
-  if (lane_change_trigger_success_ == false && retry_attempts_ <= retrigger_attempts_max_) {
-    if (lane_change_direction_ == left) {
-      // Lane change to the left
-      InitiateLaneChange(left, lane_left_);
-    } else if (lane_change_direction_ == right) {
-      // Lane change to the right
-      InitiateLaneChange(right, lane_right_);
-    }
+  parameters.corridor_horizon.backward =
+    declare_parameter<double>("corridor_horizon_backward", -1.0);
+  RCLCPP_INFO(
+    this->get_logger(), "Arc-length horizon of the corridors behind (negative: unbounded): %.1f m",
+    parameters.corridor_horizon.backward);
+
+  return parameters;
+}
+
+void MissionPlannerNode::CallbackLocalMapMessages(
+  const autoware_mapless_planning_msgs::msg::LocalMap & msg)
+{
+  MAPLESS_TRACE_SCOPE("mission_planner", "local map callback");
+
+  autoware_mapless_planning_msgs::msg::MissionLanesStamped lanes;
+  const MissionPlannerReport report = core_.ProcessLocalMap(msg, lanes);
+  const MissionPlannerParameters & parameters = core_.GetParameters();
+  const MissionPlannerState & state = core_.GetState();
+  FrameBudget & frame_budget = core_.GetFrameBudget();
+
+  // Malformed local maps are rejected (the previous mission lanes stay valid)
+  const LaneletGraphReport & graph_report = report.graph_report;
+  if (report.is_local_map_rejected) {
+    RCLCPP_WARN_THROTTLE(
+      this->get_logger(), *this->get_clock(), 5000,
+      "Malformed local map rejected (duplicate ids: %zu, neighbor cycles: %zu), rejected local "
+      "maps so far: %zu",
+      graph_report.n_duplicate_ids, graph_report.n_neighbor_cycles, state.n_rejected_local_maps);
+    return;
+  }
+  if (graph_report.GetRepairCount() > 0) {
+    RCLCPP_DEBUG(
+      this->get_logger(),
+      "Repaired local map references (dangling: %zu, self: %zu, missing neighbors: %zu)",
+      graph_report.n_dangling_references, graph_report.n_self_references,
+      graph_report.n_filled_neighbor_slots);
   }
 
-  if (retry_attempts_ > retrigger_attempts_max_) {
+  LogLaneChangeEvents(report);
+  if (report.is_lane_change_failed) {
     // Lane change has failed, must be re-triggered manually
     RCLCPP_WARN(
-      this->get_logger(), "Lane change failed! Number of attempts: (%d/%d)", retry_attempts_,
-      retrigger_attempts_max_);
-
-    // Reset variable
-    lane_change_trigger_success_ = true;
-    retry_attempts_ = 0;
+      this->get_logger(), "Lane change failed! Number of attempts: (%d/%d)",
+      report.lane_change_attempts, parameters.retrigger_attempts_max);
   }
-
-  // Check if goal point should be reset, if yes -> reset goal point
-  CheckIfGoalPointShouldBeReset(converted_lanelets, lanelet_connections);
-
-  // Check if lane change was successful, if yes -> reset mission
-  if (mission_ != stay) {
-    int ego_lanelet_index = FindEgoOccupiedLaneletID(converted_lanelets);  // Returns -1 if no match
-    lanelet::BasicPoint2d pointEgo(0,
-                                   0);  // Vehicle is always located at (0, 0)
-
-    if (ego_lanelet_index >= 0) {
-      // Check if successful lane change
-      if (
-        IsOnGoalLane(ego_lanelet_index, goal_point_, converted_lanelets, lanelet_connections) &&
-        CalculateDistanceBetweenPointAndLineString(
-          converted_lanelets[ego_lanelet_index].centerline2d(), pointEgo) <=
-          distance_to_centerline_threshold_) {
-        // Reset mission to lane keeping
-        mission_ = stay;
-        target_lane_ = stay;
-      }
-
-      // Check if we are on the target lane, if yes -> update target_lane
-      if (IsOnGoalLane(ego_lanelet_index, goal_point_, converted_lanelets, lanelet_connections)) {
-        target_lane_ = stay;
-      } else {
-        target_lane_ = mission_;
-      }
-    }
+  if (report.is_goal_lanelet_lost) {
+    RCLCPP_WARN(this->get_logger(), "Lanelet of goal point cannot be determined, mission reset!");
   }
 
-  // Create a MarkerArray for clearing old markers
-  visualization_msgs::msg::Marker clear_marker;
-  clear_marker.action = visualization_msgs::msg::Marker::DELETEALL;
+  RCLCPP_DEBUG_THROTTLE(
+    this->get_logger(), *this->get_clock(), 10000,
+    "Lanelet lookup hit rate (ego: %.1f %% of %zu lookups, goal: %.1f %% of %zu lookups)",
+    100.0 * state.ego_lanelet_tracker.GetHitRate(), state.ego_lanelet_tracker.GetLookupCount(),
+    100.0 * state.goal_lanelet_tracker.GetHitRate(), state.goal_lanelet_tracker.GetLookupCount());
 
-  visualization_msgs::msg::MarkerArray clear_marker_array;
-  clear_marker_array.markers.push_back(clear_marker);
-
-  // Publish the clear marker array to delete old markers
-  visualization_publisher_centerline_->publish(clear_marker_array);
-
-  // Publish mission lanes
-  autoware_mapless_planning_msgs::msg::MissionLanesStamped lanes;
-  lanes.header.frame_id = msg.road_segments.header.frame_id;  // Same frame_id as msg
+  // Publish MissionLanesStamped message (same frame_id as msg)
   lanes.header.stamp = rclcpp::Node::now();
-
-  // Add target lane
-  switch (target_lane_) {
-    case stay:
-      lanes.target_lane = 0;
-      break;
-    case left:
-      lanes.target_lane = -1;
-      break;
-    case right:
-      lanes.target_lane = +1;
-      break;
-    case left_most:
-      lanes.target_lane = -2;
-      break;
-    case right_most:
-      lanes.target_lane = +2;
-      break;
-    default:
-      break;
+  {
+    MAPLESS_PROFILE_STAGE(core_.GetProfiler(), kStagePublish);
+    missionLanesStampedPublisher_->publish(lanes);
   }
 
-  lanes.deadline_target_lane = deadline_target_lane_;
+  // Visualize the centerlines of the driving corridors (after the mission lanes are published)
+  if (!frame_budget.IsShed(kVisualization)) {
+    MAPLESS_PROFILE_STAGE(core_.GetProfiler(), kStageVisualization);
+    const double t_visualization = frame_budget.GetElapsedMs();
+
+    // Create a MarkerArray for clearing old markers
+    visualization_msgs::msg::Marker clear_marker;
+    clear_marker.action = visualization_msgs::msg::Marker::DELETEALL;
 
-  // Create driving corridors and add them to the MissionLanesStamped message
-  lanes.ego_lane = CreateDrivingCorridor(ego_lane_, converted_lanelets);
-  VisualizeCenterlineOfDrivingCorridor(msg.road_segments, lanes.ego_lane);
+    visualization_msgs::msg::MarkerArray clear_marker_array;
+    clear_marker_array.markers.push_back(clear_marker);
 
-  // Initialize driving corridor
-  autoware_mapless_planning_msgs::msg::DrivingCorridor driving_corridor;
+    // Publish the clear marker array to delete old markers
+    visualization_publisher_centerline_->publish(clear_marker_array);
 
-  if (!left_lanes.empty()) {
-    for (const std::vector<int> & lane : left_lanes) {
-      driving_corridor = CreateDrivingCorridor(lane, converted_lanelets);
-      lanes.drivable_lanes_left.push_back(driving_corridor);
+    VisualizeCenterlineOfDrivingCorridor(msg.road_segments, lanes.ego_lane);
+    for (const auto & driving_corridor : lanes.drivable_lanes_left) {
       VisualizeCenterlineOfDrivingCorridor(msg.road_segments, driving_corridor);
     }
-  }
-
-  if (!right_lanes.empty()) {
-    for (const std::vector<int> & lane : right_lanes) {
-      driving_corridor = CreateDrivingCorridor(lane, converted_lanelets);
-      lanes.drivable_lanes_right.push_back(driving_corridor);
+    for (const auto & driving_corridor : lanes.drivable_lanes_right) {
       VisualizeCenterlineOfDrivingCorridor(msg.road_segments, driving_corridor);
     }
+
+    frame_budget.UpdateEstimate(
+      kCorridorVisualization, frame_budget.GetElapsedMs() - t_visualization);
   }
 
-  // Publish MissionLanesStamped message
-  missionLanesStampedPublisher_->publish(lanes);
+  // Report the shed work
+  if (frame_budget.HasShedWork()) {
+    RCLCPP_WARN_THROTTLE(
+      this->get_logger(), *this->get_clock(), 1000,
+      "Frame budget of %.1f ms at risk (frame took %.2f ms), shed: %s (frames with shed "
+      "visualization: %" PRIu64 ", outer lanes: %" PRIu64 ", corridor density: %" PRIu64 ")",
+      frame_budget.GetBudget(), frame_budget.GetElapsedMs(), frame_budget.GetShedReport().c_str(),
+      frame_budget.GetShedCount(kVisualization), frame_budget.GetShedCount(kOuterLanes),
+      frame_budget.GetShedCount(kCorridorDensity));
+  }
 }
 
 void MissionPlannerNode::CallbackOdometryMessages(const nav_msgs::msg::Odometry & msg)
 {
-  // Construct raw odometry pose
-  geometry_msgs::msg::PoseStamped odometry_pose_raw;
-  odometry_pose_raw.header = msg.header;
-  odometry_pose_raw.pose = msg.pose.pose;
-
-  // If the incoming odometry signal is properly filled, i.e. if the frame ids
-  // are given and report an odometry signal, do nothing, else we assume the
-  // odometry signal stems from the GNSS (and is therefore valid in the odom
-  // frame)
-  if (!(msg.header.frame_id == local_map_frame_ && msg.child_frame_id == "base_link")) {
-    if (!b_input_odom_frame_error_) {
-      RCLCPP_ERROR(
-        this->get_logger(),
-        "Your odometry signal doesn't match the expectation to be a "
-        "transformation from frame <%s> to <base_link>! The node will continue spinning but the "
-        "odometry signal should be checked! This error is printed only "
-        "once.",
-        local_map_frame_.c_str());
-      b_input_odom_frame_error_ = true;
-    }
-  }
-
-  // Calculate yaw for received pose
-  double psi_cur = GetYawFromQuaternion(
-    odometry_pose_raw.pose.orientation.x, odometry_pose_raw.pose.orientation.y,
-    odometry_pose_raw.pose.orientation.z, odometry_pose_raw.pose.orientation.w);
-
-  if (pose_prev_init_) {
-    // Calculate and forward relative motion update to driving corridor model
-    const Pose2D pose_cur(
-      odometry_pose_raw.pose.position.x, odometry_pose_raw.pose.position.y, psi_cur);
-    const Pose2D d_pose = TransformToNewCosy2D(pose_prev_, pose_cur);
-
-    // Transform the target pose into the new cosy which is given in relation
-    // to the previous origin
-    Pose2D target_pose = {goal_point_.x(), goal_point_.y()};
-    target_pose = TransformToNewCosy2D(d_pose, target_pose);
-
-    // Overwrite goal point
-    goal_point_.x() = target_pose.get_x();
-    goal_point_.y() = target_pose.get_y();
-
-    // Recenter updated goal point to lie on centerline (to get rid of issues with a less accurate
-    // odometry update which could lead to loosing the goal lane), recenter only after a certain
-    // number of steps (recenter_period_) to reduce the calling frequency
-    if (recenter_counter_ >= recenter_period_) {
-      const lanelet::BasicPoint2d target_point_2d =
-        RecenterGoalPoint(goal_point_, current_lanelets_);
-
-      // Overwrite goal point
-      goal_point_.x() = target_point_2d.x();
-      goal_point_.y() = target_point_2d.y();
-
-      recenter_counter_ = 0;
-    } else {
-      recenter_counter_++;
-    }
-
-    // Create marker for the goal point and publish it
-    visualization_msgs::msg::Marker goal_marker;  // Create a new marker
+  MAPLESS_TRACE_SCOPE("mission_planner", "odometry callback");
 
-    goal_marker.header.frame_id =
-      "base_link";  // The goal marker is always valid for the base_link frame
-    goal_marker.header.stamp = msg.header.stamp;
-    goal_marker.ns = "goal_point";
-    goal_marker.type = visualization_msgs::msg::Marker::POINTS;
-    goal_marker.action = visualization_msgs::msg::Marker::ADD;
-    goal_marker.pose.orientation.w = 1.0;  // Neutral orientation
-    goal_marker.scale.x = 6.0;
-    goal_marker.color.r = 1.0;  // Red color
-    goal_marker.color.a = 1.0;  // Full opacity
+  const MissionPlannerReport report = core_.ProcessOdometry(msg);
+  last_odom_msg_ = msg;
 
-    // Add goal point to the marker
-    geometry_msgs::msg::Point p_marker;
+  // If the incoming odometry signal is not properly filled, we assume the odometry signal stems
+  // from the GNSS (and is therefore valid in the odom frame)
+  if (report.is_odometry_frame_unexpected && !b_input_odom_frame_error_) {
+    RCLCPP_ERROR(
+      this->get_logger(),
+      "Your odometry signal doesn't match the expectation to be a "
+      "transformation from frame <%s> to <base_link>! The node will continue spinning but the "
+      "odometry signal should be checked! This error is printed only "
+      "once.",
+      core_.GetParameters().local_map_frame.c_str());
+    b_input_odom_frame_error_ = true;
+  }
 
-    p_marker.x = goal_point_.x();
-    p_marker.y = goal_point_.y();
+  if (!report.is_motion_update) return;
 
-    goal_marker.points.push_back(p_marker);
+  // Create marker for the (moved) goal point and publish it
+  const lanelet::BasicPoint2d & goal_point = core_.GetState().goal_point;
+  visualization_msgs::msg::Marker goal_marker;  // Create a new marker
 
-    // Clear all markers in scene
-    visualization_msgs::msg::Marker msg_marker;
-    msg_marker.header = msg.header;
-    msg_marker.type = visualization_msgs::msg::Marker::POINTS;
+  goal_marker.header.frame_id =
+    "base_link";  // The goal marker is always valid for the base_link frame
+  goal_marker.header.stamp = msg.header.stamp;
+  goal_marker.ns = "goal_point";
+  goal_marker.type = visualization_msgs::msg::Marker::POINTS;
+  goal_marker.action = visualization_msgs::msg::Marker::ADD;
+  goal_marker.pose.orientation.w = 1.0;  // Neutral orientation
+  goal_marker.scale.x = 6.0;
+  goal_marker.color.r = 1.0;  // Red color
+  goal_marker.color.a = 1.0;  // Full opacity
 
-    // This specifies the clear all / delete all action
-    msg_marker.action = 3;
-    visualizationGoalPointPublisher_->publish(msg_marker);
+  // Add goal point to the marker
+  geometry_msgs::msg::Point p_marker;
 
-    visualizationGoalPointPublisher_->publish(goal_marker);
+  p_marker.x = goal_point.x();
+  p_marker.y = goal_point.y();
 
-    last_odom_msg_ = msg;
-  } else {
-    pose_prev_init_ = true;
-    last_odom_msg_ = msg;
-  }
+  goal_marker.points.push_back(p_marker);
 
-  // Update pose storage for next iteration
-  pose_prev_.set_x(odometry_pose_raw.pose.position.x);
-  pose_prev_.set_y(odometry_pose_raw.pose.position.y);
-  pose_prev_.set_psi(psi_cur);
+  // Clear all markers in scene
+  visualization_msgs::msg::Marker msg_marker;
+  msg_marker.header = msg.header;
+  msg_marker.type = visualization_msgs::msg::Marker::POINTS;
 
-  received_motion_update_once_ = true;
+  // This specifies the clear all / delete all action
+  msg_marker.action = 3;
+  visualizationGoalPointPublisher_->publish(msg_marker);
 
-  return;
+  visualizationGoalPointPublisher_->publish(goal_marker);
 }
 
 void MissionPlannerNode::CallbackMissionMessages(
   const autoware_mapless_planning_msgs::msg::Mission & msg)
 {
-  // Initialize variables
-  lane_change_trigger_success_ = false;
-  retry_attempts_ = 0;
+  MAPLESS_TRACE_SCOPE("mission_planner", "mission callback");
+
+  const MissionPlannerReport report = core_.ProcessMission(msg);
+
+  // Acknowledge the mission with the time it was processed (command latency)
+  autoware_mapless_planning_msgs::msg::MissionAck ack;
+  ack.stamp = msg.stamp;
+  ack.accepted_stamp = rclcpp::Node::now();
+  ack.mission_type = msg.mission_type;
+  ack.priority = msg.priority;
+  ack.accepted = !report.is_mission_rejected;
+  missionAckPublisher_->publish(ack);
+
+  if (report.is_mission_priority_invalid) {
+    RCLCPP_WARN(
+      this->get_logger(), "Mission rejected, unknown priority %u.",
+      static_cast<unsigned int>(msg.priority));
+    return;
+  }
+  if (report.is_mission_rejected) {
+    RCLCPP_WARN(
+      this->get_logger(), "Mission rejected, the active mission has a higher priority (%u > %u).",
+      static_cast<unsigned int>(core_.GetState().mission_priority),
+      static_cast<unsigned int>(msg.priority));
+    return;
+  }
 
   switch (msg.mission_type) {
     case autoware_mapless_planning_msgs::msg::Mission::LANE_KEEP:
-      // Keep the lane
-      mission_ = stay;
-      target_lane_ = stay;
       break;
     case autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_LEFT:
-      // Initiate left lane change
       RCLCPP_INFO(this->get_logger(), "Lane change to the left initiated.");
-      lane_change_direction_ = left;
-      InitiateLaneChange(lane_change_direction_, lane_left_);
       break;
     case autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_RIGHT:
-      // Initiate right lane change
       RCLCPP_INFO(this->get_logger(), "Lane change to the right initiated.");
-      lane_change_direction_ = right;
-      InitiateLaneChange(lane_change_direction_, lane_right_);
       break;
     case autoware_mapless_planning_msgs::msg::Mission::TAKE_NEXT_EXIT_LEFT:
-      // Initiate take next exit
       RCLCPP_INFO(this->get_logger(), "Take next exit (left) initiated.");
-      target_lane_ = left_most;  // Set target lane
       break;
     case autoware_mapless_planning_msgs::msg::Mission::TAKE_NEXT_EXIT_RIGHT:
-      // Initiate take next exit
       RCLCPP_INFO(this->get_logger(), "Take next exit (right) initiated.");
-      target_lane_ = right_most;  // Set target lane
       break;
     default:
       // Nothing happens if mission does not match!
       RCLCPP_INFO(this->get_logger(), "Mission does not match.");
   }
 
-  deadline_target_lane_ = msg.deadline;
-
-  return;
+  LogLaneChangeEvents(report);
 }
 
-void MissionPlannerNode::InitiateLaneChange(
-  const Direction direction, const std::vector<int> & neighboring_lane)
+void MissionPlannerNode::LogLaneChangeEvents(const MissionPlannerReport & report)
 {
-  retry_attempts_++;  // Increment retry attempts counter
-  if (neighboring_lane.size() == 0) {
-    // Neighbor lane is empty
+  if (report.is_neighbor_lane_empty) {
     RCLCPP_WARN(this->get_logger(), "Empty neighbor lane!");
-  } else {
-    // Neighbor lane is available, initiate lane change
-    RCLCPP_WARN(this->get_logger(), "Lane change successfully triggered!");
-    lane_change_trigger_success_ = true;
-    mission_ = direction;
-    target_lane_ = direction;
-    goal_point_ =
-      GetPointOnLane(neighboring_lane, projection_distance_on_goallane_, current_lanelets_);
-  }
-}
-
-Lanes MissionPlannerNode::CalculateLanes(
-  const std::vector<lanelet::Lanelet> & converted_lanelets,
-  std::vector<LaneletConnection> & lanelet_connections)
-{
-  // Calculate centerlines, left and right bounds
-  std::vector<lanelet::ConstLineString3d> centerlines;
-  std::vector<lanelet::ConstLineString3d> left_bounds;
-  std::vector<lanelet::ConstLineString3d> right_bounds;
-
-  int ego_lanelet_index =
-    FindEgoOccupiedLaneletID(converted_lanelets);  // Finds the ID of the ego vehicle occupied
-                                                   // lanelet (returns -1 if no match)
-
-  // Initialize variables
-  std::vector<std::vector<int>> ego_lane;
-  std::vector<int> ego_lane_stripped_idx = {};
-  std::vector<std::vector<int>> left_lanes = {};
-  std::vector<std::vector<int>> right_lanes = {};
-
-  if (ego_lanelet_index >= 0) {
-    // Get ego lane
-    ego_lane = GetAllSuccessorSequences(lanelet_connections, ego_lanelet_index);
-
-    // Extract the first available ego lane
-    if (ego_lane.size() > 0) {
-      ego_lane_stripped_idx = ego_lane[0];
-
-      // Get all neighbor lanelets to the ego lanelet on the left side
-      std::vector<int> left_neighbors =
-        GetAllNeighboringLaneletIDs(lanelet_connections, ego_lanelet_index, VehicleSide::kLeft);
-
-      // Initialize current_lane and next_lane
-      std::vector<int> current_lane = ego_lane_stripped_idx;
-      std::vector<int> neighbor_lane;
-
-      for (size_t i = 0; i < left_neighbors.size(); ++i) {
-        neighbor_lane =
-          GetAllNeighborsOfLane(current_lane, lanelet_connections, VehicleSide::kLeft);
-
-        left_lanes.push_back(neighbor_lane);
-
-        current_lane = neighbor_lane;
-      }
-
-      // Get all neighbor lanelets to the ego lanelet on the right side
-      std::vector<int> right_neighbors =
-        GetAllNeighboringLaneletIDs(lanelet_connections, ego_lanelet_index, VehicleSide::kRight);
-
-      // Reinitialize current_lane
-      current_lane = ego_lane_stripped_idx;
-
-      for (size_t i = 0; i < right_neighbors.size(); ++i) {
-        neighbor_lane =
-          GetAllNeighborsOfLane(current_lane, lanelet_connections, VehicleSide::kRight);
-
-        right_lanes.push_back(neighbor_lane);
-
-        current_lane = neighbor_lane;
-      }
-    }
-  }
-
-  // Add one predecessor lanelet to the ego lane
-  InsertPredecessorLanelet(ego_lane_stripped_idx, lanelet_connections);
-
-  // Add one predecessor lanelet to each of the left lanes
-  for (std::vector<int> & lane : left_lanes) {
-    InsertPredecessorLanelet(lane, lanelet_connections);
   }
-
-  // Add one predecessor lanelet to each of the right lanes
-  for (std::vector<int> & lane : right_lanes) {
-    InsertPredecessorLanelet(lane, lanelet_connections);
-  }
-
-  // Return lanes
-  Lanes lanes;
-  lanes.ego = ego_lane_stripped_idx;
-  lanes.left = left_lanes;
-  lanes.right = right_lanes;
-
-  return lanes;
-}
-
-bool MissionPlannerNode::IsOnGoalLane(
-  const int ego_lanelet_index, const lanelet::BasicPoint2d & goal_point,
-  const std::vector<lanelet::Lanelet> & converted_lanelets,
-  const std::vector<LaneletConnection> & lanelet_connections)
-{
-  bool result = false;
-
-  // Find the index of the lanelet containing the goal point
-  int goal_index = FindOccupiedLaneletID(converted_lanelets, goal_point);  // Returns -1 if no match
-
-  if (goal_index >= 0) {  // Check if -1
-    std::vector<std::vector<int>> goal_lane = GetAllPredecessorSequences(
-      lanelet_connections,
-      goal_index);  // Get goal lane
-
-    // Check if vehicle is on goal lane
-    if (ego_lanelet_index == goal_index) {
-      result = true;
-    }
-
-    for (const auto & innerVec : goal_lane) {
-      for (int value : innerVec) {
-        if (value == ego_lanelet_index) {
-          result = true;
-        }
-      }
-    }
-  }
-  return result;
-}
-
-void MissionPlannerNode::CheckIfGoalPointShouldBeReset(
-  const lanelet::Lanelets & converted_lanelets,
-  const std::vector<LaneletConnection> & lanelet_connections)
-{
-  // Check if goal point should be reset: If the x value of the goal point is
-  // negative, then the point is behind the vehicle and must be therefore reset.
-  if (goal_point_.x() < 0 && mission_ != stay) {
-    // Find the index of the lanelet containing the goal point
-    int goal_index =
-      FindOccupiedLaneletID(converted_lanelets, goal_point_);  // Returns -1 if no match
-
-    if (goal_index >= 0) {  // Check if -1
-      // Reset goal point
-      goal_point_ = GetPointOnLane(
-        GetAllSuccessorSequences(lanelet_connections, goal_index)[0],
-        projection_distance_on_goallane_, converted_lanelets);
-    } else {
-      // Reset of goal point not successful -> reset mission and target lane
-      RCLCPP_WARN(this->get_logger(), "Lanelet of goal point cannot be determined, mission reset!");
-
-      target_lane_ = 0;
-      mission_ = 0;
-    }
-  }
-}
-
-// Getter for goal_point_
-lanelet::BasicPoint2d MissionPlannerNode::goal_point()
-{
-  return goal_point_;
-}
-
-// Setter for goal_point_
-void MissionPlannerNode::goal_point(const lanelet::BasicPoint2d & goal_point)
-{
-  goal_point_ = goal_point;
-}
-
-void MissionPlannerNode::ConvertInput2LaneletFormat(
-  const autoware_mapless_planning_msgs::msg::RoadSegments & msg,
-  std::vector<lanelet::Lanelet> & out_lanelets,
-  std::vector<LaneletConnection> & out_lanelet_connections)
-{
-  // Local variables
-  const unsigned int n_linestrings_per_lanelet = 2;
-
-  // Left/right boundary of a lanelet
-  std::vector<lanelet::LineString3d> la_linestrings(n_linestrings_per_lanelet);
-
-  // Points per linestring
-  std::vector<lanelet::Point3d> ls_points = {};
-
-  // Store mapping from original lanelet ids to new (index-based) ids
-  std::unordered_map<uint, size_t> map_original_to_new;
-
-  out_lanelets.reserve(msg.segments.size());
-  out_lanelet_connections.reserve(msg.segments.size());
-
-  for (size_t idx_segment = 0; idx_segment < msg.segments.size(); idx_segment++) {
-    for (size_t idx_linestring = 0; idx_linestring < n_linestrings_per_lanelet; idx_linestring++) {
-      ls_points.clear();
-      ls_points.reserve(msg.segments[idx_segment].linestrings[idx_linestring].poses.size());
-      for (size_t id_pose = 0;
-           id_pose < msg.segments[idx_segment].linestrings[idx_linestring].poses.size();
-           id_pose++) {
-        double p1p =
-          msg.segments[idx_segment].linestrings[idx_linestring].poses[id_pose].position.x;
-        double p2p =
-          msg.segments[idx_segment].linestrings[idx_linestring].poses[id_pose].position.y;
-        double p3p =
-          msg.segments[idx_segment].linestrings[idx_linestring].poses[id_pose].position.z;
-
-        lanelet::Point3d p{lanelet::utils::getId(), p1p, p2p, p3p};
-        ls_points.push_back(p);
-      }
-
-      // Create a linestring from the collected points
-      lanelet::LineString3d linestring(lanelet::utils::getId(), ls_points);
-      la_linestrings[idx_linestring] = linestring;
-    }
-
-    // One lanelet consists of 2 boundaries
-    lanelet::Lanelet lanelet(lanelet::utils::getId(), la_linestrings[0], la_linestrings[1]);
-
-    out_lanelets.push_back(lanelet);
-
-    // Add empty lanelet connection
-    out_lanelet_connections.push_back(LaneletConnection());
-
-    // Set origin lanelet ID (and store it in translation map)
-    out_lanelet_connections[idx_segment].original_lanelet_id = msg.segments[idx_segment].id;
-    map_original_to_new[msg.segments[idx_segment].id] = idx_segment;
-
-    // Get successor/neighbor lanelet information
-
-    // Write lanelet neighbors
-    for (std::size_t i = 0; i < msg.segments[idx_segment].neighboring_segment_id.size(); i++) {
-      out_lanelet_connections[idx_segment].neighbor_lanelet_ids.push_back(
-        msg.segments[idx_segment].neighboring_segment_id[i]);
-    }
-
-    // Write lanelet successors
-    for (std::size_t i = 0; i < msg.segments[idx_segment].successor_segment_id.size(); i++) {
-      out_lanelet_connections[idx_segment].successor_lanelet_ids.push_back(
-        msg.segments[idx_segment].successor_segment_id[i]);
-    }
-
-    // The goal_information is not needed in this context, we set it to true for now
-    out_lanelet_connections[idx_segment].goal_information = true;
-  }
-
-  // Define lambda function to replace old id with a new one
-  auto ReplaceAndWarnIfNotFound = [&](auto & segment_ids) {
-    for (auto & segment_id : segment_ids) {
-      if (segment_id >= 0) {
-        auto it = map_original_to_new.find(segment_id);
-        if (it != map_original_to_new.end()) {
-          segment_id = it->second;
-        } else {
-          // Key %i seems to be not present in the provided lanelet.
-        }
-      }
-    }
-  };
-
-  // Update each entity in all lanelets
-  for (auto & lanelet_connection : out_lanelet_connections) {
-    ReplaceAndWarnIfNotFound(lanelet_connection.predecessor_lanelet_ids);
-    ReplaceAndWarnIfNotFound(lanelet_connection.successor_lanelet_ids);
-    ReplaceAndWarnIfNotFound(lanelet_connection.neighbor_lanelet_ids);
+  if (report.is_lane_change_triggered) {
+    RCLCPP_WARN(this->get_logger(), "Lane change successfully triggered!");
   }
-
-  // Fill predecessor field for each lanelet
-  CalculatePredecessors(out_lanelet_connections);
-
-  return;
-}
-
-lanelet::BasicPoint2d MissionPlannerNode::GetPointOnLane(
-  const std::vector<int> & lane, const float x_distance,
-  const std::vector<lanelet::Lanelet> & converted_lanelets)
-{
-  lanelet::BasicPoint2d return_point;  // return value
-
-  if (lane.size() > 0) {
-    lanelet::ConstLineString2d linestring =
-      CreateLineString(CreateDrivingCorridor(lane, converted_lanelets)
-                         .centerline);  // Create linestring for the lane
-
-    // Create point that is float meters in front (x axis)
-    lanelet::BasicPoint2d point(x_distance, 0.0);
-
-    // Get projected point on the linestring
-    lanelet::BasicPoint2d projected_point = lanelet::geometry::project(linestring, point);
-
-    // Overwrite p (return value)
-    return_point.x() = projected_point.x();
-    return_point.y() = projected_point.y();
-  } else {
+  if (report.is_point_on_empty_lane) {
     RCLCPP_WARN(
       this->get_logger(),
       "Overwriting of point may not have occurred properly. Lane is "
       "probably empty.");
   }
-
-  // Return point
-  return return_point;
-}
-
-double MissionPlannerNode::CalculateDistanceBetweenPointAndLineString(
-  const lanelet::ConstLineString2d & linestring, const lanelet::BasicPoint2d & point)
-{
-  // Get projected point on the linestring
-  lanelet::BasicPoint2d projected_point = lanelet::geometry::project(linestring, point);
-
-  // Calculate the distance between the two points
-  double distance = lanelet::geometry::distance2d(point, projected_point);
-
-  return distance;
 }
 
 void MissionPlannerNode::VisualizeCenterlineOfDrivingCorridor(
@@ -12,13 +12,32 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "autoware/local_mission_planner/batch_mission_planner.hpp"
+#include "autoware/local_mission_planner/mission_planner_core.hpp"
 #include "autoware/local_mission_planner/mission_planner_node.hpp"
+#include "autoware/local_mission_planner_common/corridor_emitter.hpp"
 #include "autoware/local_mission_planner_common/helper_functions.hpp"
+#include "autoware/local_mission_planner_common/lane_branch_enumerator.hpp"
+#include "autoware/local_mission_planner_common/lane_membership_table.hpp"
+#include "autoware/local_mission_planner_common/lanelet_graph_validation.hpp"
+#include "autoware/local_mission_planner_common/lanelet_polygon_table.hpp"
+#include "autoware/local_mission_planner_common/occupied_lanelet_tracker.hpp"
+#include "autoware/local_mission_planner_common/polyline_simplifier.hpp"
+#include "autoware/local_mission_planner_common/trace_recorder.hpp"
 #include "gtest/gtest.h"
+#include "lanelet2_core/geometry/Lanelet.h"
 
 #include "geometry_msgs/msg/pose.hpp"
+#include "geometry_msgs/msg/pose_stamped.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <set>
+#include <thread>
 
 namespace autoware::mapless_architecture
 {
@@ -40,22 +59,6 @@ protected:
   }
 };
 
-/**
- * @brief Mock class for MissionPlannerNode
- */
-class MissionPlannerNodeMock : public MissionPlannerNode
-{
-public:
-  explicit MissionPlannerNodeMock(const rclcpp::NodeOptions & options)
-  : MissionPlannerNode(options, false)
-  {
-    // Mock constructor intentionally does nothing.
-  }
-
-  // Setter for mission
-  void SetMission(const Direction & mission) { mission_ = mission; }
-};
-
 /**
  * @brief Create test road segments for the tests.
  */
@@ -299,9 +302,8 @@ std::tuple<std::vector<lanelet::Lanelet>, std::vector<LaneletConnection>> Create
   message.segments[1].successor_segment_id = {-1};
   message.segments[1].neighboring_segment_id = {-1, -1};
 
-  // Initialize MissionPlannerNodeMock
-  rclcpp::NodeOptions options;
-  MissionPlannerNodeMock mission_planner(options);
+  // Initialize the planning core
+  MissionPlannerCore mission_planner;
 
   // Output
   std::vector<LaneletConnection> lanelet_connections;
@@ -335,9 +337,8 @@ TEST_F(MissionPlannerTest, TestCalculateDistanceBetweenPointAndLineStringExample
   // Create an example point
   const lanelet::BasicPoint2d point(1.0, 1.0);
 
-  // Initialize MissionPlannerNodeMock
-  rclcpp::NodeOptions options;
-  MissionPlannerNodeMock mission_planner(options);
+  // Initialize the planning core
+  MissionPlannerCore mission_planner;
 
   // Run function
   const auto distance =
@@ -358,9 +359,8 @@ TEST_F(MissionPlannerTest, TestGetPointOnLaneExampleInputAndOutput)
   // Create some example segments
   const auto road_segments = CreateSegments();
 
-  // Initialize MissionPlannerNodeMock
-  rclcpp::NodeOptions options;
-  MissionPlannerNodeMock mission_planner(options);
+  // Initialize the planning core
+  MissionPlannerCore mission_planner;
 
   // Convert road model
   std::vector<LaneletConnection> lanelet_connections;
@@ -391,9 +391,8 @@ TEST_F(MissionPlannerTest, TestGetPointOnLaneExampleInputAndOutput)
  */
 TEST_F(MissionPlannerTest, TestRecenterGoalPointExampleInputAndOutput)
 {
-  // Initialize MissionPlannerNodeMock
-  rclcpp::NodeOptions options;
-  MissionPlannerNodeMock mission_planner(options);
+  // Initialize the planning core
+  MissionPlannerCore mission_planner;
 
   // Get a local road model for testing
   const auto road_segments = GetTestRoadModelForRecenterTests();
@@ -467,9 +466,8 @@ TEST_F(MissionPlannerTest, TestIsOnGoalLaneExampleInputAndOutput)
   // Create some example segments
   const auto road_segments = CreateSegments();
 
-  // Initialize MissionPlannerNodeMock
-  rclcpp::NodeOptions options;
-  MissionPlannerNodeMock mission_planner(options);
+  // Initialize the planning core
+  MissionPlannerCore mission_planner;
 
   // Convert road model
   std::vector<LaneletConnection> lanelet_connections;
@@ -509,9 +507,8 @@ TEST_F(MissionPlannerTest, TestCheckIfGoalPointShouldBeResetExampleInputAndOutpu
   autoware_mapless_planning_msgs::msg::LocalMap local_map;
   local_map.road_segments = road_segments;
 
-  // Initialize MissionPlannerNodeMock
-  rclcpp::NodeOptions options;
-  MissionPlannerNodeMock mission_planner(options);
+  // Initialize the planning core
+  MissionPlannerCore mission_planner;
 
   // Convert road model
   std::vector<LaneletConnection> lanelet_connections;
@@ -522,32 +519,32 @@ TEST_F(MissionPlannerTest, TestCheckIfGoalPointShouldBeResetExampleInputAndOutpu
   // TEST 1: check if goal point is reset in non-default mission
   // Define a goal point with negative x value
   const lanelet::BasicPoint2d point(-1.0, 0.0);
-  mission_planner.goal_point(point);
+  mission_planner.GetState().goal_point = point;
 
   // Set a non-default mission to make the goal point reset work
-  mission_planner.SetMission(left);
+  mission_planner.GetState().mission = left;
 
   // Call function which is tested
   mission_planner.CheckIfGoalPointShouldBeReset(lanelets, lanelet_connections);
 
   // Check if the goal point is reset
   EXPECT_EQ(
-    mission_planner.goal_point().x(),
+    mission_planner.GetState().goal_point.x(),
     20);  // Projection is to x = 10, since this is the highest x value
           // on the right neighbor lane!
 
   // TEST 2: check if goal point reset is skipped in default mission
-  mission_planner.goal_point(point);
+  mission_planner.GetState().goal_point = point;
 
   // Set a default mission to make the goal point reset work
-  mission_planner.SetMission(stay);
+  mission_planner.GetState().mission = stay;
 
   // Call function which is tested
   mission_planner.CheckIfGoalPointShouldBeReset(lanelets, lanelet_connections);
 
   // Check if the goal point is reset
   EXPECT_EQ(
-    mission_planner.goal_point().x(),
+    mission_planner.GetState().goal_point.x(),
     point.x());  // goal point should equal the input point since goal point
                  // is not reset in the default mission (ego lane following)
 }
@@ -563,13 +560,15 @@ TEST_F(MissionPlannerTest, TestCalculateLanesExampleInputAndOutput)
   const auto lanelets = std::get<0>(tuple);
   auto lanelet_connections = std::get<1>(tuple);
 
-  // Initialize MissionPlannerNodeMock
-  rclcpp::NodeOptions options;
-  MissionPlannerNodeMock mission_planner(options);
+  // Initialize the planning core
+  MissionPlannerCore mission_planner;
 
   // Call function which is tested
   const auto result = mission_planner.CalculateLanes(lanelets, lanelet_connections);
 
+  // Check the ego lanelet
+  EXPECT_EQ(result.ego_lanelet_index, 0);
+
   // Get lanes
   const auto ego_lane_idx = result.ego;
   const auto left_lane_idx = result.left[0];
@@ -591,6 +590,57 @@ TEST_F(MissionPlannerTest, TestCalculateLanesExampleInputAndOutput)
     1);  // Expect ego lane = {0, 1} (1 is index of successor of ego lanelet)
 }
 
+/**
+ * @brief Test the alternative successor branches of the ego lane in CalculateLanes().
+ */
+TEST_F(MissionPlannerTest, TestCalculateLanesAlternatives)
+{
+  const auto tuple = CreateLane();
+  std::vector<lanelet::Lanelet> lanelets = std::get<0>(tuple);
+  std::vector<LaneletConnection> lanelet_connections = std::get<1>(tuple);
+
+  // A branch truncated at the maximum depth is the ego lane, not an alternative
+  MissionPlannerParameters parameters;
+  parameters.lane_branch_budget.max_branches = 4;
+  parameters.lane_branch_budget.max_depth = 1;
+  Lanes lanes = MissionPlannerCore(parameters).CalculateLanes(lanelets, lanelet_connections);
+  ASSERT_EQ(lanes.ego.size(), 2u);
+  EXPECT_TRUE(lanes.ego_alternatives.empty());
+
+  // Three successors of the ego lanelet: a left turn (listed first) and two straight lanelets
+  lanelet::LineString3d left_bound(0);
+  lanelet::LineString3d right_bound(0);
+  left_bound.push_back(lanelet::Point3d(0, 10.0, -0.5, 0.0));
+  left_bound.push_back(lanelet::Point3d(0, 16.0, 7.0, 0.0));
+  right_bound.push_back(lanelet::Point3d(0, 10.0, 0.5, 0.0));
+  right_bound.push_back(lanelet::Point3d(0, 15.0, 7.5, 0.0));
+  lanelets.push_back(lanelet::Lanelet(1000002, left_bound, right_bound));
+  lanelets.push_back(lanelet::Lanelet(1000003, lanelets[1].leftBound(), lanelets[1].rightBound()));
+
+  lanelet_connections.resize(4);
+  for (std::size_t i = 2; i < 4; i++) {
+    lanelet_connections[i].original_lanelet_id = static_cast<int>(i);
+    lanelet_connections[i].predecessor_lanelet_ids = {0};
+    lanelet_connections[i].successor_lanelet_ids = {-1};
+    lanelet_connections[i].neighbor_lanelet_ids = {-1, -1};
+    lanelet_connections[i].goal_information = false;
+  }
+  lanelet_connections[0].successor_lanelet_ids = {2, 1, 3};
+
+  // The ego lane counts as one of the branches, the alternatives never repeat it
+  for (const int max_branches : {1, 2, 3, 4}) {
+    parameters = MissionPlannerParameters();
+    parameters.lane_branch_budget.max_branches = max_branches;
+    lanes = MissionPlannerCore(parameters).CalculateLanes(lanelets, lanelet_connections);
+    ASSERT_EQ(lanes.ego.size(), 2u);
+    const int n_alternatives = std::min(max_branches, 3) - 1;
+    EXPECT_EQ(lanes.ego_alternatives.size(), static_cast<std::size_t>(n_alternatives));
+    for (const LaneIndices & alternative : lanes.ego_alternatives) {
+      EXPECT_NE(alternative, lanes.ego);
+    }
+  }
+}
+
 /**
  * @brief Test CreateMarkerArray_() function.
  */
@@ -601,9 +651,8 @@ TEST_F(MissionPlannerTest, TestCreateMarkerArrayExampleInputAndOutput)
   const auto lanelets = std::get<0>(tuple);
   const auto lanelet_connections = std::get<1>(tuple);
 
-  // Initialize MissionPlannerNodeMock
-  rclcpp::NodeOptions options;
-  MissionPlannerNodeMock mission_planner(options);
+  // Initialize the planning core
+  MissionPlannerCore mission_planner;
 
   // Create empty message
   autoware_mapless_planning_msgs::msg::RoadSegments message;
@@ -649,9 +698,8 @@ TEST_F(MissionPlannerTest, TestCreateDrivingCorridorExampleInputAndOutput)
   const auto lanelets = std::get<0>(tuple);
   const auto lanelet_connections = std::get<1>(tuple);
 
-  // Initialize MissionPlannerNodeMock
-  rclcpp::NodeOptions options;
-  MissionPlannerNodeMock mission_planner(options);
+  // Initialize the planning core
+  MissionPlannerCore mission_planner;
 
   // Call function which is tested
   const auto driving_corridor = CreateDrivingCorridor({0, 1}, lanelets);
@@ -675,4 +723,991 @@ TEST_F(MissionPlannerTest, TestCreateDrivingCorridorExampleInputAndOutput)
   EXPECT_EQ(driving_corridor.bound_right[0].y, 0.5);
 }
 
+/**
+ * @brief Test the planning core on full inputs and the batch planning on a thread pool.
+ */
+TEST_F(MissionPlannerTest, TestBatchMissionPlanner)
+{
+  // Inputs: lane keeping, left lane change and right lane change with odometry updates
+  std::vector<MissionPlannerInput> inputs(12);
+  for (std::size_t i = 0; i < inputs.size(); i++) {
+    MissionPlannerInput & input = inputs[i];
+    input.local_map.road_segments = CreateSegments();
+    input.local_map.road_segments.header.frame_id = "map";
+
+    autoware_mapless_planning_msgs::msg::Mission mission;
+    if (i % 3 == 1) {
+      mission.mission_type = autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_LEFT;
+      input.missions.push_back(mission);
+    } else if (i % 3 == 2) {
+      mission.mission_type = autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_RIGHT;
+      input.missions.push_back(mission);
+
+      nav_msgs::msg::Odometry odometry;
+      odometry.header.frame_id = "map";
+      odometry.child_frame_id = "base_link";
+      odometry.pose.pose.orientation.w = 1.0;
+      input.odometry.push_back(odometry);
+      odometry.pose.pose.position.x = 0.1 * static_cast<double>(i);
+      input.odometry.push_back(odometry);
+    }
+  }
+
+  // Sequential planning (the state of an input is independent of the previous inputs)
+  MissionPlannerCore core;
+  std::vector<MissionPlannerOutput> expected;
+  for (const MissionPlannerInput & input : inputs) expected.push_back(core.Plan(input));
+
+  // The lanes of the local map are planned without a mission
+  ASSERT_FALSE(expected[0].mission_lanes.ego_lane.centerline.empty());
+  EXPECT_EQ(expected[0].mission_lanes.ego_lane.centerline.front().x, -2.0);
+  EXPECT_EQ(expected[0].mission_lanes.ego_lane.centerline.back().x, 20.0);
+  EXPECT_EQ(expected[0].mission_lanes.target_lane, 0);
+  EXPECT_EQ(expected[0].mission_lanes.header.frame_id, "map");
+  EXPECT_FALSE(expected[0].report.is_local_map_rejected);
+  EXPECT_FALSE(expected[0].report.is_motion_update);
+
+  // The mission is processed before the local map (no lanes yet), the lane change is re-triggered
+  // with the lanes of the local map
+  EXPECT_TRUE(expected[1].report.is_neighbor_lane_empty);
+  EXPECT_EQ(expected[1].state.lane_change_direction, left);
+  EXPECT_TRUE(expected[2].report.is_motion_update);
+  EXPECT_FALSE(expected[2].report.is_odometry_frame_unexpected);
+  EXPECT_EQ(expected[2].state.lane_change_direction, right);
+
+  // The ego and goal lanelets are looked up once per frame (one batched lookup of both points with
+  // fresh trackers), also while a lane change is in progress
+  MissionPlannerInput input_lane_change = inputs[0];
+  input_lane_change.state.mission = left;
+  const MissionPlannerOutput output_lane_change = core.Plan(input_lane_change);
+  EXPECT_EQ(output_lane_change.state.ego_lanelet_tracker.GetLookupCount(), 1u);
+  EXPECT_EQ(output_lane_change.state.goal_lanelet_tracker.GetLookupCount(), 1u);
+
+  // Batch planning yields the same outputs as sequential planning, the frame budget is disabled
+  // for the workers (a budget which is always exceeded would shed the outer lanes of a core)
+  MissionPlannerParameters parameters_batch;
+  parameters_batch.frame_budget_ms = 1e-9;
+  BatchMissionPlanner batch_planner(parameters_batch, 3);
+  EXPECT_EQ(batch_planner.GetThreadCount(), 3u);
+  for (int run = 0; run < 2; run++) {
+    const std::vector<MissionPlannerOutput> outputs = batch_planner.Plan(inputs);
+    ASSERT_EQ(outputs.size(), expected.size());
+
+    for (std::size_t i = 0; i < outputs.size(); i++) {
+      const MissionPlannerOutput & output = outputs[i];
+      EXPECT_FALSE(output.error);
+      EXPECT_EQ(output.mission_lanes.target_lane, expected[i].mission_lanes.target_lane);
+      EXPECT_EQ(
+        output.mission_lanes.drivable_lanes_left.size(),
+        expected[i].mission_lanes.drivable_lanes_left.size());
+      EXPECT_EQ(
+        output.mission_lanes.drivable_lanes_right.size(),
+        expected[i].mission_lanes.drivable_lanes_right.size());
+
+      const auto & centerline = output.mission_lanes.ego_lane.centerline;
+      ASSERT_EQ(centerline.size(), expected[i].mission_lanes.ego_lane.centerline.size());
+      for (std::size_t j = 0; j < centerline.size(); j++) {
+        EXPECT_EQ(centerline[j].x, expected[i].mission_lanes.ego_lane.centerline[j].x);
+        EXPECT_EQ(centerline[j].y, expected[i].mission_lanes.ego_lane.centerline[j].y);
+      }
+
+      EXPECT_EQ(output.state.mission, expected[i].state.mission);
+      EXPECT_EQ(output.state.retry_attempts, expected[i].state.retry_attempts);
+      EXPECT_EQ(output.state.goal_point.x(), expected[i].state.goal_point.x());
+      EXPECT_EQ(output.state.goal_point.y(), expected[i].state.goal_point.y());
+      EXPECT_EQ(output.report.is_motion_update, expected[i].report.is_motion_update);
+    }
+  }
+
+  // An empty batch
+  EXPECT_TRUE(batch_planner.Plan({}).empty());
+}
+
+/**
+ * @brief Test that a mission does not replace an active mission of a higher priority.
+ */
+TEST_F(MissionPlannerTest, TestMissionPriority)
+{
+  using autoware_mapless_planning_msgs::msg::Mission;
+
+  MissionPlannerCore core;
+  autoware_mapless_planning_msgs::msg::LocalMap local_map;
+  local_map.road_segments = CreateSegments();
+  autoware_mapless_planning_msgs::msg::MissionLanesStamped lanes;
+  EXPECT_FALSE(core.ProcessLocalMap(local_map, lanes).is_local_map_rejected);
+
+  // The lane membership table of the frame holds the lane id of each lanelet of the lanes
+  const LaneMembershipTable & lane_membership = core.GetLaneMembership();
+  EXPECT_TRUE(lane_membership.IsBuiltFrom(core.GetState().current_lanelet_connections));
+  for (const int id : core.GetState().ego_lane) EXPECT_EQ(lane_membership.GetLaneId(id), 0);
+  for (const int id : core.GetState().lane_left) EXPECT_EQ(lane_membership.GetLaneId(id), -1);
+  for (const int id : core.GetState().lane_right) EXPECT_EQ(lane_membership.GetLaneId(id), +1);
+
+  // High priority exit
+  Mission mission;
+  mission.mission_type = Mission::TAKE_NEXT_EXIT_LEFT;
+  mission.priority = Mission::PRIORITY_HIGH;
+  EXPECT_FALSE(core.ProcessMission(mission).is_mission_rejected);
+  EXPECT_EQ(core.GetState().target_lane, left_most);
+
+  // A normal priority mission is rejected while the exit is active
+  mission.mission_type = Mission::LANE_KEEP;
+  mission.priority = Mission::PRIORITY_NORMAL;
+  EXPECT_TRUE(core.ProcessMission(mission).is_mission_rejected);
+  EXPECT_EQ(core.GetState().target_lane, left_most);
+
+  // A high priority mission replaces it
+  mission.priority = Mission::PRIORITY_HIGH;
+  EXPECT_FALSE(core.ProcessMission(mission).is_mission_rejected);
+  EXPECT_EQ(core.GetState().target_lane, stay);
+
+  // Without an active mission, missions of any priority are accepted
+  mission.mission_type = Mission::TAKE_NEXT_EXIT_RIGHT;
+  mission.priority = Mission::PRIORITY_NORMAL;
+  EXPECT_FALSE(core.ProcessMission(mission).is_mission_rejected);
+  EXPECT_EQ(core.GetState().target_lane, right_most);
+  EXPECT_EQ(core.GetState().mission_priority, Mission::PRIORITY_NORMAL);
+
+  // Unknown priorities are rejected (also without an active mission)
+  mission.mission_type = Mission::LANE_KEEP;
+  mission.priority = Mission::PRIORITY_HIGH + 1;
+  MissionPlannerReport report = core.ProcessMission(mission);
+  EXPECT_TRUE(report.is_mission_rejected);
+  EXPECT_TRUE(report.is_mission_priority_invalid);
+  EXPECT_EQ(core.GetState().target_lane, right_most);
+  EXPECT_EQ(core.GetState().mission_priority, Mission::PRIORITY_NORMAL);
+
+  core.SetState(MissionPlannerState());
+  mission.priority = 255;
+  EXPECT_TRUE(core.ProcessMission(mission).is_mission_priority_invalid);
+  EXPECT_EQ(core.GetState().mission_priority, Mission::PRIORITY_NORMAL);
+}
+
+/**
+ * @brief Test the single-pass corridor point emitter (point step, filter, several sinks).
+ */
+TEST_F(MissionPlannerTest, TestEmitCorridorPoints)
+{
+  std::vector<geometry_msgs::msg::Point> source(8);
+  for (std::size_t i = 0; i < source.size(); i++) {
+    source[i].x = static_cast<double>(i);
+    source[i].y = 2.0 * static_cast<double>(i);
+    source[i].z = 1.0;
+  }
+
+  // Every third point and the last point
+  std::vector<geometry_msgs::msg::Point> points;
+  EXPECT_EQ(GetCorridorPointCount(source.size(), 3), 4u);
+  EXPECT_EQ(
+    EmitCorridorPoints(source, 3, AcceptAllCorridorPoints(), MakeCorridorSink(points)), 4u);
+  ASSERT_EQ(points.size(), 4u);
+  EXPECT_EQ(points[1].x, 3.0);
+  EXPECT_EQ(points[3].x, 7.0);
+  EXPECT_EQ(points[3].z, 1.0);
+
+  // Planar pose points (initialized from the prototype) with a filter
+  source[2].y = source[1].y;
+  geometry_msgs::msg::PoseStamped prototype;
+  prototype.header.frame_id = "map";
+  std::vector<geometry_msgs::msg::PoseStamped> pose_points;
+  std::vector<geometry_msgs::msg::Point> marker_points;
+  const auto is_accepted = [](const auto & last_point, const auto & point) {
+    return last_point.y != point.y;
+  };
+  EXPECT_EQ(
+    EmitCorridorPoints(
+      source, 1, is_accepted, MakeCorridorSink<false>(pose_points, prototype),
+      MakeCorridorSink<false>(marker_points)),
+    7u);
+  ASSERT_EQ(pose_points.size(), 7u);
+  ASSERT_EQ(marker_points.size(), 7u);
+  EXPECT_EQ(pose_points[2].pose.position.x, 3.0);
+  EXPECT_EQ(pose_points[2].pose.position.z, 0.0);
+  EXPECT_EQ(pose_points[2].header.frame_id, "map");
+  EXPECT_EQ(marker_points[2].x, 3.0);
+  EXPECT_EQ(marker_points[2].z, 0.0);
+}
+
+/**
+ * @brief Test the cropping of the driving corridor to the arc-length horizon.
+ */
+TEST_F(MissionPlannerTest, TestCreateDrivingCorridorHorizon)
+{
+  // Straight lane from x = -2 to x = 20 (two lanelets), the vehicle is at the origin
+  const auto lanelets = std::get<0>(CreateLane());
+  const LaneIndices lane = {0, 1};
+
+  // Unbounded: all points
+  const auto corridor = CreateDrivingCorridor(lane, lanelets);
+  ASSERT_FALSE(corridor.centerline.empty());
+  EXPECT_DOUBLE_EQ(corridor.centerline.front().x, -2.0);
+  EXPECT_DOUBLE_EQ(corridor.centerline.back().x, 20.0);
+
+  // Bounded: the cut points are interpolated
+  CorridorHorizon horizon;
+  horizon.forward = 5.0;
+  horizon.backward = 1.0;
+  const auto cropped = CreateDrivingCorridor(lane, lanelets, 1, horizon);
+  for (const auto & linestring : {cropped.centerline, cropped.bound_left, cropped.bound_right}) {
+    ASSERT_GE(linestring.size(), 2u);
+    EXPECT_NEAR(linestring.front().x, -1.0, 1e-9);
+    EXPECT_NEAR(linestring.back().x, 5.0, 1e-9);
+    for (const auto & point : linestring) {
+      EXPECT_GE(point.x, -1.0 - 1e-9);
+      EXPECT_LE(point.x, 5.0 + 1e-9);
+    }
+  }
+  EXPECT_NEAR(cropped.bound_left.front().y, -0.5, 1e-9);
+  EXPECT_NEAR(cropped.bound_right.back().y, 0.5, 1e-9);
+
+  // Forward horizon in the second lanelet, unbounded backward horizon
+  horizon.forward = 15.0;
+  horizon.backward = -1.0;
+  const auto cropped_forward = CreateDrivingCorridor(lane, lanelets, 1, horizon);
+  ASSERT_FALSE(cropped_forward.centerline.empty());
+  EXPECT_DOUBLE_EQ(cropped_forward.centerline.front().x, -2.0);
+  EXPECT_NEAR(cropped_forward.centerline.back().x, 15.0, 1e-9);
+  EXPECT_LT(cropped_forward.centerline.size(), corridor.centerline.size());
+
+  // Left curve (radius 20 m around (0, 20), lane width 3.5 m, two lanelets), the vehicle is at the
+  // origin: the inner and outer bound end at the same cross-section as the centerline
+  const double radius = 20.0;
+  const double width = 3.5;
+  const int n_points_per_lanelet = 32;
+  const double angle_start = -0.5 * M_PI - 0.2;
+  const double angle_step = 3.2 / (2 * n_points_per_lanelet);
+  std::vector<lanelet::Lanelet> lanelets_curve;
+  for (int k = 0; k < 2; k++) {
+    lanelet::Points3d points_left;
+    lanelet::Points3d points_right;
+    for (int i = 0; i <= n_points_per_lanelet; i++) {
+      const double angle = angle_start + angle_step * (k * n_points_per_lanelet + i);
+      const double r_left = radius - 0.5 * width;
+      const double r_right = radius + 0.5 * width;
+      points_left.emplace_back(
+        lanelet::InvalId, r_left * std::cos(angle), radius + r_left * std::sin(angle), 0.0);
+      points_right.emplace_back(
+        lanelet::InvalId, r_right * std::cos(angle), radius + r_right * std::sin(angle), 0.0);
+    }
+    lanelet::Lanelet lanelet_curve(
+      lanelet::InvalId, lanelet::LineString3d(lanelet::InvalId, points_left),
+      lanelet::LineString3d(lanelet::InvalId, points_right));
+    lanelet_curve.setCenterline(
+      CreatePairedBoundCenterline(lanelet_curve.leftBound(), lanelet_curve.rightBound()));
+    lanelets_curve.push_back(lanelet_curve);
+  }
+
+  horizon.forward = 50.0;
+  horizon.backward = 2.0;
+  const auto cropped_curve = CreateDrivingCorridor(lane, lanelets_curve, 1, horizon);
+  ASSERT_FALSE(cropped_curve.centerline.empty());
+  ASSERT_FALSE(cropped_curve.bound_left.empty());
+  ASSERT_FALSE(cropped_curve.bound_right.empty());
+  const auto get_angle = [radius](const geometry_msgs::msg::Point & point) {
+    return std::atan2(point.y - radius, point.x);
+  };
+
+  // Ends at the horizon along the centerline (the chords are slightly shorter than the arc)
+  EXPECT_NEAR(get_angle(cropped_curve.centerline.front()), -0.5 * M_PI - 2.0 / radius, 1e-3);
+  EXPECT_NEAR(get_angle(cropped_curve.centerline.back()), -0.5 * M_PI + 50.0 / radius, 1e-3);
+  for (const auto & bound : {cropped_curve.bound_left, cropped_curve.bound_right}) {
+    EXPECT_NEAR(get_angle(bound.front()), get_angle(cropped_curve.centerline.front()), 1e-9);
+    EXPECT_NEAR(get_angle(bound.back()), get_angle(cropped_curve.centerline.back()), 1e-9);
+  }
+}
+
+/**
+ * @brief Test the creation of the centerline from the paired bounds.
+ */
+TEST_F(MissionPlannerTest, TestCreatePairedBoundCenterline)
+{
+  // Differently sampled bounds: the centerline has a point at each point of either bound
+  lanelet::LineString3d bound_left(
+    lanelet::InvalId, {lanelet::Point3d(lanelet::InvalId, 0.0, 1.0, 0.0),
+                       lanelet::Point3d(lanelet::InvalId, 2.0, 1.0, 0.0),
+                       lanelet::Point3d(lanelet::InvalId, 10.0, 1.0, 0.0)});
+  lanelet::LineString3d bound_right(
+    lanelet::InvalId, {lanelet::Point3d(lanelet::InvalId, 0.0, -1.0, 1.0),
+                       lanelet::Point3d(lanelet::InvalId, 8.0, -1.0, 1.0),
+                       lanelet::Point3d(lanelet::InvalId, 10.0, -1.0, 1.0)});
+  lanelet::LineString3d centerline = CreatePairedBoundCenterline(bound_left, bound_right);
+  ASSERT_EQ(centerline.size(), 4u);
+  const std::vector<double> x_expected = {0.0, 2.0, 8.0, 10.0};
+  for (std::size_t i = 0; i < centerline.size(); i++) {
+    EXPECT_NEAR(centerline[i].x(), x_expected[i], 1e-9);
+    EXPECT_NEAR(centerline[i].y(), 0.0, 1e-9);
+    EXPECT_NEAR(centerline[i].z(), 0.5, 1e-9);
+  }
+
+  // Bounds of different length are paired by the normalized arc length
+  bound_right = lanelet::LineString3d(
+    lanelet::InvalId, {lanelet::Point3d(lanelet::InvalId, 0.0, -1.0, 0.0),
+                       lanelet::Point3d(lanelet::InvalId, 20.0, -1.0, 0.0)});
+  centerline = CreatePairedBoundCenterline(bound_left, bound_right);
+  ASSERT_EQ(centerline.size(), 3u);
+  EXPECT_NEAR(centerline[1].x(), 0.5 * (2.0 + 4.0), 1e-9);
+  EXPECT_NEAR(centerline[2].x(), 15.0, 1e-9);
+
+  // The lanelets of the local map use it as their centerline
+  const auto lanelets = std::get<0>(CreateLane());
+  ASSERT_FALSE(lanelets.empty());
+  EXPECT_TRUE(lanelets[0].hasCustomCenterline());
+  EXPECT_NEAR(lanelets[0].centerline().front().x(), -2.0, 1e-9);
+  EXPECT_NEAR(lanelets[0].centerline().front().y(), 0.0, 1e-9);
+
+  EXPECT_TRUE(CreatePairedBoundCenterline(bound_left, lanelet::LineString3d()).empty());
+}
+
+/**
+ * @brief Test the error-bounded simplification of polylines.
+ */
+TEST_F(MissionPlannerTest, TestPolylineSimplifier)
+{
+  // Densely sampled boundary: straight line, then a quarter circle with radius 10 m
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (int i = 0; i <= 100; i++) {
+    geometry_msgs::msg::Pose pose;
+    pose.position.x = -20.0 + 0.2 * i;
+    pose.position.y = 10.0;
+    poses.push_back(pose);
+  }
+  for (int i = 1; i <= 100; i++) {
+    const double angle = M_PI / 2.0 * (1.0 - i / 100.0);
+    geometry_msgs::msg::Pose pose;
+    pose.position.x = 10.0 * std::cos(angle);
+    pose.position.y = 10.0 * std::sin(angle);
+    pose.position.z = 1.0;
+    poses.push_back(pose);
+  }
+  const std::vector<geometry_msgs::msg::Pose> original = poses;
+
+  // Largest distance of an original point to the simplified polyline
+  const auto max_distance = [](
+                              const std::vector<geometry_msgs::msg::Pose> & simplified,
+                              const std::vector<geometry_msgs::msg::Pose> & points) {
+    double distance_max = 0.0;
+    for (const auto & point : points) {
+      double distance_min = std::numeric_limits<double>::max();
+      for (std::size_t i = 0; i + 1 < simplified.size(); i++) {
+        const double x0 = simplified[i].position.x;
+        const double y0 = simplified[i].position.y;
+        const double dx = simplified[i + 1].position.x - x0;
+        const double dy = simplified[i + 1].position.y - y0;
+        const double t = std::clamp(
+          ((point.position.x - x0) * dx + (point.position.y - y0) * dy) / (dx * dx + dy * dy), 0.0,
+          1.0);
+        distance_min = std::min(
+          distance_min,
+          std::hypot(point.position.x - x0 - t * dx, point.position.y - y0 - t * dy));
+      }
+      distance_max = std::max(distance_max, distance_min);
+    }
+    return distance_max;
+  };
+
+  const double max_lateral_error = 0.05;
+  PolylineSimplifier simplifier;
+  const std::size_t n_removed = simplifier.Simplify(poses, max_lateral_error);
+  EXPECT_EQ(n_removed + poses.size(), original.size());
+  EXPECT_LT(poses.size(), 20u);
+  EXPECT_EQ(poses.front().position.x, original.front().position.x);
+  EXPECT_EQ(poses.back().position.x, original.back().position.x);
+  EXPECT_EQ(poses.back().position.z, 1.0);
+
+  // Every original point is within the maximum lateral error of the simplified polyline
+  EXPECT_LE(max_distance(poses, original), max_lateral_error + 1e-9);
+  EXPECT_NEAR(
+    simplifier.GetReductionRatio(),
+    static_cast<double>(n_removed) / static_cast<double>(original.size()), 1e-12);
+
+  // Short polylines and a disabled simplification are unchanged
+  std::vector<geometry_msgs::msg::Pose> segment(original.begin(), original.begin() + 2);
+  EXPECT_EQ(simplifier.Simplify(segment, max_lateral_error), 0u);
+  poses = original;
+  EXPECT_EQ(simplifier.Simplify(poses, 0.0), 0u);
+  EXPECT_EQ(poses.size(), original.size());
+
+  // Degenerate zig-zag whose farthest point is always next to the start of a range (the long
+  // ranges are checked with the hull tree), the error bound holds as well
+  std::vector<geometry_msgs::msg::Pose> zigzag(2000);
+  for (std::size_t i = 0; i < zigzag.size(); i++) {
+    const double amplitude = 1e-5 * std::pow(static_cast<double>(zigzag.size() - i), 2.0);
+    zigzag[i].position.x = 0.1 * static_cast<double>(i);
+    zigzag[i].position.y = i % 2 == 0 ? amplitude : -amplitude;
+  }
+  poses = zigzag;
+  EXPECT_GT(simplifier.Simplify(poses, max_lateral_error), 0u);
+  EXPECT_LE(max_distance(poses, zigzag), max_lateral_error + 1e-9);
+}
+
+/**
+ * @brief Test GetPsiForPoints() function (array of points and separate x/y arrays).
+ */
+TEST_F(MissionPlannerTest, TestGetPsiForPointsExampleInputAndOutput)
+{
+  // Create points on a circle (heading covers the full range of angles)
+  const size_t num_points = 73;
+  std::vector<geometry_msgs::msg::Point> points(num_points);
+  std::vector<double> x(num_points), y(num_points);
+  for (size_t i = 0; i < num_points; i++) {
+    const double angle = 2.0 * M_PI * static_cast<double>(i) / (num_points - 1);
+    points[i].x = 10.0 * std::cos(angle);
+    points[i].y = 10.0 * std::sin(angle);
+    x[i] = points[i].x;
+    y[i] = points[i].y;
+  }
+
+  // Call functions which are tested
+  const std::vector<double> psi_aos = GetPsiForPoints(points);
+  std::vector<double> psi_soa(num_points);
+  GetPsiForPoints(x.data(), y.data(), num_points, psi_soa.data());
+
+  for (size_t i = 0; i < num_points; i++) {
+    // Reference heading from the neighboring points
+    const size_t i_prev = (i == 0) ? 0 : i - 1;
+    const size_t i_next = (i == num_points - 1) ? num_points - 1 : i + 1;
+    const double psi_ref = NormalizePsi(std::atan2(y[i_next] - y[i_prev], x[i_next] - x[i_prev]));
+
+    // Both variants give the same result, errors at the wrap-around (+/- pi) are ignored
+    EXPECT_EQ(psi_aos[i], psi_soa[i]);
+    EXPECT_NEAR(NormalizePsi(psi_soa[i] - psi_ref), 0.0, kFastAtan2MaxError);
+
+    // Output is restricted to [-pi, pi[
+    EXPECT_GE(psi_soa[i], -M_PI);
+    EXPECT_LT(psi_soa[i], M_PI);
+  }
+
+  // Axis-aligned directions and degenerate input
+  EXPECT_EQ(FastAtan2(0.0, 0.0), 0.0);
+  EXPECT_NEAR(FastAtan2(1.0, 0.0), M_PI_2, kFastAtan2MaxError);
+  EXPECT_NEAR(FastAtan2(-1.0, 0.0), -M_PI_2, kFastAtan2MaxError);
+  EXPECT_NEAR(FastAtan2(0.0, -1.0), M_PI, kFastAtan2MaxError);
+}
+
+/**
+ * @brief Test LaneIndices (SmallVector) insertion at both ends and growth beyond the inline
+ * capacity.
+ */
+TEST_F(MissionPlannerTest, TestLaneIndicesExampleInputAndOutput)
+{
+  LaneIndices lane = {2, 3};
+  lane.push_front(1);
+  lane.push_back(4);
+
+  EXPECT_EQ(lane, (LaneIndices{1, 2, 3, 4}));
+  EXPECT_EQ(lane.is_inline(), true);
+
+  // Exceed the inline capacity (elements move to the heap) in both directions
+  LaneIndices long_lane;
+  const int n = 3 * static_cast<int>(kLaneIndicesInlineCapacity);
+  for (int i = 0; i < n; i++) {
+    if (i % 2 == 0) {
+      long_lane.push_back(i);
+    } else {
+      long_lane.push_front(-i);
+    }
+  }
+  EXPECT_EQ(long_lane.is_inline(), false);
+  EXPECT_EQ(long_lane.size(), static_cast<size_t>(n));
+  EXPECT_EQ(long_lane.front(), -(n - 1));
+  EXPECT_EQ(long_lane.back(), n - 2);
+
+  // Moving a heap-allocated list keeps the elements, the source is empty afterwards
+  const LaneIndices long_lane_copy = long_lane;
+  const LaneIndices moved_lane = std::move(long_lane);
+  EXPECT_EQ(moved_lane, long_lane_copy);
+  EXPECT_EQ(long_lane.empty(), true);
+}
+
+/**
+ * @brief Test the shedding of optional work by FrameBudget.
+ */
+TEST_F(MissionPlannerTest, TestFrameBudgetShedding)
+{
+  FrameBudget frame_budget(10.0);
+  frame_budget.UpdateEstimate(kCoreCorridors, 2.0);
+  frame_budget.UpdateEstimate(kOuterCorridors, 3.0);
+  frame_budget.UpdateEstimate(kCorridorVisualization, 4.0);
+
+  // Enough time left for all the work (9 ms)
+  frame_budget.PlanOptionalWork(1.0);
+  EXPECT_EQ(frame_budget.HasShedWork(), false);
+
+  // Shed the visualization first
+  frame_budget.PlanOptionalWork(5.0);
+  EXPECT_EQ(frame_budget.IsShed(kVisualization), true);
+  EXPECT_EQ(frame_budget.IsShed(kOuterLanes), false);
+  EXPECT_EQ(frame_budget.IsShed(kCorridorDensity), false);
+
+  // Then the outer lanes
+  frame_budget.PlanOptionalWork(7.0);
+  EXPECT_EQ(frame_budget.IsShed(kOuterLanes), true);
+  EXPECT_EQ(frame_budget.IsShed(kCorridorDensity), false);
+  EXPECT_EQ(frame_budget.GetShedReport(), "visualization, outer lanes");
+
+  // And finally the corridor density
+  frame_budget.PlanOptionalWork(9.0);
+  EXPECT_EQ(frame_budget.IsShed(kCorridorDensity), true);
+  EXPECT_EQ(frame_budget.GetShedCount(kVisualization), 3u);
+  EXPECT_EQ(frame_budget.GetShedCount(kCorridorDensity), 1u);
+
+  // Moving average of the runtime estimates
+  frame_budget.UpdateEstimate(kCoreCorridors, 7.0);
+  EXPECT_NEAR(frame_budget.GetEstimate(kCoreCorridors), 3.0, 1e-9);
+
+  // A disabled budget never sheds work
+  frame_budget.SetBudget(0.0);
+  frame_budget.PlanOptionalWork(100.0);
+  EXPECT_EQ(frame_budget.HasShedWork(), false);
+}
+
+/**
+ * @brief Test the validation and normalization of the lanelet connections.
+ */
+TEST_F(MissionPlannerTest, TestNormalizeLaneletConnections)
+{
+  // Original ids 10 -> 20 -> 30, 40 is the left neighbor of 10, the references to 99 are dangling
+  std::vector<LaneletConnection> lanelet_connections(4);
+  lanelet_connections[0].original_lanelet_id = 10;
+  lanelet_connections[0].successor_lanelet_ids = {99, 20};
+  lanelet_connections[0].neighbor_lanelet_ids = {40};
+  lanelet_connections[1].original_lanelet_id = 20;
+  lanelet_connections[1].successor_lanelet_ids = {30};
+  lanelet_connections[1].neighbor_lanelet_ids = {20, -1};
+  lanelet_connections[2].original_lanelet_id = 30;
+  lanelet_connections[3].original_lanelet_id = 40;
+  lanelet_connections[3].neighbor_lanelet_ids = {-1, 10};
+
+  LaneletGraphReport report = NormalizeLaneletConnections(lanelet_connections);
+
+  EXPECT_TRUE(report.IsValid());
+  EXPECT_EQ(report.n_dangling_references, 1u);
+  EXPECT_EQ(report.n_self_references, 1u);
+  EXPECT_EQ(report.n_filled_neighbor_slots, 3u);
+  EXPECT_EQ(report.n_successor_cycles, 0u);
+
+  EXPECT_EQ(lanelet_connections[0].successor_lanelet_ids, LaneIndices({1}));
+  EXPECT_EQ(lanelet_connections[0].neighbor_lanelet_ids, LaneIndices({3, -1}));
+  EXPECT_EQ(lanelet_connections[1].neighbor_lanelet_ids, LaneIndices({-1, -1}));
+  EXPECT_EQ(lanelet_connections[2].successor_lanelet_ids, LaneIndices({-1}));
+  EXPECT_EQ(lanelet_connections[3].neighbor_lanelet_ids, LaneIndices({-1, 0}));
+  EXPECT_EQ(lanelet_connections[0].predecessor_lanelet_ids, LaneIndices({-1}));
+  EXPECT_EQ(lanelet_connections[2].predecessor_lanelet_ids, LaneIndices({1}));
+
+  // Successor cycles are reported, but valid
+  for (std::size_t i = 0; i < lanelet_connections.size(); i++) {
+    lanelet_connections[i].successor_lanelet_ids = {};
+    lanelet_connections[i].neighbor_lanelet_ids = {};
+  }
+  lanelet_connections[0].successor_lanelet_ids = {20};
+  lanelet_connections[1].successor_lanelet_ids = {30};
+  lanelet_connections[2].successor_lanelet_ids = {10};
+  report = NormalizeLaneletConnections(lanelet_connections);
+  EXPECT_TRUE(report.IsValid());
+  EXPECT_EQ(report.n_successor_cycles, 1u);
+
+  // Neighbor cycles are malformed
+  lanelet_connections[0].neighbor_lanelet_ids = {20, -1};
+  lanelet_connections[1].neighbor_lanelet_ids = {10, -1};
+  report = NormalizeLaneletConnections(lanelet_connections);
+  EXPECT_FALSE(report.IsValid());
+  EXPECT_EQ(report.n_neighbor_cycles, 1u);
+
+  // Duplicate ids are malformed
+  lanelet_connections[0].neighbor_lanelet_ids = {};
+  lanelet_connections[1].neighbor_lanelet_ids = {};
+  lanelet_connections[3].original_lanelet_id = 10;
+  report = NormalizeLaneletConnections(lanelet_connections);
+  EXPECT_FALSE(report.IsValid());
+  EXPECT_EQ(report.n_duplicate_ids, 1u);
+}
+
+/**
+ * @brief Test that malformed local maps are rejected by ConvertInput2LaneletFormat().
+ */
+TEST_F(MissionPlannerTest, TestConvertInput2LaneletFormatRejectsMalformedInput)
+{
+  MissionPlannerCore mission_planner;
+
+  std::vector<LaneletConnection> lanelet_connections;
+  std::vector<lanelet::Lanelet> lanelets;
+
+  // Valid input
+  auto road_segments = CreateSegments();
+  EXPECT_TRUE(
+    mission_planner.ConvertInput2LaneletFormat(road_segments, lanelets, lanelet_connections)
+      .IsValid());
+  EXPECT_EQ(lanelets.size(), road_segments.segments.size());
+  for (const LaneletConnection & lanelet_connection : lanelet_connections) {
+    EXPECT_GE(lanelet_connection.neighbor_lanelet_ids.size(), 2u);
+    EXPECT_FALSE(lanelet_connection.predecessor_lanelet_ids.empty());
+  }
+
+  // Duplicate segment id: no lanelets are created
+  road_segments.segments[1].id = road_segments.segments[0].id;
+  EXPECT_FALSE(
+    mission_planner.ConvertInput2LaneletFormat(road_segments, lanelets, lanelet_connections)
+      .IsValid());
+  EXPECT_TRUE(lanelets.empty());
+}
+
+/**
+ * @brief Test the lane membership table (predecessor closure).
+ */
+TEST_F(MissionPlannerTest, TestLaneMembershipTable)
+{
+  // Diamond 0 -> {1, 2} -> 3 -> 4 and the cycle 5 -> 6 -> 5 with the exit 6 -> 7
+  std::vector<LaneletConnection> lanelet_connections(8);
+  const std::vector<LaneIndices> successors = {{1, 2}, {3}, {3}, {4}, {}, {6}, {5, 7}, {}};
+  for (std::size_t i = 0; i < lanelet_connections.size(); i++) {
+    lanelet_connections[i].original_lanelet_id = static_cast<int>(i);
+    lanelet_connections[i].successor_lanelet_ids = successors[i];
+  }
+  ASSERT_TRUE(NormalizeLaneletConnections(lanelet_connections).IsValid());
+
+  LaneMembershipTable table;
+  table.Build(lanelet_connections);
+  EXPECT_EQ(table.GetSize(), 8u);
+
+  for (int id = 0; id <= 4; id++) EXPECT_TRUE(table.IsOnLaneTo(id, 4));
+  EXPECT_TRUE(table.IsOnLaneTo(1, 3));
+  EXPECT_FALSE(table.IsOnLaneTo(1, 2));
+  EXPECT_FALSE(table.IsOnLaneTo(4, 3));
+  EXPECT_FALSE(table.IsOnLaneTo(5, 4));
+
+  // Cycle
+  EXPECT_TRUE(table.IsOnLaneTo(6, 5));
+  EXPECT_TRUE(table.IsOnLaneTo(5, 6));
+  EXPECT_TRUE(table.IsOnLaneTo(5, 7));
+  EXPECT_FALSE(table.IsOnLaneTo(7, 6));
+
+  // Invalid indices
+  EXPECT_FALSE(table.IsOnLaneTo(-1, 4));
+  EXPECT_FALSE(table.IsOnLaneTo(0, 8));
+
+  // The single query (search of the predecessors) equals the table
+  for (int id = -1; id <= 8; id++) {
+    for (int id_target = -1; id_target <= 8; id_target++) {
+      EXPECT_EQ(IsOnLaneTo(lanelet_connections, id, id_target), table.IsOnLaneTo(id, id_target));
+    }
+  }
+
+  // Lane ids (the first assigned lane wins, invalid indices are ignored)
+  EXPECT_TRUE(table.IsBuiltFrom(lanelet_connections));
+  EXPECT_EQ(table.GetLaneId(0), LaneMembershipTable::kNoLane);
+  table.SetLaneId({0, 1, 3, 4}, 0);
+  table.SetLaneId({2, 3, -1, 8}, -1);
+  table.SetLaneId({5, 6}, +1);
+  EXPECT_EQ(table.GetLaneId(3), 0);
+  EXPECT_EQ(table.GetLaneId(2), -1);
+  EXPECT_EQ(table.GetLaneId(6), +1);
+  EXPECT_EQ(table.GetLaneId(7), LaneMembershipTable::kNoLane);
+  EXPECT_EQ(table.GetLaneId(8), LaneMembershipTable::kNoLane);
+
+  // Rebuild with a smaller graph (reused memory)
+  lanelet_connections.resize(2);
+  lanelet_connections[0].successor_lanelet_ids = {1};
+  lanelet_connections[1].successor_lanelet_ids = {};
+  ASSERT_TRUE(NormalizeLaneletConnections(lanelet_connections).IsValid());
+  EXPECT_FALSE(table.IsBuiltFrom(lanelet_connections));
+  table.Build(lanelet_connections);
+  EXPECT_EQ(table.GetLaneId(0), LaneMembershipTable::kNoLane);
+  EXPECT_TRUE(table.IsOnLaneTo(0, 1));
+  EXPECT_FALSE(table.IsOnLaneTo(1, 0));
+  EXPECT_FALSE(table.IsOnLaneTo(0, 4));
+}
+
+/**
+ * @brief Test the lanelet polygon table against lanelet::geometry::inside().
+ */
+TEST_F(MissionPlannerTest, TestLaneletPolygonTable)
+{
+  auto lanelets = std::get<0>(CreateLane());
+
+  // Add a curved (non-convex) lanelet
+  lanelet::LineString3d left_bound(0);
+  lanelet::LineString3d right_bound(0);
+  for (int i = 0; i <= 20; i++) {
+    const double x = 20.0 + i;
+    const double y = 3.0 + 2.0 * std::sin(0.3 * i);
+    left_bound.push_back(lanelet::Point3d(0, x, y + 1.0, 0.0));
+    right_bound.push_back(lanelet::Point3d(0, x, y - 1.0, 0.0));
+  }
+  lanelets.push_back(lanelet::Lanelet(0, left_bound, right_bound));
+
+  LaneletPolygonTable table;
+  table.Build(lanelets);
+  ASSERT_EQ(table.GetSize(), lanelets.size());
+  EXPECT_TRUE(table.IsBuiltFrom(lanelets));
+  EXPECT_FALSE(table.IsBuiltFrom(std::get<0>(CreateLane())));
+
+  // Grid of points (off the boundaries), single and batched queries
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 200; i++) {
+    for (int j = 0; j < 40; j++) {
+      x.push_back(-5.013 + 0.25 * i);
+      y.push_back(-3.007 + 0.25 * j);
+    }
+  }
+  std::vector<std::uint8_t> is_inside(x.size());
+  std::size_t n_inside = 0;
+  for (std::size_t id = 0; id < lanelets.size(); id++) {
+    table.Contains(static_cast<int>(id), x.data(), y.data(), x.size(), is_inside.data());
+    for (std::size_t i = 0; i < x.size(); i++) {
+      const bool is_inside_expected =
+        lanelet::geometry::inside(lanelets[id], lanelet::BasicPoint2d(x[i], y[i]));
+      EXPECT_EQ(table.Contains(static_cast<int>(id), x[i], y[i]), is_inside_expected);
+      EXPECT_EQ(is_inside[i] != 0, is_inside_expected);
+      n_inside += is_inside_expected ? 1 : 0;
+    }
+  }
+  EXPECT_GT(n_inside, 0u);
+
+  // Same result as the linear scan over the lanelets, for single and batched queries (the output
+  // vector is resized)
+  std::vector<int> ids = {42};
+  table.FindContainingPolygons(x.data(), y.data(), x.size(), ids);
+  ASSERT_EQ(ids.size(), x.size());
+  for (std::size_t i = 0; i < x.size(); i++) {
+    EXPECT_EQ(
+      table.FindContainingPolygon(x[i], y[i]),
+      FindOccupiedLaneletID(lanelets, lanelet::BasicPoint2d(x[i], y[i])));
+    EXPECT_EQ(ids[i], table.FindContainingPolygon(x[i], y[i]));
+  }
+  table.FindContainingPolygons(x.data(), y.data(), 0, ids);
+  EXPECT_TRUE(ids.empty());
+
+  EXPECT_EQ(table.FindContainingPolygon(0.0, 0.0), 0);
+  EXPECT_EQ(table.FindContainingPolygon(15.0, 0.0), 1);
+  EXPECT_EQ(table.FindContainingPolygon(30.0, 3.0 + 2.0 * std::sin(3.0)), 2);
+  EXPECT_EQ(table.FindContainingPolygon(100.0, 100.0), -1);
+
+  // The sign of a zero does not change the result (the test uses the sign bits of differences)
+  EXPECT_EQ(table.FindContainingPolygon(-0.0, -0.0), table.FindContainingPolygon(0.0, 0.0));
+}
+
+/**
+ * @brief Test the temporal-coherence hint of the occupied lanelet lookup.
+ */
+TEST_F(MissionPlannerTest, TestOccupiedLaneletTracker)
+{
+  const auto tuple = CreateLane();
+  const auto & lanelets = std::get<0>(tuple);
+  const auto & lanelet_connections = std::get<1>(tuple);
+
+  LaneletPolygonTable table;
+  table.Build(lanelets);
+  OccupiedLaneletTracker tracker;
+
+  // First lookup: search
+  EXPECT_EQ(tracker.Find(table, lanelet_connections, lanelet::BasicPoint2d(0.0, 0.0)), 0);
+  EXPECT_EQ(tracker.GetHitCount(), 0u);
+
+  // Same lanelet, then its successor
+  EXPECT_EQ(tracker.Find(table, lanelet_connections, lanelet::BasicPoint2d(5.0, 0.1)), 0);
+  EXPECT_EQ(tracker.Find(table, lanelet_connections, lanelet::BasicPoint2d(12.0, 0.0)), 1);
+  EXPECT_EQ(tracker.GetHitCount(), 2u);
+
+  // The next frame (new lanelets, same segment ids): the lanelet is found by its original id
+  const auto tuple_next = CreateLane();
+  table.Build(std::get<0>(tuple_next));
+  EXPECT_EQ(tracker.Find(table, std::get<1>(tuple_next), lanelet::BasicPoint2d(15.0, 0.0)), 1);
+  EXPECT_EQ(tracker.GetHitCount(), 3u);
+
+  // Back to a predecessor (not adjacent): search
+  EXPECT_EQ(tracker.Find(table, std::get<1>(tuple_next), lanelet::BasicPoint2d(1.0, 0.0)), 0);
+  EXPECT_EQ(tracker.GetHitCount(), 3u);
+
+  // Outside of all lanelets
+  EXPECT_EQ(tracker.Find(table, std::get<1>(tuple_next), lanelet::BasicPoint2d(100.0, 0.0)), -1);
+  EXPECT_EQ(tracker.GetLookupCount(), 6u);
+  EXPECT_DOUBLE_EQ(tracker.GetHitRate(), 0.5);
+}
+
+/**
+ * @brief Test the bounded best-first enumeration of the successor branches.
+ */
+TEST_F(MissionPlannerTest, TestLaneBranchEnumerator)
+{
+  // 0 -> {1, 2}, 1 -> 3, 2 -> {3, 4}, 4 -> 0 (cycle), 3 has no successor
+  std::vector<LaneletConnection> lanelet_connections(5);
+  lanelet_connections[0].successor_lanelet_ids = {1, 2};
+  lanelet_connections[1].successor_lanelet_ids = {3};
+  lanelet_connections[2].successor_lanelet_ids = {3, 4};
+  lanelet_connections[3].successor_lanelet_ids = {-1};
+  lanelet_connections[4].successor_lanelet_ids = {0};
+
+  // Transitions to lanelet 2 are cheapest, transitions to lanelet 4 are most expensive
+  const auto transition_cost = [](const int, const int to) {
+    return to == 2 ? 0.1 : (to == 4 ? 0.5 : 0.2);
+  };
+
+  LaneBranchBudget budget;
+  std::vector<LaneIndices> branches =
+    GetBestSuccessorSequences(lanelet_connections, 0, budget, transition_cost);
+
+  // Ordered by cost, the cycle back to lanelet 0 is not followed
+  ASSERT_EQ(branches.size(), 3u);
+  EXPECT_EQ(branches[0], LaneIndices({0, 2, 3}));
+  EXPECT_EQ(branches[1], LaneIndices({0, 1, 3}));
+  EXPECT_EQ(branches[2], LaneIndices({0, 2, 4}));
+
+  // Branch budget
+  budget.max_branches = 2;
+  branches = GetBestSuccessorSequences(lanelet_connections, 0, budget, transition_cost);
+  EXPECT_EQ(branches.size(), 2u);
+
+  // Depth budget: the sequences are truncated
+  budget.max_branches = 4;
+  budget.max_depth = 2;
+  branches = GetBestSuccessorSequences(lanelet_connections, 0, budget, transition_cost);
+  ASSERT_EQ(branches.size(), 2u);
+  EXPECT_EQ(branches[0], LaneIndices({0, 2}));
+  EXPECT_EQ(branches[1], LaneIndices({0, 1}));
+
+  // The number of expansions is bounded on a graph whose number of branches grows exponentially
+  const int num_layers = 40;
+  std::vector<LaneletConnection> diamonds(2 * num_layers);
+  for (int i = 0; i < num_layers - 1; i++) {
+    diamonds[2 * i].successor_lanelet_ids = {2 * i + 2, 2 * i + 3};
+    diamonds[2 * i + 1].successor_lanelet_ids = {2 * i + 2, 2 * i + 3};
+  }
+  diamonds[2 * num_layers - 2].successor_lanelet_ids = {-1};
+  diamonds[2 * num_layers - 1].successor_lanelet_ids = {-1};
+
+  budget = LaneBranchBudget();
+  budget.max_depth = 2 * num_layers;
+  LaneBranchEnumerator enumerator(diamonds, 0, budget, [](const int, const int) { return 1.0; });
+  LaneIndices branch;
+  int num_branches = 0;
+  while (enumerator.Next(branch)) num_branches++;
+  EXPECT_EQ(num_branches, budget.max_branches);
+  EXPECT_LE(enumerator.GetExpansionCount(), 4u * budget.max_branches * budget.max_depth);
+}
+
+/**
+ * @brief Test the aggregation of the stage statistics by StageProfiler.
+ */
+TEST_F(MissionPlannerTest, TestStageProfilerStatistics)
+{
+  StageProfiler profiler;
+  profiler.Record(kStageLaneCalculation, 2000000, 3);
+  profiler.Record(kStageLaneCalculation, 1000000, 1);
+
+  const StageStatistics statistics = profiler.GetStatistics(kStageLaneCalculation);
+  EXPECT_EQ(statistics.calls, 2u);
+  EXPECT_NEAR(statistics.total_ms, 3.0, 1e-9);
+  EXPECT_NEAR(statistics.max_ms, 2.0, 1e-9);
+  EXPECT_EQ(statistics.allocations, 4u);
+
+  // Other stages are not affected
+  EXPECT_EQ(profiler.GetStatistics(kStageConversion).calls, 0u);
+
+  // The scoped timer records one call
+  {
+    const ScopedStageTimer timer(profiler, kStageConversion);
+  }
+  EXPECT_EQ(profiler.GetStatistics(kStageConversion).calls, 1u);
+
+  profiler.Reset();
+  EXPECT_EQ(profiler.GetStatistics(kStageLaneCalculation).calls, 0u);
+}
+
+/**
+ * @brief Get the trace events of a category which were recorded since a time (the recorder is
+ * shared by all tests of the process).
+ */
+std::vector<TraceEvent> GetTraceEventsSince(
+  const char * category, const std::uint64_t start_timestamp_ns)
+{
+  std::vector<TraceEvent> events = TraceRecorder::Instance().Snapshot();
+  events.erase(
+    std::remove_if(
+      events.begin(), events.end(),
+      [&](const TraceEvent & event) {
+        return std::strcmp(event.category, category) != 0 ||
+               event.timestamp_ns < start_timestamp_ns;
+      }),
+    events.end());
+  return events;
+}
+
+std::uint64_t GetTraceTimestampNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+/**
+ * @brief Test the recording of trace events by TraceRecorder.
+ */
+TEST_F(MissionPlannerTest, TestTraceRecorderEvents)
+{
+  TraceRecorder & recorder = TraceRecorder::Instance();
+  const std::uint64_t start_timestamp_ns = GetTraceTimestampNs();
+
+  // Nothing is recorded while tracing is disabled
+  recorder.SetEnabled(false);
+  {
+    MAPLESS_TRACE_SCOPE("test", "disabled scope");
+  }
+  EXPECT_TRUE(GetTraceEventsSince("test", start_timestamp_ns).empty());
+
+  recorder.SetEnabled(true);
+  {
+    MAPLESS_TRACE_SCOPE("test", "outer scope");
+    MAPLESS_TRACE_SCOPE("test", "inner scope");
+  }
+  recorder.SetEnabled(false);
+
+  // A snapshot does not remove the events (e.g. the trace dumps of several nodes)
+  EXPECT_EQ(GetTraceEventsSince("test", start_timestamp_ns).size(), 4u);
+
+  // Scopes are closed in reverse order
+  const std::vector<TraceEvent> events = GetTraceEventsSince("test", start_timestamp_ns);
+  ASSERT_EQ(events.size(), 4u);
+  EXPECT_STREQ(events[0].name, "outer scope");
+  EXPECT_EQ(events[0].phase, 'B');
+  EXPECT_STREQ(events[1].name, "inner scope");
+  EXPECT_EQ(events[1].phase, 'B');
+  EXPECT_STREQ(events[2].name, "inner scope");
+  EXPECT_EQ(events[2].phase, 'E');
+  EXPECT_STREQ(events[3].name, "outer scope");
+  EXPECT_EQ(events[3].phase, 'E');
+  EXPECT_LE(events[0].timestamp_ns, events[3].timestamp_ns);
+  EXPECT_EQ(events[0].thread_id, events[3].thread_id);
+}
+
+/**
+ * @brief Test that TraceRecorder only keeps the ring buffers of the latest exited threads.
+ */
+TEST_F(MissionPlannerTest, TestTraceRecorderExitedThreads)
+{
+  TraceRecorder & recorder = TraceRecorder::Instance();
+  const std::uint64_t start_timestamp_ns = GetTraceTimestampNs();
+  const std::uint64_t n_overwritten_before = recorder.GetOverwrittenEventCount();
+
+  // Short-lived threads (e.g. the workers of a batch)
+  const std::size_t n_threads = TraceRecorder::kMaxFinishedThreadRings + 2;
+  recorder.SetEnabled(true);
+  for (std::size_t i = 0; i < n_threads; i++) {
+    std::thread worker([]() { MAPLESS_TRACE_SCOPE("test thread", "worker scope"); });
+    worker.join();
+  }
+  recorder.SetEnabled(false);
+
+  // The events of the latest exited threads are kept, the rings of the older ones are released
+  const std::vector<TraceEvent> events = GetTraceEventsSince("test thread", start_timestamp_ns);
+  EXPECT_EQ(events.size(), 2 * TraceRecorder::kMaxFinishedThreadRings);
+
+  std::set<std::uint32_t> thread_ids;
+  for (const TraceEvent & event : events) thread_ids.insert(event.thread_id);
+  EXPECT_EQ(thread_ids.size(), TraceRecorder::kMaxFinishedThreadRings);
+
+  // The events of the released rings are counted as overwritten
+  EXPECT_GE(recorder.GetOverwrittenEventCount() - n_overwritten_before, 4u);
+}
+
 }  // namespace autoware::mapless_architecture
@@ -0,0 +1,322 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner/mission_planner_core.hpp"
+#include "autoware/local_mission_planner_common/helper_functions.hpp"
+#include "autoware/local_mission_planner_common/polyline_simplifier.hpp"
+#include "gtest/gtest.h"
+
+#include "autoware_mapless_planning_msgs/msg/road_segments.hpp"
+#include "geometry_msgs/msg/pose.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Maximum growth exponent of the runtime (1 is linear, 2 is quadratic), see CMakeLists.txt
+#ifndef MAPLESS_SCALING_MAX_EXPONENT
+#define MAPLESS_SCALING_MAX_EXPONENT 1.5
+#endif
+
+namespace autoware::mapless_architecture
+{
+/**
+ * @brief The fixture for the asymptotic scaling tests of the lanelet graph functions (and of the
+ * polyline simplification).
+ *
+ * The functions are run on synthetic lanelet graphs of doubling size, the growth exponent of the
+ * runtime is fitted (least squares on the log-log data) and must not exceed the configured bound,
+ * i.e. accidental quadratic behavior (e.g. searches in visited lists) fails the test.
+ */
+class ScalingTest : public testing::Test
+{
+protected:
+  /**
+   * @brief Measure the runtime of a function in seconds (median of several trials, each trial
+   * repeats the function for at least a few milliseconds).
+   */
+  static double MeasureSeconds(const std::function<void()> & function)
+  {
+    const int n_trials = 5;
+    const double min_trial_duration = 0.005;
+
+    std::vector<double> runtimes;
+    for (int trial = 0; trial < n_trials; trial++) {
+      int n_calls = 0;
+      double duration = 0.0;
+      const auto t_start = std::chrono::steady_clock::now();
+      do {
+        function();
+        n_calls++;
+        duration =
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+      } while (duration < min_trial_duration);
+      runtimes.push_back(duration / n_calls);
+    }
+
+    std::nth_element(runtimes.begin(), runtimes.begin() + n_trials / 2, runtimes.end());
+    return runtimes[n_trials / 2];
+  }
+
+  /**
+   * @brief Fit the growth exponent of the runtime (slope of log(runtime) over log(size)).
+   */
+  static double FitGrowthExponent(
+    const std::vector<std::size_t> & sizes, const std::vector<double> & runtimes)
+  {
+    const double n = static_cast<double>(sizes.size());
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    double sum_xx = 0.0;
+    double sum_xy = 0.0;
+    for (std::size_t i = 0; i < sizes.size(); i++) {
+      const double x = std::log(static_cast<double>(sizes[i]));
+      const double y = std::log(runtimes[i]);
+      sum_x += x;
+      sum_y += y;
+      sum_xx += x * x;
+      sum_xy += x * y;
+    }
+    return (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x);
+  }
+
+  /**
+   * @brief Measure a function on graphs of doubling size and check the growth exponent.
+   *
+   * @param name The name of the function (prefix of the recorded test properties).
+   * @param sizes The sizes of the graphs.
+   * @param run_for_size Runs the function on a graph of the given size, returns the function to
+   * measure (the graph is created outside of the measurement).
+   */
+  static void ExpectBoundedGrowth(
+    const char * name, const std::vector<std::size_t> & sizes,
+    const std::function<std::function<void()>(std::size_t)> & run_for_size)
+  {
+    std::vector<double> runtimes;
+    for (const std::size_t size : sizes) {
+      runtimes.push_back(MeasureSeconds(run_for_size(size)));
+    }
+
+    // Stored in the test report (e.g. the XML output of ctest) instead of the console output
+    const double exponent = FitGrowthExponent(sizes, runtimes);
+    const std::string prefix = name;
+    RecordProperty(prefix + "_growth_exponent", std::to_string(exponent));
+    RecordProperty(
+      prefix + "_runtime_ms_at_" + std::to_string(sizes.front()),
+      std::to_string(1e3 * runtimes.front()));
+    RecordProperty(
+      prefix + "_runtime_ms_at_" + std::to_string(sizes.back()),
+      std::to_string(1e3 * runtimes.back()));
+    EXPECT_LE(exponent, MAPLESS_SCALING_MAX_EXPONENT) << name;
+  }
+
+  /**
+   * @brief Create the lanelet connections of a road with parallel lanes (normalized, with
+   * predecessors): lanelet k of lane l has the index l * n_lanelets_per_lane + k, the successor
+   * k + 1 in the same lane and the neighbors in the lanes l - 1 (left) and l + 1 (right).
+   */
+  static std::vector<LaneletConnection> CreateRoadConnections(
+    const std::size_t n_lanes, const std::size_t n_lanelets_per_lane)
+  {
+    std::vector<LaneletConnection> lanelet_connections(n_lanes * n_lanelets_per_lane);
+    for (std::size_t lane = 0; lane < n_lanes; lane++) {
+      for (std::size_t k = 0; k < n_lanelets_per_lane; k++) {
+        const int id = static_cast<int>(lane * n_lanelets_per_lane + k);
+        LaneletConnection & lanelet_connection = lanelet_connections[id];
+        lanelet_connection.original_lanelet_id = id;
+        lanelet_connection.successor_lanelet_ids = {
+          k + 1 < n_lanelets_per_lane ? id + 1 : -1};
+        lanelet_connection.neighbor_lanelet_ids = {
+          lane > 0 ? id - static_cast<int>(n_lanelets_per_lane) : -1,
+          lane + 1 < n_lanes ? id + static_cast<int>(n_lanelets_per_lane) : -1};
+        lanelet_connection.goal_information = true;
+      }
+    }
+    CalculatePredecessors(lanelet_connections);
+    return lanelet_connections;
+  }
+
+  /**
+   * @brief Create the road segments of the road of CreateRoadConnections() with lanelets of 1 m
+   * length and width, the vehicle (at (0, 0)) is on the first lanelet of the center lane.
+   */
+  static autoware_mapless_planning_msgs::msg::RoadSegments CreateRoadSegments(
+    const std::size_t n_lanes, const std::size_t n_lanelets_per_lane)
+  {
+    const std::vector<LaneletConnection> lanelet_connections =
+      CreateRoadConnections(n_lanes, n_lanelets_per_lane);
+
+    autoware_mapless_planning_msgs::msg::RoadSegments message;
+    message.segments.resize(lanelet_connections.size());
+    for (std::size_t lane = 0; lane < n_lanes; lane++) {
+      const double y_center = static_cast<double>(lane) - static_cast<double>(n_lanes / 2);
+      for (std::size_t k = 0; k < n_lanelets_per_lane; k++) {
+        const std::size_t id = lane * n_lanelets_per_lane + k;
+        auto & segment = message.segments[id];
+        segment.id = lanelet_connections[id].original_lanelet_id;
+        segment.successor_segment_id.assign(
+          lanelet_connections[id].successor_lanelet_ids.begin(),
+          lanelet_connections[id].successor_lanelet_ids.end());
+        segment.neighboring_segment_id.assign(
+          lanelet_connections[id].neighbor_lanelet_ids.begin(),
+          lanelet_connections[id].neighbor_lanelet_ids.end());
+
+        for (std::size_t j = 0; j < 2; j++) {
+          segment.linestrings[j].poses.resize(2);
+          for (std::size_t i = 0; i < 2; i++) {
+            segment.linestrings[j].poses[i].position.x = static_cast<double>(k + i) - 0.5;
+            segment.linestrings[j].poses[i].position.y = y_center + (j == 0 ? -0.5 : 0.5);
+          }
+        }
+      }
+    }
+    return message;
+  }
+
+  // Sizes of the graphs (doubling)
+  const std::vector<std::size_t> sizes_ = {2048, 4096, 8192, 16384, 32768};
+};
+
+/**
+ * @brief Test the growth of GetAllLaneletSequences() along a long lane.
+ */
+TEST_F(ScalingTest, TestGetAllLaneletSequencesScaling)
+{
+  std::vector<LaneletConnection> lanelet_connections;
+  ExpectBoundedGrowth("GetAllLaneletSequences", sizes_, [&](const std::size_t size) {
+    lanelet_connections = CreateRoadConnections(1, size);
+    return [&lanelet_connections] {
+      const std::vector<LaneIndices> sequences =
+        GetAllLaneletSequences(lanelet_connections, 0, AdjacentLaneType::kSuccessors);
+      ASSERT_EQ(sequences.size(), 1u);
+      ASSERT_EQ(sequences[0].size(), lanelet_connections.size());
+    };
+  });
+}
+
+/**
+ * @brief Test the growth of GetAllNeighboringLaneletIDs() on a wide road.
+ */
+TEST_F(ScalingTest, TestGetAllNeighboringLaneletIDsScaling)
+{
+  std::vector<LaneletConnection> lanelet_connections;
+  ExpectBoundedGrowth("GetAllNeighboringLaneletIDs", sizes_, [&](const std::size_t size) {
+    lanelet_connections = CreateRoadConnections(size, 1);
+    return [&lanelet_connections] {
+      const LaneIndices neighbors =
+        GetAllNeighboringLaneletIDs(lanelet_connections, 0, VehicleSide::kRight);
+      ASSERT_EQ(neighbors.size(), lanelet_connections.size() - 1);
+    };
+  });
+}
+
+/**
+ * @brief Test the growth of CalculatePredecessors() (including the copy of the connections).
+ */
+TEST_F(ScalingTest, TestCalculatePredecessorsScaling)
+{
+  std::vector<LaneletConnection> lanelet_connections;
+  std::vector<LaneletConnection> lanelet_connections_copy;
+  ExpectBoundedGrowth("CalculatePredecessors", sizes_, [&](const std::size_t size) {
+    lanelet_connections = CreateRoadConnections(1, size);
+    for (LaneletConnection & lanelet_connection : lanelet_connections) {
+      lanelet_connection.predecessor_lanelet_ids.clear();
+    }
+    return [&] {
+      lanelet_connections_copy = lanelet_connections;
+      CalculatePredecessors(lanelet_connections_copy);
+      ASSERT_EQ(lanelet_connections_copy[1].predecessor_lanelet_ids[0], 0);
+    };
+  });
+}
+
+/**
+ * @brief Test the growth of MissionPlannerCore::CalculateLanes() on a road with three long lanes.
+ */
+TEST_F(ScalingTest, TestCalculateLanesScaling)
+{
+  const std::size_t n_lanes = 3;
+  MissionPlannerCore core;
+  std::vector<lanelet::Lanelet> lanelets;
+  std::vector<LaneletConnection> lanelet_connections;
+
+  // Fewer lanelets than for the graph functions (the lanelets are created from the road segments)
+  const std::vector<std::size_t> sizes = {1024, 2048, 4096, 8192};
+  ExpectBoundedGrowth("CalculateLanes", sizes, [&](const std::size_t size) {
+    EXPECT_TRUE(core
+                  .ConvertInput2LaneletFormat(
+                    CreateRoadSegments(n_lanes, size), lanelets, lanelet_connections)
+                  .IsValid());
+    return [&core, &lanelets, &lanelet_connections, size] {
+      const Lanes lanes = core.CalculateLanes(lanelets, lanelet_connections);
+      ASSERT_EQ(lanes.ego.size(), size);
+      ASSERT_EQ(lanes.left.size(), 1u);
+      ASSERT_EQ(lanes.right.size(), 1u);
+    };
+  });
+}
+
+/**
+ * @brief Test the growth of MissionPlannerCore::IsOnGoalLane() with the goal at the end of a long
+ * lane (the lane membership table is built once per graph, a query looks up the goal lanelet and
+ * checks that the table was built from the lanelet connections).
+ */
+TEST_F(ScalingTest, TestIsOnGoalLaneScaling)
+{
+  MissionPlannerCore core;
+  std::vector<lanelet::Lanelet> lanelets;
+  std::vector<LaneletConnection> lanelet_connections;
+
+  const std::vector<std::size_t> sizes = {1024, 2048, 4096, 8192};
+  ExpectBoundedGrowth("IsOnGoalLane", sizes, [&](const std::size_t size) {
+    EXPECT_TRUE(
+      core.ConvertInput2LaneletFormat(CreateRoadSegments(1, size), lanelets, lanelet_connections)
+        .IsValid());
+    const lanelet::BasicPoint2d goal_point(static_cast<double>(size - 1), 0.0);
+    EXPECT_TRUE(core.IsOnGoalLane(0, goal_point, lanelets, lanelet_connections));
+    return [&core, &lanelets, &lanelet_connections, goal_point] {
+      ASSERT_TRUE(core.IsOnGoalLane(0, goal_point, lanelets, lanelet_connections));
+    };
+  });
+}
+
+/**
+ * @brief Test the growth of PolylineSimplifier::Simplify() on the degenerate input of
+ * Douglas-Peucker: a zig-zag with decreasing amplitude, whose farthest point is always next to the
+ * start of a range (all points are kept, plain Douglas-Peucker is quadratic).
+ */
+TEST_F(ScalingTest, TestPolylineSimplifierWorstCaseScaling)
+{
+  PolylineSimplifier simplifier;
+  std::vector<geometry_msgs::msg::Pose> zigzag;
+  std::vector<geometry_msgs::msg::Pose> poses;
+  ExpectBoundedGrowth("PolylineSimplifier", sizes_, [&](const std::size_t size) {
+    zigzag.resize(size);
+    for (std::size_t i = 0; i < size; i++) {
+      const double amplitude = static_cast<double>(size - i);
+      zigzag[i].position.x = static_cast<double>(i);
+      zigzag[i].position.y = i % 2 == 0 ? amplitude : -amplitude;
+    }
+    return [&simplifier, &zigzag, &poses] {
+      poses = zigzag;
+      ASSERT_EQ(simplifier.Simplify(poses, 0.05), 0u);
+    };
+  });
+}
+
+}  // namespace autoware::mapless_architecture
@@ -0,0 +1,206 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/helper_functions.hpp"
+
+#include "lanelet2_core/geometry/LineString.h"
+
+#include "geometry_msgs/msg/point.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+namespace
+{
+/**
+ * @brief Reference implementation of GetPsiForPoints() (std::atan2() on an interleaved array of
+ * tangent vectors), used as the baseline for runtime and accuracy.
+ */
+std::vector<double> GetPsiForPointsReference(const std::vector<geometry_msgs::msg::Point> & points)
+{
+  const int num_points = points.size();
+  std::vector<double> tang_vecs(num_points * 2);
+
+  tang_vecs[0] = points[1].x - points[0].x;
+  tang_vecs[1] = points[1].y - points[0].y;
+
+  for (int i = 1; i < num_points - 1; i++) {
+    tang_vecs[2 * i] = points[i + 1].x - points[i - 1].x;
+    tang_vecs[2 * i + 1] = points[i + 1].y - points[i - 1].y;
+  }
+
+  tang_vecs[2 * (num_points - 1)] = points[num_points - 1].x - points[num_points - 2].x;
+  tang_vecs[2 * (num_points - 1) + 1] = points[num_points - 1].y - points[num_points - 2].y;
+
+  std::vector<double> psi_points(num_points);
+  for (int i = 0; i < num_points; i++) {
+    psi_points[i] = NormalizePsi(std::atan2(tang_vecs[2 * i + 1], tang_vecs[2 * i]));
+  }
+
+  return psi_points;
+}
+
+/**
+ * @brief Run a function several times and return the median runtime per call in microseconds.
+ */
+double MeasureMedianMicroseconds(const std::function<void()> & function, const int repetitions)
+{
+  std::vector<double> runtimes;
+  runtimes.reserve(repetitions);
+
+  for (int i = 0; i < repetitions; i++) {
+    const auto t_start = std::chrono::steady_clock::now();
+    function();
+    const auto t_end = std::chrono::steady_clock::now();
+    runtimes.push_back(std::chrono::duration<double, std::micro>(t_end - t_start).count());
+  }
+
+  std::nth_element(runtimes.begin(), runtimes.begin() + repetitions / 2, runtimes.end());
+  return runtimes[repetitions / 2];
+}
+
+/**
+ * @brief Create a noisy curved polyline with the given number of points.
+ */
+std::vector<geometry_msgs::msg::Point> CreatePolyline(const std::size_t num_points)
+{
+  std::mt19937 generator(42);
+  std::normal_distribution<double> noise(0.0, 0.01);
+
+  std::vector<geometry_msgs::msg::Point> points(num_points);
+  for (std::size_t i = 0; i < num_points; i++) {
+    const double s = 0.2 * static_cast<double>(i);
+    points[i].x = 50.0 * std::sin(s / 50.0) + noise(generator);
+    points[i].y = 50.0 * (1.0 - std::cos(s / 50.0)) + noise(generator);
+  }
+  return points;
+}
+
+void BenchmarkGetPsiForPoints()
+{
+  std::printf("GetPsiForPoints\n");
+  std::printf(
+    "%10s %16s %16s %16s %14s\n", "points", "reference [us]", "AoS [us]", "SoA [us]",
+    "max err [rad]");
+
+  for (const std::size_t num_points : {16, 128, 1024, 8192}) {
+    const auto points = CreatePolyline(num_points);
+
+    // SoA input and output buffers are prepared once, as a caller would do
+    std::vector<double> x(num_points), y(num_points), psi(num_points);
+    for (std::size_t i = 0; i < num_points; i++) {
+      x[i] = points[i].x;
+      y[i] = points[i].y;
+    }
+
+    // Accuracy compared to the reference implementation (wrap-around at +/- pi is no error)
+    const auto psi_reference = GetPsiForPointsReference(points);
+    GetPsiForPoints(x.data(), y.data(), num_points, psi.data());
+    double max_error = 0.0;
+    for (std::size_t i = 0; i < num_points; i++) {
+      max_error = std::max(max_error, std::fabs(NormalizePsi(psi[i] - psi_reference[i])));
+    }
+
+    const int repetitions = 2000;
+    volatile double sink = 0.0;
+    const double t_reference = MeasureMedianMicroseconds(
+      [&]() { sink = sink + GetPsiForPointsReference(points).back(); }, repetitions);
+    const double t_aos = MeasureMedianMicroseconds(
+      [&]() { sink = sink + GetPsiForPoints(points).back(); }, repetitions);
+    const double t_soa = MeasureMedianMicroseconds(
+      [&]() {
+        GetPsiForPoints(x.data(), y.data(), num_points, psi.data());
+        sink = sink + psi.back();
+      },
+      repetitions);
+
+    std::printf(
+      "%10zu %16.3f %16.3f %16.3f %14.2e\n", num_points, t_reference, t_aos, t_soa, max_error);
+  }
+}
+
+/**
+ * @brief Create a curved bound with the given lateral offset and number of points.
+ */
+lanelet::LineString3d CreateBound(const double offset, const std::size_t num_points)
+{
+  const double radius = 100.0;
+  const double angle_max = 0.5;
+  lanelet::Points3d points;
+  points.reserve(num_points);
+  for (std::size_t i = 0; i < num_points; i++) {
+    const double angle = angle_max * static_cast<double>(i) / static_cast<double>(num_points - 1);
+    points.emplace_back(
+      lanelet::InvalId, (radius - offset) * std::sin(angle),
+      radius - (radius - offset) * std::cos(angle), 0.0);
+  }
+  return lanelet::LineString3d(lanelet::InvalId, points);
+}
+
+void BenchmarkCreatePairedBoundCenterline()
+{
+  std::printf("CreatePairedBoundCenterline\n");
+  std::printf(
+    "%10s %16s %16s %14s\n", "points", "lanelet2 [us]", "paired [us]", "max dev [m]");
+
+  for (const std::size_t num_points : {16, 128, 1024}) {
+    // The bounds are sampled differently (as perception does for inner and outer bounds)
+    const lanelet::LineString3d bound_left = CreateBound(1.75, num_points);
+    const lanelet::LineString3d bound_right = CreateBound(-1.75, num_points * 3 / 4);
+
+    // Deviation from the centerline of lanelet2
+    const lanelet::Lanelet lanelet_reference(lanelet::InvalId, bound_left, bound_right);
+    const lanelet::ConstLineString2d centerline_reference = lanelet_reference.centerline2d();
+    const lanelet::LineString3d centerline =
+      CreatePairedBoundCenterline(bound_left, bound_right);
+    double max_deviation = 0.0;
+    for (const auto & point : centerline) {
+      max_deviation = std::max(
+        max_deviation, lanelet::geometry::distance2d(
+                         centerline_reference, lanelet::BasicPoint2d(point.x(), point.y())));
+    }
+
+    // lanelet2 caches the centerline in the lanelet, a new lanelet is created for each call
+    const int repetitions = 200;
+    volatile double sink = 0.0;
+    const double t_reference = MeasureMedianMicroseconds(
+      [&]() {
+        const lanelet::Lanelet lanelet(lanelet::InvalId, bound_left, bound_right);
+        sink = sink + lanelet.centerline().back().x();
+      },
+      repetitions);
+    const double t_paired = MeasureMedianMicroseconds(
+      [&]() { sink = sink + CreatePairedBoundCenterline(bound_left, bound_right).back().x(); },
+      repetitions);
+
+    std::printf(
+      "%10zu %16.3f %16.3f %14.2e\n", num_points, t_reference, t_paired, max_deviation);
+  }
+}
+}  // namespace
+}  // namespace autoware::mapless_architecture
+
+int main()
+{
+  autoware::mapless_architecture::BenchmarkGetPsiForPoints();
+  autoware::mapless_architecture::BenchmarkCreatePairedBoundCenterline();
+  return 0;
+}
@@ -0,0 +1,198 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__CORRIDOR_EMITTER_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__CORRIDOR_EMITTER_HPP_
+
+#include "geometry_msgs/msg/point.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Read access to the position of a source point of a corridor.
+ *
+ * The primary template covers the lanelet2 points (x(), y(), z()), the specialization the
+ * geometry_msgs::msg::Point (e.g. the points of a DrivingCorridor message).
+ */
+template <typename SourcePointT>
+struct CorridorSourceTraits
+{
+  static double X(const SourcePointT & point) { return point.x(); }
+  static double Y(const SourcePointT & point) { return point.y(); }
+  static double Z(const SourcePointT & point) { return point.z(); }
+};
+
+template <>
+struct CorridorSourceTraits<geometry_msgs::msg::Point>
+{
+  static double X(const geometry_msgs::msg::Point & point) { return point.x; }
+  static double Y(const geometry_msgs::msg::Point & point) { return point.y; }
+  static double Z(const geometry_msgs::msg::Point & point) { return point.z; }
+};
+
+/**
+ * @brief Write access to the position of a destination point of a corridor.
+ *
+ * The primary template covers the point types with a pose (e.g.
+ * autoware_planning_msgs::msg::PathPoint and TrajectoryPoint), the specialization the
+ * geometry_msgs::msg::Point (e.g. DrivingCorridor, path bounds and Marker points).
+ */
+template <typename PointT>
+struct CorridorPointTraits
+{
+  static void SetPosition(PointT & point, const double x, const double y, const double z)
+  {
+    point.pose.position.x = x;
+    point.pose.position.y = y;
+    point.pose.position.z = z;
+  }
+
+  static double GetZ(const PointT & point) { return point.pose.position.z; }
+};
+
+template <>
+struct CorridorPointTraits<geometry_msgs::msg::Point>
+{
+  static void SetPosition(
+    geometry_msgs::msg::Point & point, const double x, const double y, const double z)
+  {
+    point.x = x;
+    point.y = y;
+    point.z = z;
+  }
+
+  static double GetZ(const geometry_msgs::msg::Point & point) { return point.z; }
+};
+
+/**
+ * @brief Destination of EmitCorridorPoints(): the points are appended to a vector.
+ *
+ * @tparam PointT The point type of the destination.
+ * @tparam kCopyZ Copy the z coordinate of the source (otherwise the one of the prototype is kept).
+ */
+template <typename PointT, bool kCopyZ>
+struct CorridorSink
+{
+  std::vector<PointT> * points;
+
+  // Initial value of an emitted point (e.g. with the velocity of a trajectory point)
+  PointT prototype;
+
+  void Emit(const double x, const double y, const double z) const
+  {
+    points->push_back(prototype);
+    if constexpr (kCopyZ) {
+      CorridorPointTraits<PointT>::SetPosition(points->back(), x, y, z);
+    } else {
+      CorridorPointTraits<PointT>::SetPosition(
+        points->back(), x, y, CorridorPointTraits<PointT>::GetZ(prototype));
+    }
+  }
+};
+
+/**
+ * @brief Create the destination of EmitCorridorPoints().
+ *
+ * @tparam kCopyZ Copy the z coordinate of the source (false: planar output, z of the prototype).
+ * @param points The vector the points are appended to.
+ * @param prototype The initial value of an emitted point.
+ * @return The sink.
+ */
+template <bool kCopyZ = true, typename PointT>
+CorridorSink<PointT, kCopyZ> MakeCorridorSink(
+  std::vector<PointT> & points, const PointT & prototype = PointT())
+{
+  return CorridorSink<PointT, kCopyZ>{&points, prototype};
+}
+
+/**
+ * @brief Get the number of points EmitCorridorPoints() emits at most for a source (e.g. to reserve
+ * the destinations).
+ *
+ * @param n_points The number of points of the source.
+ * @param step The point step.
+ * @return The number of points.
+ */
+inline std::size_t GetCorridorPointCount(const std::size_t n_points, const std::size_t step)
+{
+  if (n_points == 0) return 0;
+  const std::size_t step_valid = step > 1 ? step : 1;
+  return (n_points - 1) / step_valid + 1 + ((n_points - 1) % step_valid != 0 ? 1 : 0);
+}
+
+/**
+ * @brief Filter for EmitCorridorPoints() which accepts all points.
+ */
+struct AcceptAllCorridorPoints
+{
+  template <typename SourcePointT>
+  bool operator()(const SourcePointT &, const SourcePointT &) const
+  {
+    return true;
+  }
+};
+
+/**
+ * @brief Emit the points of a linestring into one or several destinations in one pass.
+ *
+ * Every step-th point and the last point of the source are emitted (step 1: all points). An
+ * emitted point is written into all sinks directly (constructed from the prototype of the sink),
+ * i.e. without intermediate vectors. The destinations are not reserved, as a corridor is usually
+ * emitted from several linestrings (reserve the total with GetCorridorPointCount()).
+ *
+ * @param source The source linestring (random access, lanelet2 or geometry_msgs points).
+ * @param step The point step.
+ * @param is_accepted Filter which is called with the last emitted and the candidate source point
+ * (not for the first point), a rejected point is not emitted.
+ * @param sinks The destinations (MakeCorridorSink()).
+ * @return The number of emitted points.
+ */
+template <typename SourceT, typename FilterT, typename... SinkTs>
+std::size_t EmitCorridorPoints(
+  const SourceT & source, const std::size_t step, const FilterT & is_accepted,
+  const SinkTs &... sinks)
+{
+  using SourcePointT = std::decay_t<decltype(source[0])>;
+  using Traits = CorridorSourceTraits<SourcePointT>;
+
+  const std::size_t n_points = source.size();
+  const std::size_t step_valid = step > 1 ? step : 1;
+
+  std::size_t n_emitted = 0;
+  std::size_t id_last_emitted = 0;
+  for (std::size_t i = 0; i < n_points; i++) {
+    if (i % step_valid != 0 && i != n_points - 1) continue;
+
+    const SourcePointT & point = source[i];
+    if (n_emitted > 0 && !is_accepted(source[id_last_emitted], point)) continue;
+
+    const double x = Traits::X(point);
+    const double y = Traits::Y(point);
+    const double z = Traits::Z(point);
+    (sinks.Emit(x, y, z), ...);
+
+    id_last_emitted = i;
+    n_emitted++;
+  }
+  return n_emitted;
+}
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__CORRIDOR_EMITTER_HPP_
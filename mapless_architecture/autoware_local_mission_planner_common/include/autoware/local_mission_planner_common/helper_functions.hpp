@@ -15,11 +15,10 @@
 #ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__HELPER_FUNCTIONS_HPP_
 #define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__HELPER_FUNCTIONS_HPP_
 
+#include "autoware/local_mission_planner_common/small_vector.hpp"
 #include "eigen3/Eigen/Core"
 #include "eigen3/Eigen/Geometry"
 #include "lanelet2_core/primitives/Lanelet.h"
-#include "tf2_ros/buffer.h"
-#include "tf2_ros/transform_listener.h"
 
 #include "autoware_mapless_planning_msgs/msg/driving_corridor.hpp"
 #include "autoware_mapless_planning_msgs/msg/local_map.hpp"
@@ -122,18 +121,65 @@ double NormalizePsi(const double psi);
  */
 std::vector<double> GetPsiForPoints(const std::vector<geometry_msgs::msg::Point> & points);
 
+/**
+ * @brief Get the psi value for points given as separate x and y arrays (structure of arrays).
+ *
+ * The heading of a point is computed from its two neighbors (or the adjacent point at the start
+ * and end of the array). The angles are computed with FastAtan2() and are therefore accurate up
+ * to kFastAtan2MaxError. The loop is free of branches and library calls so that it can be
+ * vectorized by the compiler.
+ *
+ * @param x The x values of the points (num_points elements).
+ * @param y The y values of the points (num_points elements).
+ * @param num_points The number of points.
+ * @param psi_out The output buffer for the psi values in [-pi, pi[ (num_points elements, caller
+ * allocated). A single point gets a psi value of 0.0.
+ */
+void GetPsiForPoints(
+  const double * x, const double * y, const std::size_t num_points, double * psi_out);
+
+/**
+ * @brief Maximum absolute error (rad) of FastAtan2() compared to std::atan2().
+ */
+constexpr double kFastAtan2MaxError = 5e-8;
+
+/**
+ * @brief Polynomial approximation of std::atan2().
+ *
+ * The argument is reduced to [0, 1] and atan() is evaluated with an odd minimax polynomial of
+ * degree 15, the maximum absolute error is below kFastAtan2MaxError. atan2(0, 0) returns 0.0.
+ *
+ * @param y The y value.
+ * @param x The x value.
+ * @return double The angle in [-pi, pi].
+ */
+double FastAtan2(const double y, const double x);
+
+/**
+ * @brief Inline capacity of LaneIndices (lists up to this length do not allocate).
+ */
+constexpr std::size_t kLaneIndicesInlineCapacity = 16;
+
+/**
+ * @brief List of lanelet indices (e.g. a lane, a lanelet sequence or the adjacent lanelets of a
+ * lanelet), stored inline for typical lengths and with O(1) insertion at the front.
+ */
+typedef SmallVector<int, kLaneIndicesInlineCapacity> LaneIndices;
+
 /**
  * @brief LaneletConnection
  *
  * Holds the origin lanelet Id, the predecessor lanelet Ids, the successor lanelet Ids, the
- * neighboring lanelet Ids and the goal information.
+ * neighboring lanelet Ids and the goal information. The lanelet graph functions below expect
+ * lanelet connections normalized by NormalizeLaneletConnections() (e.g. the adjacent lanelet lists
+ * are never empty and there is a neighbor entry for each VehicleSide).
  */
 struct LaneletConnection
 {
   int original_lanelet_id;
-  std::vector<int> predecessor_lanelet_ids;
-  std::vector<int> successor_lanelet_ids;
-  std::vector<int> neighbor_lanelet_ids;
+  LaneIndices predecessor_lanelet_ids;
+  LaneIndices successor_lanelet_ids;
+  LaneIndices neighbor_lanelet_ids;
   bool goal_information;
 };
 
@@ -153,7 +199,7 @@ enum AdjacentLaneType { kSuccessors = 0, kPredecessors = 1 };
  * @return Collection of sequences of all successor lanelets.
  */
 
-std::vector<std::vector<int>> GetAllSuccessorSequences(
+std::vector<LaneIndices> GetAllSuccessorSequences(
   const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet);
 
 /**
@@ -167,7 +213,7 @@ std::vector<std::vector<int>> GetAllSuccessorSequences(
 lanelet_tools::AdjacentLaneType::kPredecessors).
 * @return Collection of sequences of all adjacent lanelets
 */
-std::vector<std::vector<int>> GetAllLaneletSequences(
+std::vector<LaneIndices> GetAllLaneletSequences(
   const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet,
   const AdjacentLaneType adjacent_lane_type);
 
@@ -175,6 +221,9 @@ std::vector<std::vector<int>> GetAllLaneletSequences(
  * @brief Find relevant adjacent (successors or predecessors) lanelets (currently relevant means
  * leading towards goal) among a set of provided adjacent lanelets (ids_adjacent_lanelets).
  *
+ * Requires a non-empty ids_adjacent_lanelets ({-1} if there are no adjacent lanelets, as in the
+ * lanelet connections normalized by NormalizeLaneletConnections()), checked by an assertion.
+ *
  * @param lanelet_connections   Relation between individual lanelets (successors/neighbors).
  * @param ids_adjacent_lanelets IDs of all available adjacent lanelets (either successors or
  * predecessors).
@@ -183,16 +232,21 @@ std::vector<std::vector<int>> GetAllLaneletSequences(
  * successors will be returned.
  * @return ID of relevant successor lanelet.
  */
-std::vector<int> GetRelevantAdjacentLanelets(
+LaneIndices GetRelevantAdjacentLanelets(
   const std::vector<LaneletConnection> & lanelet_connections,
-  const std::vector<int> ids_adjacent_lanelets, const bool do_include_navigation_info);
+  const LaneIndices & ids_adjacent_lanelets, const bool do_include_navigation_info);
 
 /**
  * @brief Get a complete lanelet ID sequence starting from an initial lanelet.
  *
+ * Requires a non-empty lanelet_id_sequence_current and a non-empty ids_relevant_lanelets ({-1} if
+ * there are no relevant lanelets, as returned by GetRelevantAdjacentLanelets()), checked by
+ * assertions.
+ *
  * @param lanelet_id_sequence_current  Current lanelet ID sequence (of previous iteration); this is
  * the start for the search in the current iteration.
- * @param lanelets_already_visited      List of already visited lanelet IDs.
+ * @param lanelets_already_visited      Flags of the already visited lanelets (indexed by the
+ * lanelet ID, sized to the number of lanelets).
  * @param ids_relevant_lanelets         IDs of the relevant adjacent (successor or predecessor)
  * lanelets.
  * @param id_initial_lanelet            ID of lanelet from which search was started initially.
@@ -202,9 +256,9 @@ std::vector<int> GetRelevantAdjacentLanelets(
  *          - Flag to indicate whether outer for loop should be exited; this is necessary when no
  *            unvisited lanelets are left from the initial lanelet.
  */
-std::tuple<std::vector<int>, bool> GetCompletedLaneletSequence(
-  std::vector<int> & lanelet_id_sequence_current, std::vector<int> & lanelets_already_visited,
-  const std::vector<int> ids_relevant_lanelets, const int id_initial_lanelet);
+std::tuple<LaneIndices, bool> GetCompletedLaneletSequence(
+  LaneIndices & lanelet_id_sequence_current, std::vector<bool> & lanelets_already_visited,
+  const LaneIndices & ids_relevant_lanelets, const int id_initial_lanelet);
 
 /**
  * @brief The vehicle side (left or right).
@@ -223,7 +277,7 @@ enum VehicleSide { kLeft = 0, kRight = 1 };
  * @return IDs of all neighboring lanelets (returns -1 if no neighbor
  available).
  */
-std::vector<int> GetAllNeighboringLaneletIDs(
+LaneIndices GetAllNeighboringLaneletIDs(
   const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet,
   const VehicleSide side);
 
@@ -261,7 +315,7 @@ int GetNeighboringLaneletID(
                                 started.
  * @return Collection of sequences of all predecessor lanelets.
  */
-std::vector<std::vector<int>> GetAllPredecessorSequences(
+std::vector<LaneIndices> GetAllPredecessorSequences(
   const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet);
 
 /**
@@ -293,6 +347,19 @@ int FindEgoOccupiedLaneletID(const std::vector<lanelet::Lanelet> & lanelets);
 lanelet::BasicPoint2d RecenterGoalPoint(
   const lanelet::BasicPoint2d & goal_point, const std::vector<lanelet::Lanelet> & road_model);
 
+/**
+ * @brief Recenter a point in a lanelet to its closest point on the centerline (the lanelet of the
+ * point is already known, e.g. from an OccupiedLaneletTracker).
+ *
+ * @param goal_point The input point which should be re-centered.
+ * @param road_model The road model which contains the point to be re-centered.
+ * @param lanelet_idx_goal_point The index of the lanelet which contains the point (-1: none).
+ * @return lanelet::BasicPoint2d The re-centered point (the input point if the index is invalid).
+ */
+lanelet::BasicPoint2d RecenterGoalPoint(
+  const lanelet::BasicPoint2d & goal_point, const std::vector<lanelet::Lanelet> & road_model,
+  const int lanelet_idx_goal_point);
+
 /**
  * @brief Function for creating a marker array.
  *
@@ -310,15 +377,54 @@ visualization_msgs::msg::MarkerArray CreateMarkerArray(
   const std::vector<lanelet::ConstLineString3d> & right,
   const autoware_mapless_planning_msgs::msg::RoadSegments & msg);
 
+/**
+ * @brief Arc-length horizon of a driving corridor around the vehicle (located at (0, 0)).
+ *
+ * The arc length is measured along the centerline of the corridor (concatenated over the lanelets
+ * of the lane) from the projection of the vehicle onto it. The bounds are cut at the same
+ * cross-sections as the centerline (same normalized arc length of the bounds, see
+ * CreatePairedBoundCenterline()), i.e. all three linestrings end next to each other also in curves.
+ */
+struct CorridorHorizon
+{
+  // Arc length ahead of the vehicle in m (negative: unbounded)
+  double forward = -1.0;
+
+  // Arc length behind the vehicle in m (negative: unbounded)
+  double backward = -1.0;
+
+  bool IsBounded() const { return forward >= 0.0 || backward >= 0.0; }
+};
+
 /**
  * @brief Create a DrivingCorridor object.
  *
- * @param lane The lane which is a std::vector<int> containing all the indices of the lane.
+ * @param lane The lane (LaneIndices) containing all the indices of the lane.
  * @param converted_lanelets The lanelets (std::vector<lanelet::Lanelet>).
+ * @param point_step Only every point_step-th point of each linestring is added (the last point
+ * of a linestring is always kept), 1 adds all points.
+ * @param horizon The arc-length horizon: the linestrings are cropped while the corridor is
+ * assembled, the cut points are interpolated exactly (unbounded by default).
  * @return autoware_mapless_planning_msgs::msg::DrivingCorridor.
  */
 autoware_mapless_planning_msgs::msg::DrivingCorridor CreateDrivingCorridor(
-  const std::vector<int> & lane, const std::vector<lanelet::Lanelet> & converted_lanelets);
+  const LaneIndices & lane, const std::vector<lanelet::Lanelet> & converted_lanelets,
+  const int point_step = 1, const CorridorHorizon & horizon = CorridorHorizon());
+
+/**
+ * @brief Create the centerline of a lanelet from its left and right bound.
+ *
+ * Both bounds are parametrized by their normalized arc length (in the x-y plane), the centerline
+ * has a point at each point of either bound (merged in one linear pass) which is the mean of the
+ * two bounds at this normalized arc length. In contrast to lanelet::Lanelet::centerline(), which
+ * runs the generic algorithm of lanelet2, the cost is O(n) for n points of the bounds.
+ *
+ * @param bound_left The left bound.
+ * @param bound_right The right bound.
+ * @return The centerline (empty if a bound is empty), the points have no ids (lanelet::InvalId).
+ */
+lanelet::LineString3d CreatePairedBoundCenterline(
+  const lanelet::ConstLineString3d & bound_left, const lanelet::ConstLineString3d & bound_right);
 
 /**
  * @brief Function for creating a lanelet::LineString2d.
@@ -331,26 +437,32 @@ lanelet::LineString2d CreateLineString(const std::vector<geometry_msgs::msg::Poi
 /**
  * @brief Get all the neighbor lanelets (neighbor lane) of a specific lane on one side.
  *
+ * Requires lanelet connections normalized by NormalizeLaneletConnections() (a neighbor entry for
+ * each VehicleSide, -1 if there is no neighbor), checked by an assertion.
+ *
  * @param lane The considered lane.
  * @param lanelet_connections The lanelet connections.
  * @param vehicle_side The side of the vehicle that is considered (enum).
- * @return std::vector<int>
+ * @return LaneIndices
  */
-std::vector<int> GetAllNeighborsOfLane(
-  const std::vector<int> & lane, const std::vector<LaneletConnection> & lanelet_connections,
+LaneIndices GetAllNeighborsOfLane(
+  const LaneIndices & lane, const std::vector<LaneletConnection> & lanelet_connections,
   const int vehicle_side);
 
 /**
  * @brief Add the predecessor lanelet to a lane.
  *
+ * Requires lanelet connections normalized by NormalizeLaneletConnections() (non-empty predecessor
+ * lists, {-1} if there are no predecessors), checked by an assertion.
+ *
  * @param lane_idx The considered lane. The predecessor lanelet is added to the front of the lane.
  * @param lanelet_connections The lanelet connections.
  */
 void InsertPredecessorLanelet(
-  std::vector<int> & lane, const std::vector<LaneletConnection> & lanelet_connections);
+  LaneIndices & lane, const std::vector<LaneletConnection> & lanelet_connections);
 
 /**
- * @brief Calculate the predecessors.
+ * @brief Calculate the predecessors from the successors ({-1} for lanelets without predecessors).
  *
  * @param lanelet_connections The lanelet connections.
  */
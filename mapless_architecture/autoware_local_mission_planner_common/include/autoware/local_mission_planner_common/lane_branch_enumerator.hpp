@@ -0,0 +1,139 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANE_BRANCH_ENUMERATOR_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANE_BRANCH_ENUMERATOR_HPP_
+
+#include "autoware/local_mission_planner_common/helper_functions.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Budget of the lane branch enumeration, which bounds the compute independently of the
+ * topology of the lanelet graph.
+ */
+struct LaneBranchBudget
+{
+  // Maximum number of returned successor sequences
+  int max_branches = 4;
+
+  // Maximum number of lanelets per successor sequence (longer sequences are truncated)
+  int max_depth = 20;
+
+  // Maximum number of expanded partial sequences (0: 4 * max_branches * max_depth), sequences
+  // which are still open when the budget is exhausted are returned truncated
+  int max_expansions = 0;
+};
+
+/**
+ * @brief Lazy best-first enumeration of the successor sequences (branches) of a lanelet.
+ *
+ * The sequences are returned in the order of increasing cost, which is the sum of the
+ * (non-negative) costs of the transitions between consecutive lanelets, e.g. the heading change
+ * (straightness). A sequence ends at a lanelet without successors, at the maximum depth or if all
+ * successors are already part of the sequence (cycle).
+ */
+class LaneBranchEnumerator
+{
+public:
+  /**
+   * @brief Cost of the transition from a lanelet to one of its successors (negative costs are
+   * treated as 0).
+   */
+  typedef std::function<double(const int, const int)> TransitionCost;
+
+  /**
+   * @brief Constructor.
+   *
+   * @param lanelet_connections The lanelet connections (must outlive the enumerator).
+   * @param id_initial_lanelet The index of the initial lanelet.
+   * @param budget The budget of the enumeration.
+   * @param transition_cost The cost of a transition between two lanelets.
+   */
+  LaneBranchEnumerator(
+    const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet,
+    const LaneBranchBudget & budget, TransitionCost transition_cost);
+
+  /**
+   * @brief Get the next best successor sequence.
+   *
+   * @param sequence The successor sequence, starting with the initial lanelet (output).
+   * @param cost The cost of the sequence (output, optional).
+   * @return False if no sequence is left or the branch budget is exhausted.
+   */
+  bool Next(LaneIndices & sequence, double * cost = nullptr);
+
+  /**
+   * @brief Get the number of expanded partial sequences so far.
+   */
+  std::size_t GetExpansionCount() const { return n_expansions_; }
+
+private:
+  // Partial sequence, stored as a tree of back references to its parent sequence
+  struct Node
+  {
+    int lanelet_id;
+    int parent;
+    int depth;
+    double cost;
+  };
+
+  struct QueueEntry
+  {
+    double cost;
+    int node;
+
+    // Ties are broken by the order of insertion, which makes the enumeration deterministic
+    bool operator>(const QueueEntry & other) const
+    {
+      return cost > other.cost || (cost == other.cost && node > other.node);
+    }
+  };
+
+  bool IsValidLanelet(const int id) const;
+  bool IsInSequence(const int node, const int lanelet_id) const;
+
+  const std::vector<LaneletConnection> & lanelet_connections_;
+  const LaneBranchBudget budget_;
+  const std::size_t max_expansions_;
+  TransitionCost transition_cost_;
+
+  std::vector<Node> nodes_;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue_;
+  std::size_t n_expansions_ = 0;
+  int n_branches_ = 0;
+};
+
+/**
+ * @brief Get the best successor sequences of a lanelet (see LaneBranchEnumerator).
+ *
+ * @param lanelet_connections The lanelet connections.
+ * @param id_initial_lanelet The index of the initial lanelet.
+ * @param budget The budget of the enumeration.
+ * @param transition_cost The cost of a transition between two lanelets.
+ * @return The successor sequences, ordered by increasing cost.
+ */
+std::vector<LaneIndices> GetBestSuccessorSequences(
+  const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet,
+  const LaneBranchBudget & budget, LaneBranchEnumerator::TransitionCost transition_cost);
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANE_BRANCH_ENUMERATOR_HPP_
@@ -0,0 +1,151 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANE_MEMBERSHIP_TABLE_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANE_MEMBERSHIP_TABLE_HPP_
+
+#include "autoware/local_mission_planner_common/helper_functions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Per-frame lane membership table of a lanelet graph.
+ *
+ * Holds the predecessor closure of each lanelet as a bitset, i.e. whether a lanelet lies on the
+ * lane which leads to another lanelet (the lanelet itself or one of its direct or indirect
+ * predecessors), and the lane id of each lanelet (the lane of the frame it belongs to, 0 for the
+ * ego lane, -1, -2, ... for the left and +1, +2, ... for the right lanes). For n lanelets and e
+ * successor relations, the table has n * n bits and is built in O(n + e * n / 64) for an acyclic
+ * graph (each lanelet on or behind a cycle adds a search of its predecessors,
+ * O(n + e * n / 64)), a query is O(1). The memory is reused between frames.
+ */
+class LaneMembershipTable
+{
+public:
+  /**
+   * @brief Lane id of a lanelet which is on none of the lanes.
+   */
+  static constexpr int kNoLane = std::numeric_limits<int>::min();
+
+  /**
+   * @brief Build the table (all lanelets without a lane id).
+   *
+   * @param lanelet_connections The lanelet connections, normalized by
+   * NormalizeLaneletConnections().
+   */
+  void Build(const std::vector<LaneletConnection> & lanelet_connections);
+
+  /**
+   * @brief Check whether the table was built from the given lanelet connections (same original
+   * lanelet ids).
+   *
+   * @param lanelet_connections The lanelet connections.
+   * @return True if the table was built from the lanelet connections.
+   */
+  bool IsBuiltFrom(const std::vector<LaneletConnection> & lanelet_connections) const;
+
+  /**
+   * @brief Assign a lane id to the lanelets of a lane. Lanelets which already have a lane id keep
+   * it, i.e. the first assigned lane wins (assign the ego lane first).
+   *
+   * @param lane The lanelet indices of the lane.
+   * @param id_lane The lane id (0: ego lane, < 0: left lanes, > 0: right lanes).
+   */
+  void SetLaneId(const LaneIndices & lane, const int id_lane);
+
+  /**
+   * @brief Get the lane id of a lanelet.
+   *
+   * @param id_lanelet The index of the lanelet.
+   * @return The lane id, kNoLane if the lanelet is on none of the lanes or the index is invalid.
+   */
+  int GetLaneId(const int id_lanelet) const
+  {
+    return IsValidLanelet(id_lanelet) ? lane_ids_[id_lanelet] : kNoLane;
+  }
+
+  /**
+   * @brief Check whether a lanelet lies on the lane which leads to the target lanelet.
+   *
+   * @param id_lanelet The index of the lanelet.
+   * @param id_target_lanelet The index of the target lanelet (e.g. the goal lanelet).
+   * @return True if id_lanelet is id_target_lanelet or one of its (indirect) predecessors, false
+   * for invalid indices.
+   */
+  bool IsOnLaneTo(const int id_lanelet, const int id_target_lanelet) const
+  {
+    if (!IsValidLanelet(id_lanelet) || !IsValidLanelet(id_target_lanelet)) return false;
+    return (Row(id_target_lanelet)[id_lanelet / 64] >> (id_lanelet % 64)) & 1u;
+  }
+
+  /**
+   * @brief Get the number of lanelets of the table.
+   */
+  std::size_t GetSize() const { return n_lanelets_; }
+
+private:
+  bool IsValidLanelet(const int id) const
+  {
+    return id >= 0 && static_cast<std::size_t>(id) < n_lanelets_;
+  }
+
+  std::uint64_t * Row(const int id)
+  {
+    return bits_.data() + static_cast<std::size_t>(id) * n_words_;
+  }
+  const std::uint64_t * Row(const int id) const
+  {
+    return bits_.data() + static_cast<std::size_t>(id) * n_words_;
+  }
+
+  std::size_t n_lanelets_ = 0;
+  std::size_t n_words_ = 0;
+
+  // Predecessor closure, one row of n_words_ words per lanelet
+  std::vector<std::uint64_t> bits_;
+
+  // Lane id and original lanelet id per lanelet
+  std::vector<int> lane_ids_;
+  std::vector<int> original_lanelet_ids_;
+
+  // Buffers of the build (reused)
+  std::vector<int> n_open_predecessors_;
+  std::vector<int> queue_;
+  std::vector<bool> is_done_;
+};
+
+/**
+ * @brief Check whether a lanelet lies on the lane which leads to the target lanelet (single query
+ * without a table, search of the predecessors of the target lanelet in O(n + e)).
+ *
+ * @param lanelet_connections The lanelet connections, normalized by
+ * NormalizeLaneletConnections().
+ * @param id_lanelet The index of the lanelet.
+ * @param id_target_lanelet The index of the target lanelet (e.g. the goal lanelet).
+ * @return True if id_lanelet is id_target_lanelet or one of its (indirect) predecessors, false
+ * for invalid indices.
+ */
+bool IsOnLaneTo(
+  const std::vector<LaneletConnection> & lanelet_connections, const int id_lanelet,
+  const int id_target_lanelet);
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANE_MEMBERSHIP_TABLE_HPP_
@@ -0,0 +1,85 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANELET_GRAPH_VALIDATION_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANELET_GRAPH_VALIDATION_HPP_
+
+#include "autoware/local_mission_planner_common/helper_functions.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Defects of the lanelet connections of a local map found by NormalizeLaneletConnections().
+ */
+struct LaneletGraphReport
+{
+  // Referenced ids which are not part of the local map (repaired: replaced by -1)
+  std::size_t n_dangling_references = 0;
+
+  // Lanelets which are their own successor or neighbor (repaired: replaced by -1)
+  std::size_t n_self_references = 0;
+
+  // Missing left/right neighbor entries (repaired: filled with -1)
+  std::size_t n_filled_neighbor_slots = 0;
+
+  // Successor cycles (e.g. a roundabout), which are valid as the sequence search tracks the
+  // visited lanelets
+  std::size_t n_successor_cycles = 0;
+
+  // Original ids which are used by several lanelets (malformed)
+  std::size_t n_duplicate_ids = 0;
+
+  // Cycles in the chain of the left or right neighbors (malformed)
+  std::size_t n_neighbor_cycles = 0;
+
+  /**
+   * @brief Check whether the lanelet connections are usable.
+   */
+  bool IsValid() const { return n_duplicate_ids == 0 && n_neighbor_cycles == 0; }
+
+  /**
+   * @brief Get the number of repaired references.
+   */
+  std::size_t GetRepairCount() const
+  {
+    return n_dangling_references + n_self_references + n_filled_neighbor_slots;
+  }
+};
+
+/**
+ * @brief Validate and normalize the lanelet connections of a local map in O(n) (number of
+ * lanelets and references).
+ *
+ * Input: the successor and neighbor ids reference the original lanelet ids (negative: none), the
+ * predecessor ids are ignored. The references are mapped to the (index-based) new ids and the
+ * predecessors are calculated. Afterwards, the lanelet connections satisfy (if the report is
+ * valid):
+ * - successor_lanelet_ids and predecessor_lanelet_ids are either {-1} or only contain valid
+ *   indices (without the lanelet itself)
+ * - neighbor_lanelet_ids has at least 2 entries (VehicleSide), which are -1 or valid indices
+ * - the chains of the left and right neighbors are finite
+ *
+ * @param lanelet_connections The lanelet connections (input and output).
+ * @return The found defects.
+ */
+LaneletGraphReport NormalizeLaneletConnections(
+  std::vector<LaneletConnection> & lanelet_connections);
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANELET_GRAPH_VALIDATION_HPP_
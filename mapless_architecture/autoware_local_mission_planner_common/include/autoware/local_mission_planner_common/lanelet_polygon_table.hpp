@@ -0,0 +1,167 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANELET_POLYGON_TABLE_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANELET_POLYGON_TABLE_HPP_
+
+#include "lanelet2_core/primitives/Lanelet.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Per-frame table of the closed lanelet polygons for point containment queries.
+ *
+ * The polygon of a lanelet (left bound followed by the reversed right bound, as
+ * lanelet::Lanelet::polygon2d()) is stored as packed edge arrays (structure of arrays) together
+ * with its bounding box. The containment test is a branch-free crossing-number test over the
+ * edges, which evaluates the conditions as sign bits of differences, i.e. the compiler vectorizes
+ * it also for baseline x86-64 (one point against many edges, or many points against one edge, at
+ * -O2 with the flags of CMakeLists.txt). A point on the boundary between two adjacent polygons
+ * belongs to exactly one of them.
+ *
+ * The bounding boxes are assigned to the cells of a uniform grid (about one cell per polygon), a
+ * query only tests the polygons of the cell of a point. A batch of points is bucketed by cell
+ * and tested cell by cell. The memory is reused between frames.
+ */
+class LaneletPolygonTable
+{
+public:
+  /**
+   * @brief Build the table.
+   *
+   * @param lanelets The lanelets (the index of a polygon is the index of its lanelet).
+   */
+  void Build(const std::vector<lanelet::Lanelet> & lanelets);
+
+  /**
+   * @brief Check whether the table was built from the given lanelets (same lanelet ids).
+   */
+  bool IsBuiltFrom(const std::vector<lanelet::Lanelet> & lanelets) const;
+
+  /**
+   * @brief Get the number of polygons.
+   */
+  std::size_t GetSize() const { return lanelet_ids_.size(); }
+
+  /**
+   * @brief Check whether a point is inside a polygon.
+   *
+   * @param id_polygon The index of the polygon (must be smaller than GetSize()).
+   * @param x The x value of the point.
+   * @param y The y value of the point.
+   * @return True if the point is inside.
+   */
+  bool Contains(const int id_polygon, const double x, const double y) const;
+
+  /**
+   * @brief Check for many points whether they are inside a polygon.
+   *
+   * @param id_polygon The index of the polygon (must be smaller than GetSize()).
+   * @param x The x values of the points (n_points elements).
+   * @param y The y values of the points (n_points elements).
+   * @param n_points The number of points.
+   * @param is_inside The output buffer (n_points elements, caller allocated): 1 if the point is
+   * inside, 0 otherwise.
+   */
+  void Contains(
+    const int id_polygon, const double * x, const double * y, const std::size_t n_points,
+    std::uint8_t * is_inside) const;
+
+  /**
+   * @brief Find the first polygon which contains a point.
+   *
+   * @param x The x value of the point.
+   * @param y The y value of the point.
+   * @return The index of the polygon (-1 if no match).
+   */
+  int FindContainingPolygon(const double x, const double y) const;
+
+  /**
+   * @brief Find the first polygon which contains a point for many points (same result as
+   * FindContainingPolygon() for each point).
+   *
+   * The points are bucketed by grid cell once, the points of a cell are tested together against
+   * each polygon of the cell (see the overload of Contains() for many points). The buffers of the
+   * sweep are members of the table, i.e. a query does not allocate once they have grown (unlike
+   * the const queries, this is not safe for concurrent calls).
+   *
+   * @param x The x values of the points (n_points elements).
+   * @param y The y values of the points (n_points elements).
+   * @param n_points The number of points.
+   * @param ids_polygon The indices of the polygons (output, resized to n_points, -1 if no match).
+   */
+  void FindContainingPolygons(
+    const double * x, const double * y, const std::size_t n_points, std::vector<int> & ids_polygon);
+
+private:
+  bool IsInBoundingBox(const std::size_t id, const double x, const double y) const
+  {
+    return x >= min_x_[id] && x <= max_x_[id] && y >= min_y_[id] && y <= max_y_[id];
+  }
+
+  // Build the grid from the bounding boxes
+  void BuildGrid();
+
+  // Get the cell of a point (-1 if it is outside the grid)
+  int GetCell(const double x, const double y) const;
+
+  // Ids of the lanelets the table was built from
+  std::vector<lanelet::Id> lanelet_ids_;
+
+  // Edges of polygon i: [edge_offsets_[i], edge_offsets_[i + 1])
+  std::vector<std::size_t> edge_offsets_;
+
+  // Bounding boxes of the polygons
+  std::vector<double> min_x_;
+  std::vector<double> max_x_;
+  std::vector<double> min_y_;
+  std::vector<double> max_y_;
+
+  // Edges (start x/y, end y and dx/dy, which is 0 for horizontal edges)
+  std::vector<double> edge_x0_;
+  std::vector<double> edge_y0_;
+  std::vector<double> edge_y1_;
+  std::vector<double> edge_slope_;
+
+  // Grid: origin, cell size and number of cells, the polygons of cell c (ascending) are
+  // cell_polygons_[cell_offsets_[c], cell_offsets_[c + 1])
+  double grid_min_x_ = 0.0;
+  double grid_min_y_ = 0.0;
+  double cell_size_ = 1.0;
+  int n_cells_x_ = 0;
+  int n_cells_y_ = 0;
+  std::vector<std::size_t> cell_offsets_;
+  std::vector<int> cell_polygons_;
+
+  // Points of the polygon of the build (reused)
+  std::vector<double> polygon_x_;
+  std::vector<double> polygon_y_;
+
+  // Buffers of FindContainingPolygons() (reused): cell and index of the points (sorted by cell),
+  // coordinates and containment results of the points of one cell
+  std::vector<std::pair<int, std::size_t>> point_cells_;
+  std::vector<double> cell_x_;
+  std::vector<double> cell_y_;
+  std::vector<std::uint8_t> cell_is_inside_;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__LANELET_POLYGON_TABLE_HPP_
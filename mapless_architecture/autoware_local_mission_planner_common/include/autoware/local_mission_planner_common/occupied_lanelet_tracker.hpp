@@ -0,0 +1,119 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__OCCUPIED_LANELET_TRACKER_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__OCCUPIED_LANELET_TRACKER_HPP_
+
+#include "autoware/local_mission_planner_common/helper_functions.hpp"
+#include "autoware/local_mission_planner_common/lanelet_polygon_table.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Temporal-coherence hint for the lookup of the lanelet which contains a tracked point (e.g.
+ * the ego vehicle or the goal point).
+ *
+ * Between frames a tracked point nearly always stays in the same lanelet or moves to a direct
+ * successor or neighbor. The tracker remembers the lanelet of the last lookup by its original id
+ * (the segment id, which is stable between frames, unlike the index) and tests it first, then its
+ * successors and neighbors. Only on a miss the grid of the polygon table is searched, i.e. a
+ * typical lookup costs O(1) polygon tests. If the point lies in several overlapping lanelets, the
+ * remembered lanelet is preferred.
+ */
+class OccupiedLaneletTracker
+{
+public:
+  /**
+   * @brief Find the lanelet which contains a point.
+   *
+   * @param lanelet_polygons The polygon table of the lanelets of the frame.
+   * @param lanelet_connections The lanelet connections of the frame (same indices as the table).
+   * @param point The point.
+   * @return The index of the lanelet (-1 if no match).
+   */
+  int Find(
+    const LaneletPolygonTable & lanelet_polygons,
+    const std::vector<LaneletConnection> & lanelet_connections,
+    const lanelet::BasicPoint2d & point);
+
+  /**
+   * @brief Find the lanelet which contains a point among the remembered lanelet and its successors
+   * and neighbors (counted as a lookup, and as a hit if found).
+   *
+   * Used with Remember() if the points of several trackers are searched together after their
+   * misses (see LaneletPolygonTable::FindContainingPolygons()).
+   *
+   * @param lanelet_polygons The polygon table of the lanelets of the frame.
+   * @param lanelet_connections The lanelet connections of the frame (same indices as the table).
+   * @param point The point.
+   * @return The index of the lanelet (-1 if the grid has to be searched).
+   */
+  int FindNearRemembered(
+    const LaneletPolygonTable & lanelet_polygons,
+    const std::vector<LaneletConnection> & lanelet_connections,
+    const lanelet::BasicPoint2d & point);
+
+  /**
+   * @brief Remember the lanelet which was found by a search of the grid.
+   *
+   * @param lanelet_connections The lanelet connections of the frame.
+   * @param id The index of the lanelet (-1 if no match, the remembered lanelet is forgotten).
+   * @return The index of the lanelet (-1 if no match).
+   */
+  int Remember(const std::vector<LaneletConnection> & lanelet_connections, const int id);
+
+  /**
+   * @brief Forget the remembered lanelet (e.g. if the tracked point is reset), the statistics are
+   * kept.
+   */
+  void Reset() { id_original_last_ = -1; }
+
+  /**
+   * @brief Get the number of lookups.
+   */
+  std::size_t GetLookupCount() const { return n_lookups_; }
+
+  /**
+   * @brief Get the number of lookups which were answered by the remembered lanelet or one of its
+   * successors or neighbors.
+   */
+  std::size_t GetHitCount() const { return n_hits_; }
+
+  /**
+   * @brief Get the share of the lookups which were answered without a search (0 without lookups).
+   */
+  double GetHitRate() const
+  {
+    return n_lookups_ > 0 ? static_cast<double>(n_hits_) / static_cast<double>(n_lookups_) : 0.0;
+  }
+
+private:
+  // Get the index of the remembered lanelet in the frame (-1 if it is not part of it)
+  int GetLastLaneletIndex(const std::vector<LaneletConnection> & lanelet_connections) const;
+
+  // Original id and index of the lanelet of the last lookup (-1: none)
+  int id_original_last_ = -1;
+  int id_last_ = -1;
+
+  std::size_t n_lookups_ = 0;
+  std::size_t n_hits_ = 0;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__OCCUPIED_LANELET_TRACKER_HPP_
@@ -0,0 +1,134 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__POLYLINE_SIMPLIFIER_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__POLYLINE_SIMPLIFIER_HPP_
+
+#include "autoware_mapless_planning_msgs/msg/road_segments.hpp"
+#include "geometry_msgs/msg/pose.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Error-bounded simplification of polylines (Douglas-Peucker).
+ *
+ * The first and the last point of a polyline are kept. A range of points is replaced by the
+ * segment between its end points if all points of the range are within the maximum lateral error
+ * (distance to the segment in the x-y plane) of it, otherwise the range is split at the point
+ * with the largest error. The ranges are processed with an explicit stack.
+ *
+ * The ranges are scanned as long as the scanned points stay within 2 n log2(n), which holds for the
+ * smooth boundaries of a road. Beyond that budget (degenerate polylines, for which plain
+ * Douglas-Peucker is O(n^2)), long ranges (more than 2 * kBlockSize points) are checked with the
+ * convex hulls of a segment tree over the points (blocks of kBlockSize points and their unions),
+ * whose extreme points perpendicular to and along the segment bound the lateral error and the
+ * projections of all points of the range. Such a range is replaced by the segment if all its
+ * points are within the maximum lateral error of the line through its end points and project onto
+ * the segment, i.e. ranges which bend back behind their end points are split as well. The tree is
+ * built in O(n log n) and a range is checked in O(log^2 n), i.e. the cost is O(n log^2 n) for any
+ * polyline, except for ranges whose end points coincide, which are scanned. The points are removed
+ * in place (the kept poses are unchanged), the memory is reused between calls.
+ */
+class PolylineSimplifier
+{
+public:
+  /**
+   * @brief Number of points of the leaves of the hull tree.
+   */
+  static constexpr std::size_t kBlockSize = 32;
+
+  /**
+   * @brief Simplify a polyline.
+   *
+   * @param poses The poses of the polyline (simplified in place).
+   * @param max_lateral_error The maximum lateral error in m (not simplified if not positive).
+   * @return The number of removed poses.
+   */
+  std::size_t Simplify(
+    std::vector<geometry_msgs::msg::Pose> & poses, const double max_lateral_error);
+
+  /**
+   * @brief Simplify all linestrings of the road segments.
+   *
+   * @param road_segments The road segments (simplified in place).
+   * @param max_lateral_error The maximum lateral error in m (not simplified if not positive).
+   * @return The number of removed poses.
+   */
+  std::size_t Simplify(
+    autoware_mapless_planning_msgs::msg::RoadSegments & road_segments,
+    const double max_lateral_error);
+
+  /**
+   * @brief Get the number of input points of all calls.
+   */
+  std::uint64_t GetInputPointCount() const { return n_points_input_; }
+
+  /**
+   * @brief Get the number of output points of all calls.
+   */
+  std::uint64_t GetOutputPointCount() const { return n_points_output_; }
+
+  /**
+   * @brief Get the share of the input points which were removed (0 without input points).
+   */
+  double GetReductionRatio() const
+  {
+    return n_points_input_ > 0 ? 1.0 - static_cast<double>(n_points_output_) /
+                                         static_cast<double>(n_points_input_)
+                               : 0.0;
+  }
+
+private:
+  // Build the hull tree of the first n_points points of x_ and y_
+  void BuildHullTree(const std::size_t n_points);
+
+  // Find the point of the range [first, last] with the largest projection onto (ux, uy)
+  std::size_t FindExtremePoint(
+    const std::size_t first, const std::size_t last, const double ux, const double uy) const;
+
+  // Same for the points of a node of the hull tree
+  std::size_t FindExtremePointOfNode(
+    const std::size_t level, const std::size_t node, const double ux, const double uy) const;
+
+  // Points of the polyline (reused)
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<std::uint8_t> is_kept_;
+
+  // Hull tree: the nodes of level l contain kBlockSize << l points (only complete nodes), the upper
+  // and the lower chain of the convex hull of a node (point indices sorted by x, then y) are stored
+  // at the index of its first point (reused)
+  std::vector<std::vector<std::uint32_t>> upper_chains_;
+  std::vector<std::vector<std::uint32_t>> lower_chains_;
+  std::vector<std::vector<std::uint32_t>> upper_sizes_;
+  std::vector<std::vector<std::uint32_t>> lower_sizes_;
+  std::size_t n_levels_ = 0;
+  std::vector<std::uint32_t> merged_;
+
+  // Ranges of points which are not processed yet (first and last index, reused)
+  std::vector<std::pair<std::size_t, std::size_t>> ranges_;
+
+  std::uint64_t n_points_input_ = 0;
+  std::uint64_t n_points_output_ = 0;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__POLYLINE_SIMPLIFIER_HPP_
@@ -0,0 +1,213 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__SMALL_VECTOR_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__SMALL_VECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Vector with inline storage for up to N elements and amortized O(1) insertion at both
+ * ends.
+ *
+ * The elements are stored in the inline buffer as long as they fit, only larger sequences are
+ * moved to the heap. Free space is kept on both sides of the stored range, so push_front() is
+ * as cheap as push_back() (like a deque, but contiguous). Restricted to trivially copyable types
+ * (e.g. lanelet indices).
+ *
+ * @tparam T The element type.
+ * @tparam N The inline capacity.
+ */
+template <typename T, std::size_t N>
+class SmallVector
+{
+  static_assert(std::is_trivially_copyable<T>::value, "SmallVector requires a trivial type");
+  static_assert(N > 0, "SmallVector requires an inline capacity > 0");
+
+public:
+  typedef T value_type;
+  typedef std::size_t size_type;
+  typedef T * iterator;
+  typedef const T * const_iterator;
+
+  SmallVector() = default;
+
+  SmallVector(std::initializer_list<T> values) { assign(values.begin(), values.end()); }
+
+  template <typename InputIt>
+  SmallVector(InputIt first, InputIt last)
+  {
+    assign(first, last);
+  }
+
+  SmallVector(const SmallVector & other) { assign(other.begin(), other.end()); }
+
+  SmallVector(SmallVector && other) noexcept { MoveFrom(other); }
+
+  SmallVector & operator=(const SmallVector & other)
+  {
+    if (this != &other) assign(other.begin(), other.end());
+    return *this;
+  }
+
+  SmallVector & operator=(SmallVector && other) noexcept
+  {
+    if (this != &other) {
+      heap_.reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  SmallVector & operator=(std::initializer_list<T> values)
+  {
+    assign(values.begin(), values.end());
+    return *this;
+  }
+
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last)
+  {
+    clear();
+    for (; first != last; ++first) push_back(*first);
+  }
+
+  // Element access
+  T & operator[](const size_type i) { return Data()[head_ + i]; }
+  const T & operator[](const size_type i) const { return Data()[head_ + i]; }
+  T & front() { return Data()[head_]; }
+  const T & front() const { return Data()[head_]; }
+  T & back() { return Data()[head_ + size_ - 1]; }
+  const T & back() const { return Data()[head_ + size_ - 1]; }
+  T * data() { return Data() + head_; }
+  const T * data() const { return Data() + head_; }
+
+  // Iterators
+  iterator begin() { return data(); }
+  iterator end() { return data() + size_; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+
+  // Capacity
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type capacity() const { return capacity_; }
+
+  /**
+   * @brief Check whether the elements are stored in the inline buffer.
+   */
+  bool is_inline() const { return !heap_; }
+
+  // Modifiers
+  void clear()
+  {
+    size_ = 0;
+    head_ = 0;
+  }
+
+  void push_back(const T & value)
+  {
+    if (head_ + size_ == capacity_) MakeRoom(false);
+    Data()[head_ + size_] = value;
+    size_++;
+  }
+
+  void push_front(const T & value)
+  {
+    if (head_ == 0) MakeRoom(true);
+    head_--;
+    Data()[head_] = value;
+    size_++;
+  }
+
+  void pop_back() { size_--; }
+
+  void pop_front()
+  {
+    head_++;
+    size_--;
+  }
+
+  bool operator==(const SmallVector & other) const
+  {
+    return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+  }
+
+  bool operator!=(const SmallVector & other) const { return !(*this == other); }
+
+private:
+  T * Data() { return heap_ ? heap_.get() : inline_; }
+  const T * Data() const { return heap_ ? heap_.get() : inline_; }
+
+  void MoveFrom(SmallVector & other)
+  {
+    if (other.heap_) {
+      // Take over the heap buffer
+      heap_ = std::move(other.heap_);
+      head_ = other.head_;
+    } else {
+      std::memcpy(inline_, other.inline_ + other.head_, other.size_ * sizeof(T));
+      head_ = 0;
+    }
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+
+    other.capacity_ = N;
+    other.size_ = 0;
+    other.head_ = 0;
+  }
+
+  /**
+   * @brief Create free space at the front (at_front = true) or at the back of the stored range,
+   * either by re-centering the elements in the current buffer or by moving them to a larger one.
+   */
+  void MakeRoom(const bool at_front)
+  {
+    size_type new_capacity = capacity_;
+    if (size_ == capacity_) new_capacity = 2 * capacity_;
+
+    // Split the free space between front and back (at least one slot on the requested side)
+    const size_type free_slots = new_capacity - size_;
+    const size_type new_head = at_front ? (free_slots + 1) / 2 : free_slots / 2;
+
+    if (new_capacity == capacity_) {
+      T * buffer = Data();
+      std::memmove(buffer + new_head, buffer + head_, size_ * sizeof(T));
+    } else {
+      std::unique_ptr<T[]> new_heap(new T[new_capacity]);
+      std::memcpy(new_heap.get() + new_head, Data() + head_, size_ * sizeof(T));
+      heap_ = std::move(new_heap);
+      capacity_ = new_capacity;
+    }
+    head_ = new_head;
+  }
+
+  T inline_[N];
+  std::unique_ptr<T[]> heap_;
+  size_type capacity_ = N;
+  size_type size_ = 0;
+  size_type head_ = 0;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__SMALL_VECTOR_HPP_
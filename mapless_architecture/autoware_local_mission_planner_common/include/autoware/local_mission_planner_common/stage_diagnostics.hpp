@@ -0,0 +1,36 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__STAGE_DIAGNOSTICS_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__STAGE_DIAGNOSTICS_HPP_
+
+#include "autoware/local_mission_planner_common/stage_profiler.hpp"
+#include "diagnostic_updater/diagnostic_status_wrapper.hpp"
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Diagnostic task: write the statistics of all called stages of a profiler to the
+ * diagnostic status and reset them (i.e. the values refer to the period of the diagnostic updater).
+ *
+ * @param profiler The stage profiler.
+ * @param stat The diagnostic status.
+ */
+void ProduceStageDiagnostics(
+  StageProfiler & profiler, diagnostic_updater::DiagnosticStatusWrapper & stat);
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__STAGE_DIAGNOSTICS_HPP_
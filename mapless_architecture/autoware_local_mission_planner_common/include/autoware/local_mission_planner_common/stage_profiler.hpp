@@ -0,0 +1,188 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__STAGE_PROFILER_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__STAGE_PROFILER_HPP_
+
+#include "autoware/local_mission_planner_common/trace_recorder.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Time the enclosing scope as the given stage of a StageProfiler and trace it.
+ *
+ * The timer is compiled out unless the code is compiled with MAPLESS_ENABLE_PROFILING (CMake
+ * option of this package, a public definition of its library). The begin and end trace events are
+ * recorded if tracing is enabled at runtime (see TraceRecorder), otherwise only a flag is checked.
+ */
+#define MAPLESS_PROFILE_STAGE_TRACE(profiler, stage) \
+  MAPLESS_TRACE_SCOPE(                               \
+    (profiler).GetCategory(), autoware::mapless_architecture::GetProfilingStageName(stage))
+#ifdef MAPLESS_ENABLE_PROFILING
+#define MAPLESS_PROFILE_STAGE_CONCAT_IMPL(a, b) a##b
+#define MAPLESS_PROFILE_STAGE_CONCAT(a, b) MAPLESS_PROFILE_STAGE_CONCAT_IMPL(a, b)
+#define MAPLESS_PROFILE_STAGE(profiler, stage)                                            \
+  MAPLESS_PROFILE_STAGE_TRACE(profiler, stage);                                           \
+  const autoware::mapless_architecture::ScopedStageTimer MAPLESS_PROFILE_STAGE_CONCAT( \
+    scoped_stage_timer_, __LINE__)(profiler, stage)
+#else
+#define MAPLESS_PROFILE_STAGE(profiler, stage) MAPLESS_PROFILE_STAGE_TRACE(profiler, stage)
+#endif
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Instrumented stages of the mission planner and the mission lane converter.
+ */
+enum ProfilingStage {
+  kStageConversion = 0,
+  kStagePredecessors,
+  kStageLaneCalculation,
+  kStageGoalChecks,
+  kStageCorridorBuild,
+  kStageHeading,
+  kStageTransform,
+  kStagePublish,
+  kStageVisualization,
+  kNumProfilingStages
+};
+
+/**
+ * @brief Get the name of a profiling stage (e.g. "lane calculation").
+ */
+const char * GetProfilingStageName(const ProfilingStage stage);
+
+/**
+ * @brief Check whether the profiling is compiled in (MAPLESS_ENABLE_PROFILING).
+ */
+constexpr bool IsProfilingEnabled()
+{
+#ifdef MAPLESS_ENABLE_PROFILING
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Get the number of heap allocations (operator new) of the calling thread.
+ *
+ * Allocations are only counted if the profiling is compiled in and the allocation counter library
+ * (autoware_local_mission_planner_common_allocation_counter, which replaces operator new) is
+ * preloaded with LD_PRELOAD, otherwise 0 is returned.
+ */
+std::uint64_t GetThreadAllocationCount();
+
+/**
+ * @brief Aggregated statistics of a stage.
+ */
+struct StageStatistics
+{
+  std::uint64_t calls = 0;
+  double total_ms = 0.0;
+  double max_ms = 0.0;
+  std::uint64_t allocations = 0;
+};
+
+/**
+ * @brief Aggregates the runtime, the number of calls and the number of heap allocations of the
+ * instrumented stages of a node (thread-safe, lock-free).
+ */
+class StageProfiler
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param category The category of the trace events of the stages, e.g. the node (must outlive
+   * the profiler, e.g. a string literal).
+   */
+  explicit StageProfiler(const char * category = "mapless") : category_(category) {}
+
+  const char * GetCategory() const { return category_; }
+
+  /**
+   * @brief Add a measurement of a stage.
+   *
+   * @param stage The stage.
+   * @param duration_ns The runtime in nanoseconds.
+   * @param allocations The number of heap allocations during the stage.
+   */
+  void Record(
+    const ProfilingStage stage, const std::uint64_t duration_ns, const std::uint64_t allocations);
+
+  /**
+   * @brief Get the statistics of a stage since the last reset.
+   */
+  StageStatistics GetStatistics(const ProfilingStage stage) const;
+
+  /**
+   * @brief Reset the statistics of all stages.
+   */
+  void Reset();
+
+private:
+  struct Counters
+  {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> total_ns{0};
+    std::atomic<std::uint64_t> max_ns{0};
+    std::atomic<std::uint64_t> allocations{0};
+  };
+
+  const char * category_;
+  std::array<Counters, kNumProfilingStages> counters_;
+};
+
+/**
+ * @brief RAII timer, records the runtime and the heap allocations of its scope in a
+ * StageProfiler (use MAPLESS_PROFILE_STAGE() to compile it out when profiling is disabled).
+ */
+class ScopedStageTimer
+{
+public:
+  ScopedStageTimer(StageProfiler & profiler, const ProfilingStage stage)
+  : profiler_(profiler),
+    stage_(stage),
+    allocations_start_(GetThreadAllocationCount()),
+    t_start_(std::chrono::steady_clock::now())
+  {
+  }
+
+  ~ScopedStageTimer()
+  {
+    const auto duration = std::chrono::steady_clock::now() - t_start_;
+    profiler_.Record(
+      stage_, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+      GetThreadAllocationCount() - allocations_start_);
+  }
+
+  ScopedStageTimer(const ScopedStageTimer &) = delete;
+  ScopedStageTimer & operator=(const ScopedStageTimer &) = delete;
+
+private:
+  StageProfiler & profiler_;
+  const ProfilingStage stage_;
+  const std::uint64_t allocations_start_;
+  const std::chrono::steady_clock::time_point t_start_;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__STAGE_PROFILER_HPP_
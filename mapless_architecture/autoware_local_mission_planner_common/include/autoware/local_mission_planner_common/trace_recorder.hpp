@@ -0,0 +1,169 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__TRACE_RECORDER_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__TRACE_RECORDER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Record a begin and an end trace event for the enclosing scope (only if tracing is
+ * enabled at runtime, see TraceRecorder).
+ *
+ * @param category The category of the event, e.g. the node (string literal).
+ * @param name The name of the event, e.g. the processing stage (string literal).
+ */
+#define MAPLESS_TRACE_SCOPE_CONCAT_IMPL(a, b) a##b
+#define MAPLESS_TRACE_SCOPE_CONCAT(a, b) MAPLESS_TRACE_SCOPE_CONCAT_IMPL(a, b)
+#define MAPLESS_TRACE_SCOPE(category, name)                                               \
+  const autoware::mapless_architecture::ScopedTraceEvent MAPLESS_TRACE_SCOPE_CONCAT( \
+    scoped_trace_event_, __LINE__)(category, name)
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief A begin ('B') or end ('E') event of a traced scope.
+ */
+struct TraceEvent
+{
+  const char * category;
+  const char * name;
+  std::uint64_t timestamp_ns;
+  std::uint32_t thread_id;
+  char phase;
+};
+
+/**
+ * @brief Process-wide recorder of trace events, which can be written as a Chrome trace JSON file
+ * (viewable in chrome://tracing or Perfetto).
+ *
+ * Each thread writes its events into its own ring buffer without locks (single producer, the
+ * reader only synchronizes with atomic indices). If a ring buffer is full, the oldest events are
+ * overwritten. The ring buffer of a thread is kept when the thread exits (its events are still
+ * dumped), but only the rings of the latest kMaxFinishedThreadRings exited threads are kept, older
+ * ones are released (e.g. for threads of worker pools which are created per batch). Timestamps are
+ * taken from the monotonic clock, so traces of different processes on the same machine share a
+ * common time base.
+ */
+class TraceRecorder
+{
+public:
+  /**
+   * @brief Number of events stored per thread.
+   */
+  static constexpr std::size_t kRingCapacity = 1 << 14;
+
+  /**
+   * @brief Number of ring buffers of exited threads which are kept.
+   */
+  static constexpr std::size_t kMaxFinishedThreadRings = 8;
+
+  /**
+   * @brief Get the recorder of the process.
+   */
+  static TraceRecorder & Instance();
+
+  void SetEnabled(const bool enabled);
+  bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Record an event of the calling thread.
+   *
+   * @param category The category of the event (must outlive the recorder, e.g. a string literal).
+   * @param name The name of the event (must outlive the recorder, e.g. a string literal).
+   * @param phase 'B' (begin) or 'E' (end).
+   */
+  void Record(const char * category, const char * name, const char phase);
+
+  /**
+   * @brief Return the recorded events without removing them from the ring buffers (e.g. for the
+   * trace dumps of several nodes of a process).
+   */
+  std::vector<TraceEvent> Snapshot();
+
+  /**
+   * @brief Get the number of events which were overwritten in full ring buffers or released with
+   * the ring buffers of exited threads.
+   */
+  std::uint64_t GetOverwrittenEventCount() const;
+
+  /**
+   * @brief Write all recorded events to a Chrome trace JSON file (see Snapshot(), the events are
+   * not removed).
+   *
+   * @param file_path The path of the output file.
+   * @return The number of written events, -1 if the file could not be written.
+   */
+  std::int64_t WriteChromeTrace(const std::string & file_path);
+
+private:
+  class ThreadRing;
+
+  TraceRecorder() = default;
+
+  ThreadRing & GetThreadRing();
+
+  /**
+   * @brief Move the ring buffer of an exiting thread to the finished rings (called on thread exit).
+   */
+  void ReleaseThreadRing(const ThreadRing * ring);
+
+  std::atomic<bool> enabled_{false};
+
+  // Registered ring buffers, the mutex is only locked when a thread records its first event or
+  // exits and when the events are copied
+  mutable std::mutex rings_mutex_;
+  std::vector<std::shared_ptr<ThreadRing>> rings_;
+  std::vector<std::shared_ptr<ThreadRing>> finished_rings_;  // oldest first
+  std::uint32_t next_thread_id_ = 1;
+  std::uint64_t released_events_ = 0;
+};
+
+/**
+ * @brief RAII trace scope, records a begin event on construction and an end event on destruction
+ * if tracing is enabled (use MAPLESS_TRACE_SCOPE()).
+ */
+class ScopedTraceEvent
+{
+public:
+  ScopedTraceEvent(const char * category, const char * name)
+  : category_(category), name_(name), is_recorded_(TraceRecorder::Instance().IsEnabled())
+  {
+    if (is_recorded_) TraceRecorder::Instance().Record(category_, name_, 'B');
+  }
+
+  ~ScopedTraceEvent()
+  {
+    if (is_recorded_) TraceRecorder::Instance().Record(category_, name_, 'E');
+  }
+
+  ScopedTraceEvent(const ScopedTraceEvent &) = delete;
+  ScopedTraceEvent & operator=(const ScopedTraceEvent &) = delete;
+
+private:
+  const char * category_;
+  const char * name_;
+  const bool is_recorded_;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__TRACE_RECORDER_HPP_
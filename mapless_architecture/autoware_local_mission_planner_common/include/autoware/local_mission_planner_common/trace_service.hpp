@@ -0,0 +1,39 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__TRACE_SERVICE_HPP_
+#define AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__TRACE_SERVICE_HPP_
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "std_srvs/srv/trigger.hpp"
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Declare the tracing parameters of a node and create its trace dump service.
+ *
+ * Parameters: enable_tracing (bool, enables the TraceRecorder of the process) and
+ * trace_output_directory (string). A call of the service ~/dump_trace writes all events
+ * recorded so far to <trace_output_directory>/<node name>_trace_<time stamp>.json.
+ *
+ * @param node The node.
+ * @return The service.
+ */
+rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr CreateTraceDumpService(rclcpp::Node & node);
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__LOCAL_MISSION_PLANNER_COMMON__TRACE_SERVICE_HPP_
@@ -0,0 +1,54 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Allocation counter of the stage profiling: replaces the global operator new and delete of the
+// process, therefore it is a separate library which is only loaded on request with LD_PRELOAD (it
+// is not linked by any library or node). GetThreadAllocationCount() of the stage profiler reads
+// the count through mapless_get_thread_allocation_count().
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+// Number of heap allocations of the current thread
+thread_local std::uint64_t thread_allocation_count = 0;
+}  // namespace
+
+extern "C" std::uint64_t mapless_get_thread_allocation_count()
+{
+  return thread_allocation_count;
+}
+
+// The default operator new[] and the nothrow variants forward to this operator new
+void * operator new(std::size_t size)
+{
+  thread_allocation_count++;
+  if (size == 0) size = 1;
+  void * ptr = std::malloc(size);
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
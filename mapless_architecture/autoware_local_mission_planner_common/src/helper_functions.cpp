@@ -14,7 +14,15 @@
 
 #include "autoware/local_mission_planner_common/helper_functions.hpp"
 
+#include "autoware/local_mission_planner_common/corridor_emitter.hpp"
 #include "lanelet2_core/geometry/Lanelet.h"
+#include "tf2/LinearMath/Matrix3x3.h"
+#include "tf2/LinearMath/Quaternion.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
 
 namespace autoware::mapless_architecture
 {
@@ -33,33 +41,89 @@ double NormalizePsi(const double psi)
   return psi_out;
 }
 
+namespace
+{
+// Branch-free atan2 approximation, kept inline so that loops calling it can be vectorized. The
+// coefficients are a minimax fit of atan(z) / z in z^2 on [0, 1].
+inline double FastAtan2Kernel(const double y, const double x)
+{
+  const double abs_x = std::fabs(x);
+  const double abs_y = std::fabs(y);
+  const double max_xy = abs_x > abs_y ? abs_x : abs_y;
+  const double min_xy = abs_x > abs_y ? abs_y : abs_x;
+
+  // Reduce argument to [0, 1] (atan2(0, 0) results in 0 / 1 = 0)
+  const double z = min_xy / (max_xy > 0.0 ? max_xy : 1.0);
+  const double z2 = z * z;
+
+  double a = -0.0040545627553328556;
+  a = a * z2 + 0.021862942624744249;
+  a = a * z2 - 0.055912306174857131;
+  a = a * z2 + 0.096421959379753341;
+  a = a * z2 - 0.13908629061921332;
+  a = a * z2 + 0.19946565567791522;
+  a = a * z2 - 0.33329860778737902;
+  a = a * z2 + 0.99999933557768483;
+  a = a * z;
+
+  // Undo argument reduction
+  a = abs_y > abs_x ? M_PI_2 - a : a;
+  a = x < 0.0 ? M_PI - a : a;
+  return y < 0.0 ? -a : a;
+}
+
+// Restrict an angle in [-pi, pi] to [-pi, pi[ (same convention as NormalizePsi())
+inline double WrapPi(const double psi)
+{
+  return psi >= M_PI ? psi - 2.0 * M_PI : psi;
+}
+}  // namespace
+
+double FastAtan2(const double y, const double x)
+{
+  return FastAtan2Kernel(y, x);
+}
+
 std::vector<double> GetPsiForPoints(const std::vector<geometry_msgs::msg::Point> & points)
 {
-  int num_points = points.size();
-  std::vector<double> tang_vecs(num_points * 2);
+  const std::size_t num_points = points.size();
+
+  // Split points into separate x and y arrays (the z value is not needed)
+  std::vector<double> x(num_points);
+  std::vector<double> y(num_points);
+  for (std::size_t i = 0; i < num_points; i++) {
+    x[i] = points[i].x;
+    y[i] = points[i].y;
+  }
+
+  std::vector<double> psi_points(num_points);
+  GetPsiForPoints(x.data(), y.data(), num_points, psi_points.data());
 
-  // Get heading vector for first point
-  tang_vecs[0] = points[1].x - points[0].x;
-  tang_vecs[1] = points[1].y - points[0].y;
+  return psi_points;
+}
 
-  // Use one point before and after the targeted one for heading vector (more
-  // stable/robust than relying on a single pair of points)
-  for (int i = 1; i < num_points - 1; i++) {
-    tang_vecs[2 * i] = points[i + 1].x - points[i - 1].x;
-    tang_vecs[2 * i + 1] = points[i + 1].y - points[i - 1].y;
+void GetPsiForPoints(
+  const double * x, const double * y, const std::size_t num_points, double * psi_out)
+{
+  if (num_points == 0) return;
+
+  if (num_points == 1) {
+    psi_out[0] = 0.0;
+    return;
   }
 
-  // Get heading vector for last point
-  tang_vecs[2 * (num_points - 1)] = points[num_points - 1].x - points[num_points - 2].x;
-  tang_vecs[2 * (num_points - 1) + 1] = points[num_points - 1].y - points[num_points - 2].y;
+  // Get heading for first point
+  psi_out[0] = WrapPi(FastAtan2Kernel(y[1] - y[0], x[1] - x[0]));
 
-  // Calculate heading angles with atan2
-  std::vector<double> psi_points(num_points);
-  for (int i = 0; i < num_points; i++) {
-    psi_points[i] = NormalizePsi(std::atan2(tang_vecs[2 * i + 1], tang_vecs[2 * i]));
+  // Use one point before and after the targeted one for heading vector (more
+  // stable/robust than relying on a single pair of points)
+  for (std::size_t i = 1; i < num_points - 1; i++) {
+    psi_out[i] = WrapPi(FastAtan2Kernel(y[i + 1] - y[i - 1], x[i + 1] - x[i - 1]));
   }
 
-  return psi_points;
+  // Get heading for last point
+  const std::size_t i_last = num_points - 1;
+  psi_out[i_last] = WrapPi(FastAtan2Kernel(y[i_last] - y[i_last - 1], x[i_last] - x[i_last - 1]));
 }
 
 Pose2D::Pose2D()
@@ -148,7 +212,7 @@ double GetYawFromQuaternion(const double x, const double y, const double z, cons
   return yaw;
 }
 
-std::vector<std::vector<int>> GetAllSuccessorSequences(
+std::vector<LaneIndices> GetAllSuccessorSequences(
   const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet)
 {
   AdjacentLaneType adjacent_lane_type = AdjacentLaneType::kSuccessors;
@@ -156,24 +220,25 @@ std::vector<std::vector<int>> GetAllSuccessorSequences(
   return GetAllLaneletSequences(lanelet_connections, id_initial_lanelet, adjacent_lane_type);
 }
 
-std::vector<std::vector<int>> GetAllLaneletSequences(
+std::vector<LaneIndices> GetAllLaneletSequences(
   const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet,
   const AdjacentLaneType adjacent_lane_type)
 {
   // Initialize helper variables
   bool do_include_navigation_info = false;
 
-  std::vector<int> lanelets_already_visited;
-  std::vector<int> lanelet_id_sequence_temp{id_initial_lanelet};
+  // Visited flags indexed by the lanelet ID (O(1) lookup instead of a search in a visited list)
+  std::vector<bool> lanelets_already_visited(lanelet_connections.size(), false);
+  LaneIndices lanelet_id_sequence_temp{id_initial_lanelet};
 
-  std::vector<std::vector<int>> lanelet_sequences;
+  std::vector<LaneIndices> lanelet_sequences;
 
   // Loop as long as all successors of the initial lanelet have been searched
   // maximum iteration depth is (number_of_lanelets - 1) * 2
   for (size_t i = 0; i < lanelet_connections.size() * 2; i++) {
     // IDs which are relevant for searching adjacent lanelets (either successors
     // or predecessors)
-    std::vector<int> ids_adjacent_lanelets;
+    LaneIndices ids_adjacent_lanelets;
 
     if (adjacent_lane_type == AdjacentLaneType::kPredecessors) {
       ids_adjacent_lanelets =
@@ -183,7 +248,7 @@ std::vector<std::vector<int>> GetAllLaneletSequences(
         lanelet_connections[lanelet_id_sequence_temp.back()].successor_lanelet_ids;
     }
 
-    const std::vector<int> ids_relevant_adjacent_lanelets = GetRelevantAdjacentLanelets(
+    const LaneIndices ids_relevant_adjacent_lanelets = GetRelevantAdjacentLanelets(
       lanelet_connections, ids_adjacent_lanelets, do_include_navigation_info);
 
     auto [lanelet_id_sequence_completed, do_exit_outer_for_loop] = GetCompletedLaneletSequence(
@@ -194,17 +259,18 @@ std::vector<std::vector<int>> GetAllLaneletSequences(
 
     // Store returned complete lanelet id sequence
     if (!lanelet_id_sequence_completed.empty()) {
-      lanelet_sequences.push_back(lanelet_id_sequence_completed);
+      lanelet_sequences.push_back(std::move(lanelet_id_sequence_completed));
     }
   }
   return lanelet_sequences;
 }
 
-std::vector<int> GetRelevantAdjacentLanelets(
+LaneIndices GetRelevantAdjacentLanelets(
   const std::vector<LaneletConnection> & lanelet_connections,
-  const std::vector<int> ids_adjacent_lanelets, const bool do_include_navigation_info)
+  const LaneIndices & ids_adjacent_lanelets, const bool do_include_navigation_info)
 {
-  std::vector<int> ids_relevant_successors;
+  assert(!ids_adjacent_lanelets.empty());
+  LaneIndices ids_relevant_successors;
 
   // Return all successors if navigation info is not relevant
   if (do_include_navigation_info) {
@@ -223,21 +289,19 @@ std::vector<int> GetRelevantAdjacentLanelets(
       ids_relevant_successors.push_back(-1);
     }
   } else {
+    // Not empty ({-1} if there are no adjacent lanelets, see NormalizeLaneletConnections())
     ids_relevant_successors = ids_adjacent_lanelets;
   }
 
-  if (ids_relevant_successors.empty()) {
-    ids_relevant_successors.push_back(-1);
-  }
-
   return ids_relevant_successors;
 }
 
-std::tuple<std::vector<int>, bool> GetCompletedLaneletSequence(
-  std::vector<int> & lanelet_id_sequence_current, std::vector<int> & lanelets_already_visited,
-  const std::vector<int> ids_relevant_lanelets, const int id_initial_lanelet)
+std::tuple<LaneIndices, bool> GetCompletedLaneletSequence(
+  LaneIndices & lanelet_id_sequence_current, std::vector<bool> & lanelets_already_visited,
+  const LaneIndices & ids_relevant_lanelets, const int id_initial_lanelet)
 {
-  std::vector<int> lanelet_id_sequence_completed;
+  assert(!lanelet_id_sequence_current.empty() && !ids_relevant_lanelets.empty());
+  LaneIndices lanelet_id_sequence_completed;
   bool do_exit_outer_for_loop = false;
 
   // Check if an adjacent lanelet is even available
@@ -247,11 +311,9 @@ std::tuple<std::vector<int>, bool> GetCompletedLaneletSequence(
     // Loop though all relevant adjacent IDs and check whether or not they
     // have already been visited
     for (const int & successor_id : ids_relevant_lanelets) {
-      if (
-        std::find(lanelets_already_visited.begin(), lanelets_already_visited.end(), successor_id) ==
-        lanelets_already_visited.end()) {
-        // Add new ID to already visited vector
-        lanelets_already_visited.push_back(successor_id);
+      if (!lanelets_already_visited[successor_id]) {
+        // Mark the new ID as visited
+        lanelets_already_visited[successor_id] = true;
         // Add currently visited ID to temporary adjacent lanelet sequence
         lanelet_id_sequence_current.push_back(successor_id);
         has_relevant_successor = true;
@@ -287,12 +349,12 @@ std::tuple<std::vector<int>, bool> GetCompletedLaneletSequence(
   return {lanelet_id_sequence_completed, do_exit_outer_for_loop};
 }
 
-std::vector<int> GetAllNeighboringLaneletIDs(
+LaneIndices GetAllNeighboringLaneletIDs(
   const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet,
   const VehicleSide side)
 {
   int id_current_lanelet = id_initial_lanelet;
-  std::vector<int> lanelet_id_neighbors;
+  LaneIndices lanelet_id_neighbors;
 
   // This function is only intended to return all neighboring lanelets, not only
   // the ones leading towards goal. Therefore, this flag is set false for the
@@ -375,7 +437,7 @@ int GetNeighboringLaneletID(
   return id_neighbor_lanelet;
 }
 
-std::vector<std::vector<int>> GetAllPredecessorSequences(
+std::vector<LaneIndices> GetAllPredecessorSequences(
   const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet)
 {
   AdjacentLaneType adjacent_lane_type = AdjacentLaneType::kPredecessors;
@@ -408,14 +470,21 @@ int FindEgoOccupiedLaneletID(const std::vector<lanelet::Lanelet> & lanelets)
 
 lanelet::BasicPoint2d RecenterGoalPoint(
   const lanelet::BasicPoint2d & goal_point, const std::vector<lanelet::Lanelet> & road_model)
+{
+  // Get current lanelet index of goal point
+  return RecenterGoalPoint(goal_point, road_model, FindOccupiedLaneletID(road_model, goal_point));
+}
+
+lanelet::BasicPoint2d RecenterGoalPoint(
+  const lanelet::BasicPoint2d & goal_point, const std::vector<lanelet::Lanelet> & road_model,
+  const int lanelet_idx_goal_point)
 {
   // Return value
   lanelet::BasicPoint2d projected_goal_point;
 
-  // Get current lanelet index of goal point
-  const int lanelet_idx_goal_point = FindOccupiedLaneletID(road_model, goal_point);
-
-  if (lanelet_idx_goal_point >= 0) {
+  if (
+    lanelet_idx_goal_point >= 0 &&
+    static_cast<std::size_t>(lanelet_idx_goal_point) < road_model.size()) {
     // Get the centerline of the goal point's lanelet
     lanelet::ConstLineString2d centerline_curr_lanelet =
       road_model[lanelet_idx_goal_point].centerline2d();
@@ -437,21 +506,16 @@ visualization_msgs::msg::MarkerArray CreateMarkerArray(
   const autoware_mapless_planning_msgs::msg::RoadSegments & msg)
 {
   visualization_msgs::msg::MarkerArray markerArray;
+  markerArray.markers.reserve(centerline.size() + left.size() + right.size());
 
   // Centerline
   for (size_t i = 0; i < centerline.size(); ++i) {
     visualization_msgs::msg::Marker marker;  // Create a new marker in each iteration
 
     // Adding points to the marker
-    for (const auto & point : centerline[i]) {
-      geometry_msgs::msg::Point p;
-
-      p.x = point.x();
-      p.y = point.y();
-      p.z = point.z();
-
-      marker.points.push_back(p);
-    }
+    marker.points.reserve(centerline[i].size());
+    EmitCorridorPoints(
+      centerline[i], 1, AcceptAllCorridorPoints(), MakeCorridorSink(marker.points));
     markerArray.markers.push_back(marker);
   }
 
@@ -471,15 +535,8 @@ visualization_msgs::msg::MarkerArray CreateMarkerArray(
     marker.color.a = 1.0;  // Full opacity
 
     // Adding points to the marker
-    for (const auto & point : left[i]) {
-      geometry_msgs::msg::Point p;
-
-      p.x = point.x();
-      p.y = point.y();
-      p.z = point.z();
-
-      marker.points.push_back(p);
-    }
+    marker.points.reserve(left[i].size());
+    EmitCorridorPoints(left[i], 1, AcceptAllCorridorPoints(), MakeCorridorSink(marker.points));
     markerArray.markers.push_back(marker);
   }
 
@@ -499,72 +556,376 @@ visualization_msgs::msg::MarkerArray CreateMarkerArray(
     marker.color.a = 1.0;  // Full opacity
 
     // Adding points to the marker
-    for (const auto & point : right[i]) {
-      geometry_msgs::msg::Point p;
-
-      p.x = point.x();
-      p.y = point.y();
-      p.z = point.z();
-
-      marker.points.push_back(p);
-    }
+    marker.points.reserve(right[i].size());
+    EmitCorridorPoints(right[i], 1, AcceptAllCorridorPoints(), MakeCorridorSink(marker.points));
     markerArray.markers.push_back(marker);
   }
 
   return markerArray;
 }
 
-autoware_mapless_planning_msgs::msg::DrivingCorridor CreateDrivingCorridor(
-  const std::vector<int> & lane, const std::vector<lanelet::Lanelet> & converted_lanelets)
+namespace
 {
-  // Create driving corridor
-  autoware_mapless_planning_msgs::msg::DrivingCorridor driving_corridor;
 
-  for (int id : lane) {
-    if (id >= 0) {
-      auto current_lanelet = converted_lanelets.at(id);
+// Normalized arc length (x-y plane) of the points of a linestring (uniform if it has no length)
+void GetNormalizedArcLength(const lanelet::ConstLineString3d & linestring, std::vector<double> & t)
+{
+  const std::size_t n_points = linestring.size();
+  t.resize(n_points);
+  if (n_points == 0) return;
+
+  t[0] = 0.0;
+  for (std::size_t i = 1; i < n_points; i++) {
+    t[i] = t[i - 1] + std::hypot(
+                        linestring[i].x() - linestring[i - 1].x(),
+                        linestring[i].y() - linestring[i - 1].y());
+  }
+
+  const double length = t.back();
+  const double n_segments = static_cast<double>(n_points - 1);
+  for (std::size_t i = 1; i < n_points; i++) {
+    t[i] = length > 0.0 ? t[i] / length : static_cast<double>(i) / n_segments;
+  }
+}
 
-      auto centerline = current_lanelet.centerline();
-      auto bound_left = current_lanelet.leftBound();
-      auto bound_right = current_lanelet.rightBound();
+// Point of a linestring at a normalized arc length, i_next is the index of the first point with a
+// normalized arc length not smaller than t
+lanelet::BasicPoint3d InterpolateNormalized(
+  const lanelet::ConstLineString3d & linestring, const std::vector<double> & t_points,
+  const std::size_t i_next, const double t)
+{
+  if (i_next == 0) return linestring[0].basicPoint();
+  if (i_next >= t_points.size()) return linestring[t_points.size() - 1].basicPoint();
+
+  const double dt = t_points[i_next] - t_points[i_next - 1];
+  const double w = dt > 0.0 ? (t - t_points[i_next - 1]) / dt : 1.0;
+  const lanelet::BasicPoint3d p0 = linestring[i_next - 1].basicPoint();
+  const lanelet::BasicPoint3d p1 = linestring[i_next].basicPoint();
+  return p0 + w * (p1 - p0);
+}
 
-      // Adding elements of centerline
-      for (const auto & point : centerline) {
-        geometry_msgs::msg::Point p;
+// Visit the merged normalized arc lengths of both bounds (points at the same arc length are
+// merged), the visitor gets the normalized arc length and the indices of the first points of the
+// bounds with a normalized arc length not smaller than it
+template <typename VisitorT>
+void ForEachPairedBoundParameter(
+  const std::vector<double> & t_left, const std::vector<double> & t_right, const VisitorT & visitor)
+{
+  const double t_tolerance = 1e-9;
+  std::size_t i_left = 0;
+  std::size_t i_right = 0;
+  while (i_left < t_left.size() || i_right < t_right.size()) {
+    const double t = std::min(
+      i_left < t_left.size() ? t_left[i_left] : 1.0,
+      i_right < t_right.size() ? t_right[i_right] : 1.0);
+    visitor(t, i_left, i_right);
+
+    while (i_left < t_left.size() && t_left[i_left] <= t + t_tolerance) i_left++;
+    while (i_right < t_right.size() && t_right[i_right] <= t + t_tolerance) i_right++;
+  }
+}
 
-        p.x = point.x();
-        p.y = point.y();
-        p.z = point.z();
+// Linestrings of a driving corridor
+enum class CorridorLineString { kCenterline, kBoundLeft, kBoundRight };
 
-        driving_corridor.centerline.push_back(p);
-      }
+lanelet::ConstLineString3d GetCorridorLineString(
+  const lanelet::Lanelet & lanelet, const CorridorLineString type)
+{
+  switch (type) {
+    case CorridorLineString::kBoundLeft:
+      return lanelet.leftBound();
+    case CorridorLineString::kBoundRight:
+      return lanelet.rightBound();
+    default:
+      return lanelet.centerline();
+  }
+}
 
-      // Adding elements of bound_left
-      for (const auto & point : bound_left) {
-        geometry_msgs::msg::Point p;
+// Cross-section parameter of the points of a linestring of a lanelet: the normalized arc length for
+// the bounds and, for the centerline, the normalized arc length of the bounds it was paired from
+// (see CreatePairedBoundCenterline(), its own normalized arc length for other centerlines), i.e.
+// the points of all three linestrings at the same parameter are on the same cross-section
+void GetCrossSectionParameters(
+  const lanelet::Lanelet & lanelet, const CorridorLineString type, std::vector<double> & t)
+{
+  const lanelet::ConstLineString3d linestring = GetCorridorLineString(lanelet, type);
+  if (type == CorridorLineString::kCenterline && !linestring.empty()) {
+    std::vector<double> t_left;
+    std::vector<double> t_right;
+    GetNormalizedArcLength(lanelet.leftBound(), t_left);
+    GetNormalizedArcLength(lanelet.rightBound(), t_right);
+    t.clear();
+    ForEachPairedBoundParameter(
+      t_left, t_right, [&t](const double t_paired, std::size_t, std::size_t) {
+        t.push_back(t_paired);
+      });
+    if (t.size() == linestring.size()) return;
+  }
+  GetNormalizedArcLength(linestring, t);
+}
 
-        p.x = point.x();
-        p.y = point.y();
-        p.z = point.z();
+// Cross-section of a lane: position of the lanelet in the lane and cross-section parameter within
+// the lanelet (see GetCrossSectionParameters())
+struct LaneCrossSection
+{
+  std::size_t position = 0;
+  double t = 0.0;
+};
+
+// Cross-sections of the lane at the ends of the horizon: the vehicle (at (0, 0)) is projected onto
+// the concatenated centerline once, the horizon is measured along the centerline from there
+bool GetHorizonCrossSections(
+  const LaneIndices & lane, const std::vector<lanelet::Lanelet> & converted_lanelets,
+  const CorridorHorizon & horizon, LaneCrossSection & begin, LaneCrossSection & end)
+{
+  // Visit the segments of the concatenated centerline (incl. the gaps between the lanelets, which
+  // are assigned to the following lanelet), the visitor gets the position of the lanelet, the index
+  // of the end point of the segment (0 for a gap), the end points and returns false to stop
+  const auto for_each_segment = [&](const auto & visitor) {
+    bool has_previous = false;
+    lanelet::BasicPoint3d previous;
+    for (std::size_t position = 0; position < lane.size(); position++) {
+      if (lane[position] < 0) continue;
+      const lanelet::ConstLineString3d centerline =
+        converted_lanelets.at(lane[position]).centerline();
+      for (std::size_t i = 0; i < centerline.size(); i++) {
+        const lanelet::BasicPoint3d current = centerline[i].basicPoint();
+        if (has_previous && !visitor(position, i, previous, current)) return;
+        has_previous = true;
+        previous = current;
+      }
+    }
+  };
+
+  // Arc length of the projection of the vehicle onto the concatenated centerline
+  bool has_points = false;
+  double s_vehicle = 0.0;
+  double s_total = 0.0;
+  double distance_squared_min = std::numeric_limits<double>::max();
+  std::size_t position_first = 0;
+  std::size_t position_last = 0;
+  for (std::size_t position = 0; position < lane.size(); position++) {
+    if (lane[position] < 0 || converted_lanelets.at(lane[position]).centerline().empty()) continue;
+    if (!has_points) {
+      const lanelet::ConstPoint3d first = converted_lanelets.at(lane[position]).centerline()[0];
+      distance_squared_min = first.x() * first.x() + first.y() * first.y();
+      position_first = position;
+    }
+    has_points = true;
+    position_last = position;
+  }
+  if (!has_points) return false;
+
+  for_each_segment([&](
+                     std::size_t, std::size_t, const lanelet::BasicPoint3d & previous,
+                     const lanelet::BasicPoint3d & current) {
+    const double dx = current.x() - previous.x();
+    const double dy = current.y() - previous.y();
+    const double length_squared = dx * dx + dy * dy;
+    const double t =
+      length_squared > 0.0
+        ? std::clamp(-(previous.x() * dx + previous.y() * dy) / length_squared, 0.0, 1.0)
+        : 0.0;
+    const double x_projected = previous.x() + t * dx;
+    const double y_projected = previous.y() + t * dy;
+    const double distance_squared = x_projected * x_projected + y_projected * y_projected;
+    const double length = std::sqrt(length_squared);
+    if (distance_squared < distance_squared_min) {
+      distance_squared_min = distance_squared;
+      s_vehicle = s_total + t * length;
+    }
+    s_total += length;
+    return true;
+  });
+
+  // Cross-section at an arc length of the centerline (clamped to the lane)
+  std::vector<double> t_centerline;
+  const auto locate = [&](const double s_cut, const bool is_begin) {
+    LaneCrossSection cross_section;
+    if (s_cut <= 0.0 && is_begin) {
+      cross_section.position = position_first;
+      cross_section.t = 0.0;
+      return cross_section;
+    }
+    cross_section.position = position_last;
+    cross_section.t = 1.0;
+
+    double s = 0.0;
+    for_each_segment([&](
+                       const std::size_t position, const std::size_t i,
+                       const lanelet::BasicPoint3d & previous,
+                       const lanelet::BasicPoint3d & current) {
+      const double length = std::hypot(current.x() - previous.x(), current.y() - previous.y());
+      if (s + length < s_cut) {
+        s += length;
+        return true;
+      }
 
-        driving_corridor.bound_left.push_back(p);
+      // The cut is in a gap between two lanelets: start of the following lanelet
+      cross_section.position = position;
+      if (i == 0) {
+        cross_section.t = 0.0;
+        return false;
       }
+      const double w = length > 0.0 ? (s_cut - s) / length : 1.0;
+      GetCrossSectionParameters(
+        converted_lanelets.at(lane[position]), CorridorLineString::kCenterline, t_centerline);
+      cross_section.t = t_centerline[i - 1] + w * (t_centerline[i] - t_centerline[i - 1]);
+      return false;
+    });
+    return cross_section;
+  };
+
+  begin = locate(
+    horizon.backward >= 0.0 ? s_vehicle - horizon.backward : std::numeric_limits<double>::lowest(),
+    true);
+  end = locate(
+    horizon.forward >= 0.0 ? s_vehicle + horizon.forward : std::numeric_limits<double>::max(),
+    false);
+  return true;
+}
 
-      // Adding elements of bound_right
-      for (const auto & point : bound_right) {
-        geometry_msgs::msg::Point p;
+// Add every step-th point (and the last point of each lanelet) of a linestring of a lane between
+// two cross-sections, the points at the cross-sections are interpolated
+void AddCroppedLanePoints(
+  const LaneIndices & lane, const std::vector<lanelet::Lanelet> & converted_lanelets,
+  const CorridorLineString type, const std::size_t step, const LaneCrossSection & begin,
+  const LaneCrossSection & end, std::vector<geometry_msgs::msg::Point> & points)
+{
+  // Skip points equal to the last added point (the cut or the shared end point of consecutive
+  // lanelets)
+  const auto add_point = [&points](const lanelet::BasicPoint3d & point) {
+    if (
+      !points.empty() && points.back().x == point.x() && points.back().y == point.y() &&
+      points.back().z == point.z()) {
+      return;
+    }
+    geometry_msgs::msg::Point p;
+    p.x = point.x();
+    p.y = point.y();
+    p.z = point.z();
+    points.push_back(p);
+  };
+
+  std::vector<double> t;
+  for (std::size_t position = begin.position; position <= end.position; position++) {
+    if (lane[position] < 0) continue;
+    const lanelet::Lanelet & lanelet = converted_lanelets.at(lane[position]);
+    const lanelet::ConstLineString3d linestring = GetCorridorLineString(lanelet, type);
+    const std::size_t n_points = linestring.size();
+    if (n_points == 0) continue;
+
+    // The parameters are only required for the lanelets at the cross-sections
+    const bool is_begin = position == begin.position;
+    const bool is_end = position == end.position;
+    if (is_begin || is_end) GetCrossSectionParameters(lanelet, type, t);
+    const auto interpolate = [&](const double t_cut) {
+      const std::size_t i_next = std::lower_bound(t.begin(), t.end(), t_cut) - t.begin();
+      return InterpolateNormalized(linestring, t, i_next, t_cut);
+    };
+
+    if (is_begin) add_point(interpolate(begin.t));
+    for (std::size_t i = 0; i < n_points; i++) {
+      if (is_begin && t[i] <= begin.t) continue;
+      if (is_end && t[i] >= end.t) break;
+      if (i % step == 0 || i == n_points - 1) add_point(linestring[i].basicPoint());
+    }
+    if (is_end) add_point(interpolate(end.t));
+  }
+}
 
-        p.x = point.x();
-        p.y = point.y();
-        p.z = point.z();
+}  // namespace
 
-        driving_corridor.bound_right.push_back(p);
-      }
+autoware_mapless_planning_msgs::msg::DrivingCorridor CreateDrivingCorridor(
+  const LaneIndices & lane, const std::vector<lanelet::Lanelet> & converted_lanelets,
+  const int point_step, const CorridorHorizon & horizon)
+{
+  // Create driving corridor
+  autoware_mapless_planning_msgs::msg::DrivingCorridor driving_corridor;
+
+  const std::size_t step = point_step > 1 ? point_step : 1;
+
+  // Crop the linestrings to the horizon while they are added (the lanelets ahead of the horizon
+  // are not visited), all linestrings are cut at the same cross-sections of the lane
+  if (horizon.IsBounded()) {
+    LaneCrossSection begin;
+    LaneCrossSection end;
+    if (!GetHorizonCrossSections(lane, converted_lanelets, horizon, begin, end)) {
+      return driving_corridor;
+    }
+    AddCroppedLanePoints(
+      lane, converted_lanelets, CorridorLineString::kCenterline, step, begin, end,
+      driving_corridor.centerline);
+    AddCroppedLanePoints(
+      lane, converted_lanelets, CorridorLineString::kBoundLeft, step, begin, end,
+      driving_corridor.bound_left);
+    AddCroppedLanePoints(
+      lane, converted_lanelets, CorridorLineString::kBoundRight, step, begin, end,
+      driving_corridor.bound_right);
+    return driving_corridor;
+  }
+
+  // Reserve the corridor, then add every step-th point (and the last point) of the linestrings
+  std::size_t n_centerline = 0;
+  std::size_t n_left = 0;
+  std::size_t n_right = 0;
+  for (int id : lane) {
+    if (id >= 0) {
+      const auto & current_lanelet = converted_lanelets.at(id);
+      n_centerline += GetCorridorPointCount(current_lanelet.centerline().size(), step);
+      n_left += GetCorridorPointCount(current_lanelet.leftBound().size(), step);
+      n_right += GetCorridorPointCount(current_lanelet.rightBound().size(), step);
+    }
+  }
+  driving_corridor.centerline.reserve(n_centerline);
+  driving_corridor.bound_left.reserve(n_left);
+  driving_corridor.bound_right.reserve(n_right);
+
+  for (int id : lane) {
+    if (id >= 0) {
+      const auto & current_lanelet = converted_lanelets.at(id);
+
+      // Adding elements of centerline, bound_left and bound_right
+      EmitCorridorPoints(
+        current_lanelet.centerline(), step, AcceptAllCorridorPoints(),
+        MakeCorridorSink(driving_corridor.centerline));
+      EmitCorridorPoints(
+        current_lanelet.leftBound(), step, AcceptAllCorridorPoints(),
+        MakeCorridorSink(driving_corridor.bound_left));
+      EmitCorridorPoints(
+        current_lanelet.rightBound(), step, AcceptAllCorridorPoints(),
+        MakeCorridorSink(driving_corridor.bound_right));
     }
   }
   return driving_corridor;
 }
 
+lanelet::LineString3d CreatePairedBoundCenterline(
+  const lanelet::ConstLineString3d & bound_left, const lanelet::ConstLineString3d & bound_right)
+{
+  if (bound_left.empty() || bound_right.empty()) return lanelet::LineString3d(lanelet::InvalId);
+
+  std::vector<double> t_left;
+  std::vector<double> t_right;
+  GetNormalizedArcLength(bound_left, t_left);
+  GetNormalizedArcLength(bound_right, t_right);
+
+  // Merge the normalized arc lengths of both bounds (points at the same arc length are merged)
+  lanelet::Points3d points;
+  points.reserve(t_left.size() + t_right.size());
+  ForEachPairedBoundParameter(
+    t_left, t_right, [&](const double t, const std::size_t i_left, const std::size_t i_right) {
+      const lanelet::BasicPoint3d point_left =
+        InterpolateNormalized(bound_left, t_left, i_left, t);
+      const lanelet::BasicPoint3d point_right =
+        InterpolateNormalized(bound_right, t_right, i_right, t);
+      points.emplace_back(
+        lanelet::InvalId, lanelet::BasicPoint3d(0.5 * (point_left + point_right)));
+    });
+
+  return lanelet::LineString3d(lanelet::InvalId, points);
+}
+
 lanelet::LineString2d CreateLineString(const std::vector<geometry_msgs::msg::Point> & points)
 {
   // Create a Lanelet2 linestring
@@ -581,25 +942,30 @@ lanelet::LineString2d CreateLineString(const std::vector<geometry_msgs::msg::Poi
   return linestring;
 }
 
-std::vector<int> GetAllNeighborsOfLane(
-  const std::vector<int> & lane, const std::vector<LaneletConnection> & lanelet_connections,
+LaneIndices GetAllNeighborsOfLane(
+  const LaneIndices & lane, const std::vector<LaneletConnection> & lanelet_connections,
   const int vehicle_side)
 {
   // Initialize vector
-  std::vector<int> neighbor_lane_idx = {};
+  LaneIndices neighbor_lane_idx;
 
   if (!lane.empty()) {
     // Loop through all the lane indices to get the neighbors
     int neighbor_tmp;
 
+    // Added flags indexed by the lanelet ID (O(1) duplicate check)
+    std::vector<bool> is_added(lanelet_connections.size(), false);
+
     for (const int id : lane) {
+      assert(
+        lanelet_connections[id].neighbor_lanelet_ids.size() >
+        static_cast<std::size_t>(vehicle_side));
       neighbor_tmp = lanelet_connections[id].neighbor_lanelet_ids[vehicle_side];
       if (neighbor_tmp >= 0) {
         // Only add neighbor if lanelet does not exist already (avoid having
         // duplicates)
-        if (
-          std::find(neighbor_lane_idx.begin(), neighbor_lane_idx.end(), neighbor_tmp) ==
-          neighbor_lane_idx.end()) {
+        if (!is_added[neighbor_tmp]) {
+          is_added[neighbor_tmp] = true;
           neighbor_lane_idx.push_back(neighbor_tmp);
         }
       } else {
@@ -613,21 +979,20 @@ std::vector<int> GetAllNeighborsOfLane(
 }
 
 void InsertPredecessorLanelet(
-  std::vector<int> & lane_idx, const std::vector<LaneletConnection> & lanelet_connections)
+  LaneIndices & lane_idx, const std::vector<LaneletConnection> & lanelet_connections)
 {
   if (!lane_idx.empty()) {
     // Get index of first lanelet
     int first_lanelet_index = lane_idx[0];
 
-    if (!lanelet_connections[first_lanelet_index].predecessor_lanelet_ids.empty()) {
-      // Get one predecessor lanelet
-      const int predecessor_lanelet = lanelet_connections[first_lanelet_index]
-                                        .predecessor_lanelet_ids[0];  // Get one of the predecessors
+    // Get one of the predecessors (-1 if there is none)
+    assert(!lanelet_connections[first_lanelet_index].predecessor_lanelet_ids.empty());
+    const int predecessor_lanelet =
+      lanelet_connections[first_lanelet_index].predecessor_lanelet_ids[0];
 
-      // Insert predecessor lanelet in lane_idx
-      if (predecessor_lanelet >= 0) {
-        lane_idx.insert(lane_idx.begin(), predecessor_lanelet);
-      }
+    // Insert predecessor lanelet in lane_idx (O(1), free space is kept at the front)
+    if (predecessor_lanelet >= 0) {
+      lane_idx.push_front(predecessor_lanelet);
     }
   }
 }
@@ -652,7 +1017,7 @@ void CalculatePredecessors(std::vector<LaneletConnection> & lanelet_connections)
   }
 
   // Write -1 to lanelets which have no predecessors
-  for (LaneletConnection lanelet_connection : lanelet_connections) {
+  for (LaneletConnection & lanelet_connection : lanelet_connections) {
     if (lanelet_connection.predecessor_lanelet_ids.empty()) {
       lanelet_connection.predecessor_lanelet_ids = {-1};
     }
@@ -661,8 +1026,8 @@ void CalculatePredecessors(std::vector<LaneletConnection> & lanelet_connections)
 
 unsigned int ID::ReturnIDAndIncrement()
 {
+  // Wrap around on overflow
   if (value_ == std::numeric_limits<unsigned int>::max()) {
-    RCLCPP_WARN(rclcpp::get_logger("ID"), "ID overflow");
     value_ = 0;  // Reset value_ to 0
   }
   return value_++;
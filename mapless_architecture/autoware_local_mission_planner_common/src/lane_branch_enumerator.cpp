@@ -0,0 +1,108 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/lane_branch_enumerator.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace autoware::mapless_architecture
+{
+
+LaneBranchEnumerator::LaneBranchEnumerator(
+  const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet,
+  const LaneBranchBudget & budget, TransitionCost transition_cost)
+: lanelet_connections_(lanelet_connections),
+  budget_(budget),
+  max_expansions_(
+    budget.max_expansions > 0
+      ? static_cast<std::size_t>(budget.max_expansions)
+      : 4 * static_cast<std::size_t>(std::max(budget.max_branches, 0)) *
+          static_cast<std::size_t>(std::max(budget.max_depth, 0))),
+  transition_cost_(std::move(transition_cost))
+{
+  if (IsValidLanelet(id_initial_lanelet) && budget_.max_depth > 0) {
+    nodes_.push_back(Node{id_initial_lanelet, -1, 1, 0.0});
+    queue_.push(QueueEntry{0.0, 0});
+  }
+}
+
+bool LaneBranchEnumerator::Next(LaneIndices & sequence, double * cost)
+{
+  while (!queue_.empty() && n_branches_ < budget_.max_branches) {
+    const QueueEntry entry = queue_.top();
+    queue_.pop();
+
+    // Copy, the expansion may reallocate the node storage
+    const Node node = nodes_[entry.node];
+
+    // Expand the partial sequence with all successors (if within the budget)
+    bool is_expanded = false;
+    if (node.depth < budget_.max_depth && n_expansions_ < max_expansions_) {
+      for (const int successor_id : lanelet_connections_[node.lanelet_id].successor_lanelet_ids) {
+        if (!IsValidLanelet(successor_id) || IsInSequence(entry.node, successor_id)) continue;
+
+        const double successor_cost =
+          node.cost + std::max(transition_cost_(node.lanelet_id, successor_id), 0.0);
+        nodes_.push_back(Node{successor_id, entry.node, node.depth + 1, successor_cost});
+        queue_.push(QueueEntry{successor_cost, static_cast<int>(nodes_.size()) - 1});
+        is_expanded = true;
+      }
+      n_expansions_++;
+    }
+    if (is_expanded) continue;
+
+    // The sequence is complete: as the costs are non-negative, no remaining partial sequence can
+    // lead to a cheaper one
+    sequence.clear();
+    for (int i = entry.node; i >= 0; i = nodes_[i].parent) {
+      sequence.push_front(nodes_[i].lanelet_id);
+    }
+    if (cost != nullptr) *cost = node.cost;
+
+    n_branches_++;
+    return true;
+  }
+  return false;
+}
+
+bool LaneBranchEnumerator::IsValidLanelet(const int id) const
+{
+  return id >= 0 && static_cast<std::size_t>(id) < lanelet_connections_.size();
+}
+
+bool LaneBranchEnumerator::IsInSequence(const int node, const int lanelet_id) const
+{
+  for (int i = node; i >= 0; i = nodes_[i].parent) {
+    if (nodes_[i].lanelet_id == lanelet_id) return true;
+  }
+  return false;
+}
+
+std::vector<LaneIndices> GetBestSuccessorSequences(
+  const std::vector<LaneletConnection> & lanelet_connections, const int id_initial_lanelet,
+  const LaneBranchBudget & budget, LaneBranchEnumerator::TransitionCost transition_cost)
+{
+  LaneBranchEnumerator enumerator(
+    lanelet_connections, id_initial_lanelet, budget, std::move(transition_cost));
+
+  std::vector<LaneIndices> sequences;
+  LaneIndices sequence;
+  while (enumerator.Next(sequence)) {
+    sequences.push_back(sequence);
+  }
+  return sequences;
+}
+
+}  // namespace autoware::mapless_architecture
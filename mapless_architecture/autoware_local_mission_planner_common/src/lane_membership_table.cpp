@@ -0,0 +1,147 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/lane_membership_table.hpp"
+
+namespace autoware::mapless_architecture
+{
+
+namespace
+{
+
+inline void SetBit(std::uint64_t * row, const int id)
+{
+  row[id / 64] |= std::uint64_t{1} << (id % 64);
+}
+
+inline bool IsBitSet(const std::uint64_t * row, const int id)
+{
+  return (row[id / 64] >> (id % 64)) & 1u;
+}
+
+}  // namespace
+
+void LaneMembershipTable::Build(const std::vector<LaneletConnection> & lanelet_connections)
+{
+  n_lanelets_ = lanelet_connections.size();
+  n_words_ = (n_lanelets_ + 63) / 64;
+  bits_.assign(n_lanelets_ * n_words_, 0);
+  n_open_predecessors_.assign(n_lanelets_, 0);
+  is_done_.assign(n_lanelets_, false);
+  queue_.clear();
+  lane_ids_.assign(n_lanelets_, kNoLane);
+  original_lanelet_ids_.resize(n_lanelets_);
+
+  for (std::size_t id = 0; id < n_lanelets_; id++) {
+    original_lanelet_ids_[id] = lanelet_connections[id].original_lanelet_id;
+    for (const int id_predecessor : lanelet_connections[id].predecessor_lanelet_ids) {
+      if (id_predecessor >= 0) n_open_predecessors_[id]++;
+    }
+    if (n_open_predecessors_[id] == 0) queue_.push_back(static_cast<int>(id));
+  }
+
+  // Topological order (Kahn): the closure of a lanelet is the union of the closures of its
+  // predecessors, which are complete when it is processed
+  for (std::size_t head = 0; head < queue_.size(); head++) {
+    const int id = queue_[head];
+    std::uint64_t * row = Row(id);
+
+    SetBit(row, id);
+    for (const int id_predecessor : lanelet_connections[id].predecessor_lanelet_ids) {
+      if (id_predecessor < 0) continue;
+      const std::uint64_t * row_predecessor = Row(id_predecessor);
+      for (std::size_t w = 0; w < n_words_; w++) row[w] |= row_predecessor[w];
+    }
+    is_done_[id] = true;
+
+    for (const int id_successor : lanelet_connections[id].successor_lanelet_ids) {
+      if (id_successor >= 0 && --n_open_predecessors_[id_successor] == 0) {
+        queue_.push_back(id_successor);
+      }
+    }
+  }
+
+  // Lanelets on or behind a cycle: search the predecessors, the search stops at lanelets with a
+  // complete closure
+  for (std::size_t i = 0; i < n_lanelets_; i++) {
+    if (is_done_[i]) continue;
+
+    const int id = static_cast<int>(i);
+    std::uint64_t * row = Row(id);
+    SetBit(row, id);
+    queue_.assign(1, id);
+    while (!queue_.empty()) {
+      const int id_current = queue_.back();
+      queue_.pop_back();
+
+      for (const int id_predecessor : lanelet_connections[id_current].predecessor_lanelet_ids) {
+        if (id_predecessor < 0) continue;
+        if (is_done_[id_predecessor]) {
+          const std::uint64_t * row_predecessor = Row(id_predecessor);
+          for (std::size_t w = 0; w < n_words_; w++) row[w] |= row_predecessor[w];
+        } else if (!IsBitSet(row, id_predecessor)) {
+          SetBit(row, id_predecessor);
+          queue_.push_back(id_predecessor);
+        }
+      }
+    }
+    is_done_[id] = true;
+  }
+}
+
+bool LaneMembershipTable::IsBuiltFrom(
+  const std::vector<LaneletConnection> & lanelet_connections) const
+{
+  if (lanelet_connections.size() != original_lanelet_ids_.size()) return false;
+  for (std::size_t i = 0; i < lanelet_connections.size(); i++) {
+    if (lanelet_connections[i].original_lanelet_id != original_lanelet_ids_[i]) return false;
+  }
+  return true;
+}
+
+void LaneMembershipTable::SetLaneId(const LaneIndices & lane, const int id_lane)
+{
+  for (const int id : lane) {
+    if (IsValidLanelet(id) && lane_ids_[id] == kNoLane) lane_ids_[id] = id_lane;
+  }
+}
+
+bool IsOnLaneTo(
+  const std::vector<LaneletConnection> & lanelet_connections, const int id_lanelet,
+  const int id_target_lanelet)
+{
+  const int n_lanelets = static_cast<int>(lanelet_connections.size());
+  if (id_lanelet < 0 || id_lanelet >= n_lanelets) return false;
+  if (id_target_lanelet < 0 || id_target_lanelet >= n_lanelets) return false;
+  if (id_lanelet == id_target_lanelet) return true;
+
+  // Depth-first search of the predecessors of the target lanelet (stops at the first match)
+  std::vector<bool> is_visited(lanelet_connections.size(), false);
+  std::vector<int> stack(1, id_target_lanelet);
+  is_visited[id_target_lanelet] = true;
+  while (!stack.empty()) {
+    const int id = stack.back();
+    stack.pop_back();
+
+    for (const int id_predecessor : lanelet_connections[id].predecessor_lanelet_ids) {
+      if (id_predecessor < 0 || is_visited[id_predecessor]) continue;
+      if (id_predecessor == id_lanelet) return true;
+      is_visited[id_predecessor] = true;
+      stack.push_back(id_predecessor);
+    }
+  }
+  return false;
+}
+
+}  // namespace autoware::mapless_architecture
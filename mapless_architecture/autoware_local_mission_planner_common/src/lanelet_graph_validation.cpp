@@ -0,0 +1,162 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/lanelet_graph_validation.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace autoware::mapless_architecture
+{
+
+namespace
+{
+
+enum VisitState : std::uint8_t { kUnvisited = 0, kInProgress = 1, kDone = 2 };
+
+// Count the cycles of the successor graph (back edges of an iterative depth-first search)
+std::size_t CountSuccessorCycles(const std::vector<LaneletConnection> & lanelet_connections)
+{
+  std::size_t n_cycles = 0;
+  std::vector<VisitState> state(lanelet_connections.size(), kUnvisited);
+
+  // Lanelet and index of its next successor to visit
+  std::vector<std::pair<int, std::size_t>> stack;
+
+  for (std::size_t root = 0; root < lanelet_connections.size(); root++) {
+    if (state[root] != kUnvisited) continue;
+
+    state[root] = kInProgress;
+    stack.emplace_back(static_cast<int>(root), 0);
+    while (!stack.empty()) {
+      auto & [id, idx_successor] = stack.back();
+      const LaneIndices & successors = lanelet_connections[id].successor_lanelet_ids;
+
+      if (idx_successor == successors.size()) {
+        state[id] = kDone;
+        stack.pop_back();
+        continue;
+      }
+
+      const int successor = successors[idx_successor++];
+      if (successor < 0) continue;
+      if (state[successor] == kInProgress) {
+        n_cycles++;
+      } else if (state[successor] == kUnvisited) {
+        state[successor] = kInProgress;
+        stack.emplace_back(successor, 0);
+      }
+    }
+  }
+  return n_cycles;
+}
+
+// Count the cycles of the chain of neighbors on one side (each lanelet has at most one neighbor per
+// side, i.e. every lanelet is walked once)
+std::size_t CountNeighborCycles(
+  const std::vector<LaneletConnection> & lanelet_connections, const VehicleSide side)
+{
+  std::size_t n_cycles = 0;
+  std::vector<VisitState> state(lanelet_connections.size(), kUnvisited);
+
+  for (std::size_t start = 0; start < lanelet_connections.size(); start++) {
+    // Walk the chain until its end or an already visited lanelet
+    int id = static_cast<int>(start);
+    while (id >= 0 && state[id] == kUnvisited) {
+      state[id] = kInProgress;
+      id = lanelet_connections[id].neighbor_lanelet_ids[side];
+    }
+    if (id >= 0 && state[id] == kInProgress) n_cycles++;
+
+    // Mark the walked chain as done
+    id = static_cast<int>(start);
+    while (id >= 0 && state[id] == kInProgress) {
+      state[id] = kDone;
+      id = lanelet_connections[id].neighbor_lanelet_ids[side];
+    }
+  }
+  return n_cycles;
+}
+
+}  // namespace
+
+LaneletGraphReport NormalizeLaneletConnections(
+  std::vector<LaneletConnection> & lanelet_connections)
+{
+  LaneletGraphReport report;
+
+  // Map the original ids to the new (index-based) ids
+  std::unordered_map<int, int> map_original_to_new;
+  map_original_to_new.reserve(lanelet_connections.size());
+  for (std::size_t i = 0; i < lanelet_connections.size(); i++) {
+    if (!map_original_to_new
+           .emplace(lanelet_connections[i].original_lanelet_id, static_cast<int>(i))
+           .second) {
+      report.n_duplicate_ids++;
+    }
+  }
+  if (!report.IsValid()) return report;
+
+  // Map an original id to the new id (-1 if it is not available)
+  const auto map_id = [&](const int original_id, const int id_lanelet) {
+    if (original_id < 0) return -1;
+
+    const auto it = map_original_to_new.find(original_id);
+    if (it == map_original_to_new.end()) {
+      report.n_dangling_references++;
+      return -1;
+    }
+    if (it->second == id_lanelet) {
+      report.n_self_references++;
+      return -1;
+    }
+    return it->second;
+  };
+
+  for (std::size_t i = 0; i < lanelet_connections.size(); i++) {
+    LaneletConnection & lanelet_connection = lanelet_connections[i];
+
+    // Successors: keep the valid ones only
+    LaneIndices successors;
+    for (const int id : lanelet_connection.successor_lanelet_ids) {
+      const int id_new = map_id(id, static_cast<int>(i));
+      if (id_new >= 0) successors.push_back(id_new);
+    }
+    if (successors.empty()) successors.push_back(-1);
+    lanelet_connection.successor_lanelet_ids = successors;
+
+    // Neighbors: the position is the vehicle side, i.e. invalid ones are replaced by -1
+    for (int & id : lanelet_connection.neighbor_lanelet_ids) {
+      id = map_id(id, static_cast<int>(i));
+    }
+    while (lanelet_connection.neighbor_lanelet_ids.size() < 2) {
+      lanelet_connection.neighbor_lanelet_ids.push_back(-1);
+      report.n_filled_neighbor_slots++;
+    }
+
+    // Predecessors are calculated from the successors
+    lanelet_connection.predecessor_lanelet_ids.clear();
+  }
+
+  CalculatePredecessors(lanelet_connections);
+
+  report.n_successor_cycles = CountSuccessorCycles(lanelet_connections);
+  report.n_neighbor_cycles = CountNeighborCycles(lanelet_connections, VehicleSide::kLeft) +
+                             CountNeighborCycles(lanelet_connections, VehicleSide::kRight);
+
+  return report;
+}
+
+}  // namespace autoware::mapless_architecture
@@ -0,0 +1,298 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/lanelet_polygon_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace autoware::mapless_architecture
+{
+
+namespace
+{
+
+// Bounds of the cell size of the grid (in m and relative to the extent of the grid)
+constexpr double kMinCellSize = 1.0;
+constexpr double kMaxCellsPerAxis = 1024.0;
+
+// Sign bit of a double as integer (1 if the value is negative, -0.0 is not negative). Used instead
+// of comparisons, whose masks the compiler does not vectorize into integer counts on x86-64
+// without AVX.
+inline std::uint64_t IsNegative(const double value)
+{
+  // Adding 0.0 turns -0.0 into 0.0 (x - y is -0.0 for x = -0.0 and y = 0.0)
+  const double value_signed = value + 0.0;
+  std::uint64_t bits;
+  std::memcpy(&bits, &value_signed, sizeof(bits));
+  return bits >> 63;
+}
+
+}  // namespace
+
+void LaneletPolygonTable::Build(const std::vector<lanelet::Lanelet> & lanelets)
+{
+  const std::size_t n_lanelets = lanelets.size();
+  lanelet_ids_.resize(n_lanelets);
+  edge_offsets_.assign(1, 0);
+  min_x_.resize(n_lanelets);
+  max_x_.resize(n_lanelets);
+  min_y_.resize(n_lanelets);
+  max_y_.resize(n_lanelets);
+  edge_x0_.clear();
+  edge_y0_.clear();
+  edge_y1_.clear();
+  edge_slope_.clear();
+
+  for (std::size_t i = 0; i < n_lanelets; i++) {
+    lanelet_ids_[i] = lanelets[i].id();
+
+    // Closed polygon: left bound followed by the reversed right bound
+    const lanelet::ConstLineString3d left_bound = lanelets[i].leftBound();
+    const lanelet::ConstLineString3d right_bound = lanelets[i].rightBound();
+    polygon_x_.clear();
+    polygon_y_.clear();
+    for (std::size_t j = 0; j < left_bound.size(); j++) {
+      polygon_x_.push_back(left_bound[j].x());
+      polygon_y_.push_back(left_bound[j].y());
+    }
+    for (std::size_t j = right_bound.size(); j > 0; j--) {
+      polygon_x_.push_back(right_bound[j - 1].x());
+      polygon_y_.push_back(right_bound[j - 1].y());
+    }
+
+    min_x_[i] = std::numeric_limits<double>::max();
+    max_x_[i] = std::numeric_limits<double>::lowest();
+    min_y_[i] = std::numeric_limits<double>::max();
+    max_y_[i] = std::numeric_limits<double>::lowest();
+
+    // A polygon with less than 3 points does not contain any point (no edges)
+    const std::size_t n_points = polygon_x_.size();
+    if (n_points >= 3) {
+      for (std::size_t j = 0; j < n_points; j++) {
+        const std::size_t k = j + 1 < n_points ? j + 1 : 0;
+        const double dy = polygon_y_[k] - polygon_y_[j];
+        edge_x0_.push_back(polygon_x_[j]);
+        edge_y0_.push_back(polygon_y_[j]);
+        edge_y1_.push_back(polygon_y_[k]);
+        edge_slope_.push_back(dy != 0.0 ? (polygon_x_[k] - polygon_x_[j]) / dy : 0.0);
+
+        min_x_[i] = std::min(min_x_[i], polygon_x_[j]);
+        max_x_[i] = std::max(max_x_[i], polygon_x_[j]);
+        min_y_[i] = std::min(min_y_[i], polygon_y_[j]);
+        max_y_[i] = std::max(max_y_[i], polygon_y_[j]);
+      }
+    }
+    edge_offsets_.push_back(edge_x0_.size());
+  }
+
+  BuildGrid();
+}
+
+void LaneletPolygonTable::BuildGrid()
+{
+  n_cells_x_ = 0;
+  n_cells_y_ = 0;
+  cell_offsets_.assign(1, 0);
+  cell_polygons_.clear();
+
+  // Bounds of the polygons (polygons without edges have an empty bounding box)
+  grid_min_x_ = std::numeric_limits<double>::max();
+  grid_min_y_ = std::numeric_limits<double>::max();
+  double grid_max_x = std::numeric_limits<double>::lowest();
+  double grid_max_y = std::numeric_limits<double>::lowest();
+  std::size_t n_polygons = 0;
+  for (std::size_t i = 0; i < GetSize(); i++) {
+    if (min_x_[i] > max_x_[i]) continue;
+    grid_min_x_ = std::min(grid_min_x_, min_x_[i]);
+    grid_min_y_ = std::min(grid_min_y_, min_y_[i]);
+    grid_max_x = std::max(grid_max_x, max_x_[i]);
+    grid_max_y = std::max(grid_max_y, max_y_[i]);
+    n_polygons++;
+  }
+  if (n_polygons == 0) return;
+
+  // About one cell per polygon
+  const double extent_x = grid_max_x - grid_min_x_;
+  const double extent_y = grid_max_y - grid_min_y_;
+  cell_size_ = std::max(
+    {std::sqrt(extent_x * extent_y / static_cast<double>(n_polygons)), kMinCellSize,
+     extent_x / kMaxCellsPerAxis, extent_y / kMaxCellsPerAxis});
+  n_cells_x_ = static_cast<int>(extent_x / cell_size_) + 1;
+  n_cells_y_ = static_cast<int>(extent_y / cell_size_) + 1;
+
+  // Cells covered by the bounding box of a polygon
+  const auto get_cell_range = [this](const std::size_t id, int & x0, int & x1, int & y0, int & y1) {
+    x0 = std::min(static_cast<int>((min_x_[id] - grid_min_x_) / cell_size_), n_cells_x_ - 1);
+    x1 = std::min(static_cast<int>((max_x_[id] - grid_min_x_) / cell_size_), n_cells_x_ - 1);
+    y0 = std::min(static_cast<int>((min_y_[id] - grid_min_y_) / cell_size_), n_cells_y_ - 1);
+    y1 = std::min(static_cast<int>((max_y_[id] - grid_min_y_) / cell_size_), n_cells_y_ - 1);
+  };
+
+  // Counting sort of the polygons into the cells (ascending within a cell)
+  const std::size_t n_cells = static_cast<std::size_t>(n_cells_x_) * n_cells_y_;
+  cell_offsets_.assign(n_cells + 1, 0);
+  int x0, x1, y0, y1;
+  for (std::size_t i = 0; i < GetSize(); i++) {
+    if (min_x_[i] > max_x_[i]) continue;
+    get_cell_range(i, x0, x1, y0, y1);
+    for (int cy = y0; cy <= y1; cy++) {
+      for (int cx = x0; cx <= x1; cx++) cell_offsets_[cy * n_cells_x_ + cx + 1]++;
+    }
+  }
+  for (std::size_t c = 0; c < n_cells; c++) cell_offsets_[c + 1] += cell_offsets_[c];
+
+  cell_polygons_.resize(cell_offsets_[n_cells]);
+  std::vector<std::size_t> cell_cursors(cell_offsets_.begin(), cell_offsets_.end() - 1);
+  for (std::size_t i = 0; i < GetSize(); i++) {
+    if (min_x_[i] > max_x_[i]) continue;
+    get_cell_range(i, x0, x1, y0, y1);
+    for (int cy = y0; cy <= y1; cy++) {
+      for (int cx = x0; cx <= x1; cx++) {
+        cell_polygons_[cell_cursors[cy * n_cells_x_ + cx]++] = static_cast<int>(i);
+      }
+    }
+  }
+}
+
+int LaneletPolygonTable::GetCell(const double x, const double y) const
+{
+  // Also rejects NaN
+  const double cx = (x - grid_min_x_) / cell_size_;
+  const double cy = (y - grid_min_y_) / cell_size_;
+  if (!(cx >= 0.0 && cx < n_cells_x_ && cy >= 0.0 && cy < n_cells_y_)) return -1;
+  return static_cast<int>(cy) * n_cells_x_ + static_cast<int>(cx);
+}
+
+bool LaneletPolygonTable::IsBuiltFrom(const std::vector<lanelet::Lanelet> & lanelets) const
+{
+  if (lanelets.size() != lanelet_ids_.size()) return false;
+  for (std::size_t i = 0; i < lanelets.size(); i++) {
+    if (lanelets[i].id() != lanelet_ids_[i]) return false;
+  }
+  return true;
+}
+
+bool LaneletPolygonTable::Contains(const int id_polygon, const double x, const double y) const
+{
+  const std::size_t id = static_cast<std::size_t>(id_polygon);
+  if (!IsInBoundingBox(id, x, y)) return false;
+
+  const std::size_t n_edges = edge_offsets_[id + 1] - edge_offsets_[id];
+  const double * x0 = edge_x0_.data() + edge_offsets_[id];
+  const double * y0 = edge_y0_.data() + edge_offsets_[id];
+  const double * y1 = edge_y1_.data() + edge_offsets_[id];
+  const double * slope = edge_slope_.data() + edge_offsets_[id];
+
+  // Crossing number of a ray from the point in +x direction (an edge is crossed if it spans the
+  // y value of the point, half-open, and its intersection with the ray is right of the point).
+  // The conditions are sign bits of differences (a < b if a - b is negative), i.e. the loop only
+  // has integer arithmetic on the results and is vectorized with SSE2.
+  std::uint64_t n_crossings = 0;
+  for (std::size_t e = 0; e < n_edges; e++) {
+    const double dy0 = y - y0[e];
+    const std::uint64_t is_spanning = IsNegative(dy0) ^ IsNegative(y - y1[e]);
+    const std::uint64_t is_right = IsNegative(x - (x0[e] + dy0 * slope[e]));
+    n_crossings += is_spanning & is_right;
+  }
+  return (n_crossings & 1u) != 0;
+}
+
+void LaneletPolygonTable::Contains(
+  const int id_polygon, const double * x, const double * y, const std::size_t n_points,
+  std::uint8_t * is_inside) const
+{
+  const std::size_t id = static_cast<std::size_t>(id_polygon);
+  std::fill(is_inside, is_inside + n_points, 0);
+
+  // One edge against all points (the inner loop is vectorized over the points as in Contains()),
+  // the parity is accumulated
+  for (std::size_t e = edge_offsets_[id]; e < edge_offsets_[id + 1]; e++) {
+    const double x0 = edge_x0_[e];
+    const double y0 = edge_y0_[e];
+    const double y1 = edge_y1_[e];
+    const double slope = edge_slope_[e];
+    for (std::size_t i = 0; i < n_points; i++) {
+      const double dy0 = y[i] - y0;
+      const std::uint64_t is_spanning = IsNegative(dy0) ^ IsNegative(y[i] - y1);
+      const std::uint64_t is_right = IsNegative(x[i] - (x0 + dy0 * slope));
+      is_inside[i] ^= static_cast<std::uint8_t>(is_spanning & is_right);
+    }
+  }
+}
+
+int LaneletPolygonTable::FindContainingPolygon(const double x, const double y) const
+{
+  const int cell = GetCell(x, y);
+  if (cell < 0) return -1;
+
+  for (std::size_t i = cell_offsets_[cell]; i < cell_offsets_[cell + 1]; i++) {
+    if (Contains(cell_polygons_[i], x, y)) return cell_polygons_[i];
+  }
+  return -1;
+}
+
+void LaneletPolygonTable::FindContainingPolygons(
+  const double * x, const double * y, const std::size_t n_points, std::vector<int> & ids_polygon)
+{
+  ids_polygon.assign(n_points, -1);
+
+  // Bucket the points by cell (sorted by cell, the points of a cell in ascending order)
+  point_cells_.clear();
+  for (std::size_t i = 0; i < n_points; i++) {
+    const int cell = GetCell(x[i], y[i]);
+    if (cell >= 0) point_cells_.emplace_back(cell, i);
+  }
+  std::sort(point_cells_.begin(), point_cells_.end());
+
+  for (std::size_t begin = 0; begin < point_cells_.size();) {
+    const int cell = point_cells_[begin].first;
+    std::size_t end = begin + 1;
+    while (end < point_cells_.size() && point_cells_[end].first == cell) end++;
+
+    // Points of the cell (contiguous)
+    const std::size_t n_cell_points = end - begin;
+    cell_x_.resize(n_cell_points);
+    cell_y_.resize(n_cell_points);
+    cell_is_inside_.resize(n_cell_points);
+    for (std::size_t j = 0; j < n_cell_points; j++) {
+      cell_x_[j] = x[point_cells_[begin + j].second];
+      cell_y_[j] = y[point_cells_[begin + j].second];
+    }
+
+    // Polygons of the cell in ascending order, a point is assigned to the first polygon which
+    // contains it (the bounding box check as in Contains() for a single point)
+    std::size_t n_open = n_cell_points;
+    for (std::size_t k = cell_offsets_[cell]; k < cell_offsets_[cell + 1] && n_open > 0; k++) {
+      const int id_polygon = cell_polygons_[k];
+      Contains(id_polygon, cell_x_.data(), cell_y_.data(), n_cell_points, cell_is_inside_.data());
+      for (std::size_t j = 0; j < n_cell_points; j++) {
+        int & id = ids_polygon[point_cells_[begin + j].second];
+        if (
+          id < 0 && cell_is_inside_[j] != 0 &&
+          IsInBoundingBox(static_cast<std::size_t>(id_polygon), cell_x_[j], cell_y_[j])) {
+          id = id_polygon;
+          n_open--;
+        }
+      }
+    }
+
+    begin = end;
+  }
+}
+
+}  // namespace autoware::mapless_architecture
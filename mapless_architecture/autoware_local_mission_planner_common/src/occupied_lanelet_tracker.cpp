@@ -0,0 +1,99 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/occupied_lanelet_tracker.hpp"
+
+#include <algorithm>
+
+namespace autoware::mapless_architecture
+{
+
+int OccupiedLaneletTracker::Find(
+  const LaneletPolygonTable & lanelet_polygons,
+  const std::vector<LaneletConnection> & lanelet_connections, const lanelet::BasicPoint2d & point)
+{
+  const int id = FindNearRemembered(lanelet_polygons, lanelet_connections, point);
+  if (id >= 0) return id;
+
+  // Miss: search the grid
+  return Remember(
+    lanelet_connections, lanelet_polygons.FindContainingPolygon(point.x(), point.y()));
+}
+
+int OccupiedLaneletTracker::FindNearRemembered(
+  const LaneletPolygonTable & lanelet_polygons,
+  const std::vector<LaneletConnection> & lanelet_connections, const lanelet::BasicPoint2d & point)
+{
+  n_lookups_++;
+
+  const int n_lanelets =
+    static_cast<int>(std::min(lanelet_polygons.GetSize(), lanelet_connections.size()));
+  const auto is_containing = [&](const int id) {
+    return id >= 0 && id < n_lanelets && lanelet_polygons.Contains(id, point.x(), point.y());
+  };
+
+  // Remembered lanelet, then its successors and neighbors
+  const int id_last = GetLastLaneletIndex(lanelet_connections);
+  if (id_last >= 0 && id_last < n_lanelets) {
+    if (is_containing(id_last)) {
+      n_hits_++;
+      return Remember(lanelet_connections, id_last);
+    }
+    for (const int id : lanelet_connections[id_last].successor_lanelet_ids) {
+      if (is_containing(id)) {
+        n_hits_++;
+        return Remember(lanelet_connections, id);
+      }
+    }
+    for (const int id : lanelet_connections[id_last].neighbor_lanelet_ids) {
+      if (is_containing(id)) {
+        n_hits_++;
+        return Remember(lanelet_connections, id);
+      }
+    }
+  }
+  return -1;
+}
+
+int OccupiedLaneletTracker::GetLastLaneletIndex(
+  const std::vector<LaneletConnection> & lanelet_connections) const
+{
+  if (id_original_last_ < 0) return -1;
+
+  // The order of the segments usually does not change between frames
+  const int n_lanelets = static_cast<int>(lanelet_connections.size());
+  if (
+    id_last_ >= 0 && id_last_ < n_lanelets &&
+    lanelet_connections[id_last_].original_lanelet_id == id_original_last_) {
+    return id_last_;
+  }
+  for (int id = 0; id < n_lanelets; id++) {
+    if (lanelet_connections[id].original_lanelet_id == id_original_last_) return id;
+  }
+  return -1;
+}
+
+int OccupiedLaneletTracker::Remember(
+  const std::vector<LaneletConnection> & lanelet_connections, const int id)
+{
+  if (id < 0 || id >= static_cast<int>(lanelet_connections.size())) {
+    Reset();
+    return -1;
+  }
+  id_original_last_ = lanelet_connections[id].original_lanelet_id;
+  id_last_ = id;
+  return id;
+}
+
+}  // namespace autoware::mapless_architecture
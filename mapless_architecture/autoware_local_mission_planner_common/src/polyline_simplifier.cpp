@@ -0,0 +1,309 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/polyline_simplifier.hpp"
+
+#include <algorithm>
+
+namespace autoware::mapless_architecture
+{
+
+namespace
+{
+
+// Cross product of (a - o) and (b - o), positive for a left turn
+inline double Cross(
+  const std::vector<double> & x, const std::vector<double> & y, const std::uint32_t o,
+  const std::uint32_t a, const std::uint32_t b)
+{
+  return (x[a] - x[o]) * (y[b] - y[o]) - (y[a] - y[o]) * (x[b] - x[o]);
+}
+
+// Upper (sign 1) or lower (sign -1) chain of the convex hull of points sorted by x, then y
+// (Andrew's monotone chain, collinear points are removed), returns the size of the chain
+std::uint32_t BuildChain(
+  const std::vector<double> & x, const std::vector<double> & y, const std::uint32_t * points,
+  const std::size_t n_points, const double sign, std::uint32_t * chain)
+{
+  std::uint32_t n_chain = 0;
+  for (std::size_t i = 0; i < n_points; i++) {
+    while (n_chain >= 2 &&
+           sign * Cross(x, y, chain[n_chain - 2], chain[n_chain - 1], points[i]) >= 0.0) {
+      n_chain--;
+    }
+    chain[n_chain++] = points[i];
+  }
+  return n_chain;
+}
+
+}  // namespace
+
+void PolylineSimplifier::BuildHullTree(const std::size_t n_points)
+{
+  const auto is_less = [this](const std::uint32_t a, const std::uint32_t b) {
+    return x_[a] < x_[b] || (x_[a] == x_[b] && y_[a] < y_[b]);
+  };
+
+  n_levels_ = 0;
+  while ((kBlockSize << n_levels_) <= n_points) n_levels_++;
+  if (upper_chains_.size() < n_levels_) {
+    upper_chains_.resize(n_levels_);
+    lower_chains_.resize(n_levels_);
+    upper_sizes_.resize(n_levels_);
+    lower_sizes_.resize(n_levels_);
+  }
+  merged_.resize(n_points);
+
+  for (std::size_t level = 0; level < n_levels_; level++) {
+    const std::size_t node_size = kBlockSize << level;
+    const std::size_t n_nodes = n_points / node_size;
+    upper_chains_[level].resize(n_nodes * node_size);
+    lower_chains_[level].resize(n_nodes * node_size);
+    upper_sizes_[level].resize(n_nodes);
+    lower_sizes_[level].resize(n_nodes);
+
+    for (std::size_t node = 0; node < n_nodes; node++) {
+      const std::size_t offset = node * node_size;
+      std::uint32_t * upper = upper_chains_[level].data() + offset;
+      std::uint32_t * lower = lower_chains_[level].data() + offset;
+      std::uint32_t * merged = merged_.data() + offset;
+
+      if (level == 0) {
+        // Sorted points of the block
+        for (std::size_t i = 0; i < node_size; i++) {
+          merged[i] = static_cast<std::uint32_t>(offset + i);
+        }
+        std::sort(merged, merged + node_size, is_less);
+        upper_sizes_[0][node] = BuildChain(x_, y_, merged, node_size, 1.0, upper);
+        lower_sizes_[0][node] = BuildChain(x_, y_, merged, node_size, -1.0, lower);
+        continue;
+      }
+
+      // The chains of the hull of a node are the chains of the merged chains of its children
+      const std::size_t child_size = node_size / 2;
+      const std::uint32_t * upper_child = upper_chains_[level - 1].data() + offset;
+      const std::uint32_t * lower_child = lower_chains_[level - 1].data() + offset;
+      const std::uint32_t * n_upper_child = upper_sizes_[level - 1].data() + 2 * node;
+      const std::uint32_t * n_lower_child = lower_sizes_[level - 1].data() + 2 * node;
+
+      const std::uint32_t * end = std::merge(
+        upper_child, upper_child + n_upper_child[0], upper_child + child_size,
+        upper_child + child_size + n_upper_child[1], merged, is_less);
+      upper_sizes_[level][node] = BuildChain(x_, y_, merged, end - merged, 1.0, upper);
+
+      end = std::merge(
+        lower_child, lower_child + n_lower_child[0], lower_child + child_size,
+        lower_child + child_size + n_lower_child[1], merged, is_less);
+      lower_sizes_[level][node] = BuildChain(x_, y_, merged, end - merged, -1.0, lower);
+    }
+  }
+}
+
+std::size_t PolylineSimplifier::FindExtremePointOfNode(
+  const std::size_t level, const std::size_t node, const double ux, const double uy) const
+{
+  // The extreme point is on the upper chain for uy > 0 and on the lower chain for uy < 0, the
+  // projection of the chain points onto (ux, uy) increases up to it and decreases afterwards
+  const std::size_t offset = node * (kBlockSize << level);
+  const bool is_upper = uy >= 0.0;
+  const std::uint32_t * chain =
+    (is_upper ? upper_chains_[level].data() : lower_chains_[level].data()) + offset;
+  const std::size_t n_chain = is_upper ? upper_sizes_[level][node] : lower_sizes_[level][node];
+
+  // Along x (both chains start at the smallest and end at the largest point)
+  if (uy == 0.0) return ux > 0.0 ? chain[n_chain - 1] : chain[0];
+
+  std::size_t lo = 0;
+  std::size_t hi = n_chain - 1;
+  while (lo < hi) {
+    const std::size_t mid = (lo + hi) / 2;
+    const double projection_edge =
+      (x_[chain[mid + 1]] - x_[chain[mid]]) * ux + (y_[chain[mid + 1]] - y_[chain[mid]]) * uy;
+    if (projection_edge > 0.0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return chain[lo];
+}
+
+std::size_t PolylineSimplifier::FindExtremePoint(
+  const std::size_t first, const std::size_t last, const double ux, const double uy) const
+{
+  // The range is covered by the largest complete nodes which fit into it, the points before the
+  // first and after the last complete block are tested directly
+  std::size_t i_best = first;
+  double projection_best = x_[first] * ux + y_[first] * uy;
+  const auto update = [&](const std::size_t i) {
+    const double projection = x_[i] * ux + y_[i] * uy;
+    if (projection > projection_best) {
+      projection_best = projection;
+      i_best = i;
+    }
+  };
+
+  std::size_t i = first;
+  while (i <= last) {
+    if (i % kBlockSize != 0 || i + kBlockSize - 1 > last) {
+      update(i);
+      i++;
+      continue;
+    }
+    std::size_t level = 0;
+    while (level + 1 < n_levels_ && i % (kBlockSize << (level + 1)) == 0 &&
+           i + (kBlockSize << (level + 1)) - 1 <= last) {
+      level++;
+    }
+    update(FindExtremePointOfNode(level, i / (kBlockSize << level), ux, uy));
+    i += kBlockSize << level;
+  }
+  return i_best;
+}
+
+std::size_t PolylineSimplifier::Simplify(
+  std::vector<geometry_msgs::msg::Pose> & poses, const double max_lateral_error)
+{
+  const std::size_t n_points = poses.size();
+  n_points_input_ += n_points;
+  if (n_points < 3 || !(max_lateral_error > 0.0)) {
+    n_points_output_ += n_points;
+    return 0;
+  }
+
+  x_.resize(n_points);
+  y_.resize(n_points);
+  for (std::size_t i = 0; i < n_points; i++) {
+    x_[i] = poses[i].position.x;
+    y_[i] = poses[i].position.y;
+  }
+  is_kept_.assign(n_points, 0);
+  is_kept_.front() = 1;
+  is_kept_.back() = 1;
+
+  // Ranges are scanned until the scanned points exceed the budget of a balanced split (the hull
+  // tree is only built for degenerate polylines)
+  const std::size_t n_scanned_max = 2 * kBlockSize;
+  std::size_t log2_n_points = 1;
+  while ((std::size_t{1} << log2_n_points) < n_points) log2_n_points++;
+  const std::size_t scan_budget = 2 * n_points * log2_n_points;
+  std::size_t n_scanned = 0;
+  bool is_hull_tree_built = false;
+
+  const double max_error_squared = max_lateral_error * max_lateral_error;
+  ranges_.clear();
+  ranges_.emplace_back(0, n_points - 1);
+  while (!ranges_.empty()) {
+    const auto [first, last] = ranges_.back();
+    ranges_.pop_back();
+    if (last - first < 2) continue;
+
+    const double x0 = x_[first];
+    const double y0 = y_[first];
+    const double dx = x_[last] - x0;
+    const double dy = y_[last] - y0;
+    const double length_squared = dx * dx + dy * dy;
+    const double length_squared_inv = length_squared > 0.0 ? 1.0 / length_squared : 0.0;
+
+    // Distance of a point to the segment between the end points of the range
+    const auto error_squared_of = [&](const std::size_t i) {
+      const double px = x_[i] - x0;
+      const double py = y_[i] - y0;
+      const double t = std::clamp((px * dx + py * dy) * length_squared_inv, 0.0, 1.0);
+      const double ex = px - t * dx;
+      const double ey = py - t * dy;
+      return ex * ex + ey * ey;
+    };
+
+    const std::size_t n_range = last - first - 1;
+    if (!is_hull_tree_built && n_range > n_scanned_max && n_scanned + n_range > scan_budget) {
+      BuildHullTree(n_points);
+      is_hull_tree_built = true;
+    }
+
+    double error_squared_max = -1.0;
+    std::size_t i_max = first;
+    if (!is_hull_tree_built || n_range <= n_scanned_max || !(length_squared > 0.0)) {
+      n_scanned += n_range;
+      // Point with the largest distance to the segment
+      for (std::size_t i = first + 1; i < last; i++) {
+        const double error_squared = error_squared_of(i);
+        if (error_squared > error_squared_max) {
+          error_squared_max = error_squared;
+          i_max = i;
+        }
+      }
+      if (!(error_squared_max > max_error_squared)) continue;
+    } else {
+      // Extreme points on both sides of the line and along the segment in both directions, the
+      // range is replaced if they are within the maximum lateral error of the line and project
+      // onto the segment (then all points do), otherwise it is split at the violating extreme
+      // point with the largest distance to the segment
+      const std::size_t extremes[] = {
+        FindExtremePoint(first + 1, last - 1, -dy, dx),
+        FindExtremePoint(first + 1, last - 1, dy, -dx),
+        FindExtremePoint(first + 1, last - 1, -dx, -dy),
+        FindExtremePoint(first + 1, last - 1, dx, dy)};
+      const double max_lateral_squared = max_error_squared * length_squared;
+      for (const std::size_t i : extremes) {
+        const double px = x_[i] - x0;
+        const double py = y_[i] - y0;
+        const double lateral = px * dy - py * dx;
+        const double along = px * dx + py * dy;
+        const bool is_violated =
+          lateral * lateral > max_lateral_squared || along < 0.0 || along > length_squared;
+        if (!is_violated) continue;
+
+        const double error_squared = error_squared_of(i);
+        if (error_squared > error_squared_max) {
+          error_squared_max = error_squared;
+          i_max = i;
+        }
+      }
+      if (i_max == first) continue;
+    }
+
+    is_kept_[i_max] = 1;
+    ranges_.emplace_back(i_max, last);
+    ranges_.emplace_back(first, i_max);
+  }
+
+  // Remove the other points in place
+  std::size_t n_kept = 0;
+  for (std::size_t i = 0; i < n_points; i++) {
+    if (is_kept_[i]) {
+      if (n_kept != i) poses[n_kept] = std::move(poses[i]);
+      n_kept++;
+    }
+  }
+  poses.resize(n_kept);
+
+  n_points_output_ += n_kept;
+  return n_points - n_kept;
+}
+
+std::size_t PolylineSimplifier::Simplify(
+  autoware_mapless_planning_msgs::msg::RoadSegments & road_segments,
+  const double max_lateral_error)
+{
+  std::size_t n_removed = 0;
+  for (auto & segment : road_segments.segments) {
+    for (auto & linestring : segment.linestrings) {
+      n_removed += Simplify(linestring.poses, max_lateral_error);
+    }
+  }
+  return n_removed;
+}
+
+}  // namespace autoware::mapless_architecture
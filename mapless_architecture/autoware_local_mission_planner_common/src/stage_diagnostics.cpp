@@ -0,0 +1,42 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/stage_diagnostics.hpp"
+
+#include <string>
+
+namespace autoware::mapless_architecture
+{
+
+void ProduceStageDiagnostics(
+  StageProfiler & profiler, diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  for (int i = 0; i < kNumProfilingStages; i++) {
+    const ProfilingStage stage = static_cast<ProfilingStage>(i);
+    const StageStatistics statistics = profiler.GetStatistics(stage);
+    if (statistics.calls == 0) continue;
+
+    const std::string name = GetProfilingStageName(stage);
+    stat.add(name + " calls", statistics.calls);
+    stat.add(name + " total [ms]", statistics.total_ms);
+    stat.add(name + " mean [ms]", statistics.total_ms / statistics.calls);
+    stat.add(name + " max [ms]", statistics.max_ms);
+    stat.add(name + " allocations", statistics.allocations);
+  }
+  stat.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "Stage profiling");
+
+  profiler.Reset();
+}
+
+}  // namespace autoware::mapless_architecture
@@ -0,0 +1,97 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/stage_profiler.hpp"
+
+#ifdef MAPLESS_ENABLE_PROFILING
+// Defined by the allocation counter library (see allocation_counter.cpp) if it is preloaded
+extern "C" std::uint64_t mapless_get_thread_allocation_count() __attribute__((weak));
+#endif
+
+namespace autoware::mapless_architecture
+{
+
+const char * GetProfilingStageName(const ProfilingStage stage)
+{
+  switch (stage) {
+    case kStageConversion:
+      return "conversion";
+    case kStagePredecessors:
+      return "predecessors";
+    case kStageLaneCalculation:
+      return "lane calculation";
+    case kStageGoalChecks:
+      return "goal checks";
+    case kStageCorridorBuild:
+      return "corridor build";
+    case kStageHeading:
+      return "heading";
+    case kStageTransform:
+      return "transform";
+    case kStagePublish:
+      return "publish";
+    case kStageVisualization:
+      return "visualization";
+    default:
+      return "unknown";
+  }
+}
+
+std::uint64_t GetThreadAllocationCount()
+{
+#ifdef MAPLESS_ENABLE_PROFILING
+  return mapless_get_thread_allocation_count != nullptr ? mapless_get_thread_allocation_count() : 0;
+#else
+  return 0;
+#endif
+}
+
+void StageProfiler::Record(
+  const ProfilingStage stage, const std::uint64_t duration_ns, const std::uint64_t allocations)
+{
+  Counters & counters = counters_[stage];
+  counters.calls.fetch_add(1, std::memory_order_relaxed);
+  counters.total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+  counters.allocations.fetch_add(allocations, std::memory_order_relaxed);
+
+  // Update the maximum runtime
+  std::uint64_t max_ns = counters.max_ns.load(std::memory_order_relaxed);
+  while (duration_ns > max_ns &&
+         !counters.max_ns.compare_exchange_weak(max_ns, duration_ns, std::memory_order_relaxed)) {
+  }
+}
+
+StageStatistics StageProfiler::GetStatistics(const ProfilingStage stage) const
+{
+  const Counters & counters = counters_[stage];
+
+  StageStatistics statistics;
+  statistics.calls = counters.calls.load(std::memory_order_relaxed);
+  statistics.total_ms = 1e-6 * counters.total_ns.load(std::memory_order_relaxed);
+  statistics.max_ms = 1e-6 * counters.max_ns.load(std::memory_order_relaxed);
+  statistics.allocations = counters.allocations.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+void StageProfiler::Reset()
+{
+  for (Counters & counters : counters_) {
+    counters.calls.store(0, std::memory_order_relaxed);
+    counters.total_ns.store(0, std::memory_order_relaxed);
+    counters.max_ns.store(0, std::memory_order_relaxed);
+    counters.allocations.store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace autoware::mapless_architecture
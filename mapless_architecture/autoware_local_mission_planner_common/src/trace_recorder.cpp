@@ -0,0 +1,223 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/trace_recorder.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Ring buffer of the events of one thread (single producer: the owning thread, readers:
+ * TraceRecorder::Snapshot() and TraceRecorder::GetOverwrittenEventCount(), which hold the rings
+ * mutex).
+ */
+class TraceRecorder::ThreadRing
+{
+public:
+  explicit ThreadRing(const std::uint32_t thread_id) : thread_id_(thread_id) {}
+
+  void Push(const char * category, const char * name, const char phase)
+  {
+    const std::uint64_t head = head_.load(std::memory_order_relaxed);
+    Slot & slot = slots_[head & (kRingCapacity - 1)];
+
+    // A reader which sees any of the following stores also sees the previous head (seqlock)
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.timestamp_ns.store(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count(),
+      std::memory_order_relaxed);
+    slot.phase.store(phase, std::memory_order_relaxed);
+
+    // Publish the event
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Append the events in the ring buffer (without removing them).
+   */
+  void Peek(std::vector<TraceEvent> & events) const
+  {
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    const std::uint64_t begin = head > kRingCapacity ? head - kRingCapacity : 0;
+
+    const std::size_t n_events_before = events.size();
+    for (std::uint64_t i = begin; i < head; i++) {
+      const Slot & slot = slots_[i & (kRingCapacity - 1)];
+
+      TraceEvent event;
+      event.category = slot.category.load(std::memory_order_relaxed);
+      event.name = slot.name.load(std::memory_order_relaxed);
+      event.timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+      event.phase = slot.phase.load(std::memory_order_relaxed);
+      event.thread_id = thread_id_;
+      events.push_back(event);
+    }
+
+    // Events which were overwritten by the producer while reading are invalid (the slot at
+    // head_after may be in the process of being written)
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::uint64_t head_after = head_.load(std::memory_order_relaxed);
+    const std::uint64_t oldest_valid =
+      head_after + 1 > kRingCapacity ? head_after + 1 - kRingCapacity : 0;
+    if (oldest_valid > begin) {
+      const std::uint64_t n_invalid = std::min(oldest_valid, head) - begin;
+      events.erase(
+        events.begin() + n_events_before, events.begin() + n_events_before + n_invalid);
+    }
+  }
+
+  /**
+   * @brief Get the number of recorded events (including the overwritten ones).
+   */
+  std::uint64_t GetRecordedEventCount() const { return head_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Get the number of events which were overwritten in the full ring buffer.
+   */
+  std::uint64_t GetOverwrittenEventCount() const
+  {
+    const std::uint64_t head = GetRecordedEventCount();
+    return head > kRingCapacity ? head - kRingCapacity : 0;
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<const char *> category{nullptr};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<std::uint64_t> timestamp_ns{0};
+    std::atomic<char> phase{0};
+  };
+
+  const std::uint32_t thread_id_;
+  std::atomic<std::uint64_t> head_{0};
+  std::array<Slot, kRingCapacity> slots_;
+};
+
+TraceRecorder & TraceRecorder::Instance()
+{
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+void TraceRecorder::SetEnabled(const bool enabled)
+{
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRecorder::Record(const char * category, const char * name, const char phase)
+{
+  GetThreadRing().Push(category, name, phase);
+}
+
+TraceRecorder::ThreadRing & TraceRecorder::GetThreadRing()
+{
+  // Releases the ring of the thread when the thread exits (the thread local registrations of a
+  // thread are destroyed before the recorder, also for the main thread)
+  struct Registration
+  {
+    TraceRecorder * recorder = nullptr;
+    ThreadRing * ring = nullptr;
+
+    ~Registration()
+    {
+      if (ring != nullptr) recorder->ReleaseThreadRing(ring);
+    }
+  };
+
+  // The rings are owned by the recorder, so the events of a finished thread can still be dumped
+  thread_local Registration registration;
+  if (registration.ring == nullptr) {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.push_back(std::make_shared<ThreadRing>(next_thread_id_++));
+    registration.recorder = this;
+    registration.ring = rings_.back().get();
+  }
+  return *registration.ring;
+}
+
+void TraceRecorder::ReleaseThreadRing(const ThreadRing * ring)
+{
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+
+  const auto it = std::find_if(
+    rings_.begin(), rings_.end(), [ring](const auto & r) { return r.get() == ring; });
+  if (it == rings_.end()) return;
+  finished_rings_.push_back(std::move(*it));
+  rings_.erase(it);
+
+  // Only the rings of the latest exited threads are kept
+  if (finished_rings_.size() > kMaxFinishedThreadRings) {
+    released_events_ += finished_rings_.front()->GetRecordedEventCount();
+    finished_rings_.erase(finished_rings_.begin());
+  }
+}
+
+std::vector<TraceEvent> TraceRecorder::Snapshot()
+{
+  std::vector<TraceEvent> events;
+
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+  for (const auto & ring : finished_rings_) ring->Peek(events);
+  for (const auto & ring : rings_) ring->Peek(events);
+  return events;
+}
+
+std::uint64_t TraceRecorder::GetOverwrittenEventCount() const
+{
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+
+  std::uint64_t n_overwritten = released_events_;
+  for (const auto & ring : finished_rings_) n_overwritten += ring->GetOverwrittenEventCount();
+  for (const auto & ring : rings_) n_overwritten += ring->GetOverwrittenEventCount();
+  return n_overwritten;
+}
+
+std::int64_t TraceRecorder::WriteChromeTrace(const std::string & file_path)
+{
+  const std::vector<TraceEvent> events = Snapshot();
+
+  std::FILE * file = std::fopen(file_path.c_str(), "w");
+  if (file == nullptr) return -1;
+
+  // Chrome trace event format: timestamps in microseconds, one track per process and thread
+  const int pid = static_cast<int>(getpid());
+  std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  for (std::size_t i = 0; i < events.size(); i++) {
+    const TraceEvent & event = events[i];
+    std::fprintf(
+      file, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%u}",
+      i == 0 ? "" : ",", event.name, event.category, event.phase, 1e-3 * event.timestamp_ns, pid,
+      event.thread_id);
+  }
+  std::fprintf(file, "\n]}\n");
+
+  const bool success = std::fclose(file) == 0;
+  return success ? static_cast<std::int64_t>(events.size()) : -1;
+}
+
+}  // namespace autoware::mapless_architecture
@@ -0,0 +1,59 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/local_mission_planner_common/trace_service.hpp"
+
+#include "autoware/local_mission_planner_common/trace_recorder.hpp"
+
+#include <memory>
+#include <string>
+
+namespace autoware::mapless_architecture
+{
+
+rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr CreateTraceDumpService(rclcpp::Node & node)
+{
+  const bool enable_tracing = node.declare_parameter<bool>("enable_tracing", false);
+  RCLCPP_INFO(node.get_logger(), "Tracing of the processing stages enabled: %d", enable_tracing);
+
+  const std::string output_directory =
+    node.declare_parameter<std::string>("trace_output_directory", "/tmp");
+  RCLCPP_INFO(node.get_logger(), "Output directory of the traces: %s", output_directory.c_str());
+
+  // Tracing is enabled for the whole process (e.g. all nodes of a component container)
+  if (enable_tracing) TraceRecorder::Instance().SetEnabled(true);
+
+  rclcpp::Node * node_ptr = &node;
+  return node.create_service<std_srvs::srv::Trigger>(
+    "~/dump_trace",
+    [node_ptr, output_directory](
+      const std::shared_ptr<std_srvs::srv::Trigger::Request>,
+      std::shared_ptr<std_srvs::srv::Trigger::Response> response) {
+      const std::string file_path = output_directory + "/" + node_ptr->get_name() + "_trace_" +
+                                    std::to_string(node_ptr->now().nanoseconds()) + ".json";
+
+      const std::int64_t n_events = TraceRecorder::Instance().WriteChromeTrace(file_path);
+
+      response->success = n_events >= 0;
+      if (response->success) {
+        response->message = "Wrote " + std::to_string(n_events) + " trace events to " + file_path;
+        RCLCPP_INFO(node_ptr->get_logger(), "%s", response->message.c_str());
+      } else {
+        response->message = "Could not write trace file " + file_path;
+        RCLCPP_ERROR(node_ptr->get_logger(), "%s", response->message.c_str());
+      }
+    });
+}
+
+}  // namespace autoware::mapless_architecture
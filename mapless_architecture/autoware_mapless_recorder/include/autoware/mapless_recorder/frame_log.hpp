@@ -0,0 +1,295 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__MAPLESS_RECORDER__FRAME_LOG_HPP_
+#define AUTOWARE__MAPLESS_RECORDER__FRAME_LOG_HPP_
+
+#include "autoware_mapless_planning_msgs/msg/mission.hpp"
+#include "autoware_mapless_planning_msgs/msg/road_segments.hpp"
+#include "nav_msgs/msg/odometry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * @brief Binary layout of a frame log file (version 2).
+ *
+ * A frame log is an append-only recording of the inputs of the mission planner. All values are
+ * stored in the byte order of the host, all blocks start at a multiple of 8 bytes. The file
+ * consists of:
+ *
+ * - FrameLogHeader (64 bytes) at offset 0
+ * - index blocks and frame payloads in the order they were appended
+ *
+ * An index block is a FrameLogIndexBlock (16 bytes) followed by kFrameLogIndexBlockCapacity
+ * FrameLogIndexEntry (24 bytes each), entry i of block b describes frame b * capacity + i. The
+ * first index block follows the header, the next one is allocated when a block is full
+ * (next_offset). A reader collects the offsets of the index blocks once and then seeks to any frame
+ * in O(1).
+ *
+ * Frame payloads (type FrameLogType):
+ *
+ * - kRoadSegments: RoadSegmentsFrameRecord, frame_id (padded to 8 bytes), SegmentFrameRecord
+ *   [n_segments], int32 successor and neighbor ids of all segments (in the order of the segments,
+ *   padded to 8 bytes), followed by the point block: double x [n_points], y [n_points],
+ *   z [n_points] (structure of arrays, the points of all linestrings: left and right linestring of
+ *   the first segment, then of the second segment etc.). The orientation of the linestring poses is
+ *   not recorded.
+ * - kOdometry: OdometryFrameRecord, frame_id and child_frame_id (each padded to 8 bytes)
+ * - kMission: MissionFrameRecord
+ *
+ * The number of frames in the header is updated after the payload and the index entry of a frame
+ * were written, i.e. the recording of an aborted recorder is readable up to its last frame.
+ */
+struct FrameLogHeader
+{
+  std::uint32_t magic;               // kFrameLogMagic
+  std::uint32_t version;             // kFrameLogVersion
+  std::uint64_t n_frames;            // Number of complete frames
+  std::uint64_t first_index_offset;  // Offset of the first index block
+  std::uint64_t end_offset;          // End of the appended data
+  std::uint8_t reserved[32];
+};
+
+struct FrameLogIndexBlock
+{
+  std::uint64_t next_offset;  // Offset of the next index block (0: none)
+  std::uint32_t capacity;     // Number of entries (kFrameLogIndexBlockCapacity)
+  std::uint32_t reserved;
+};
+
+struct FrameLogIndexEntry
+{
+  std::uint64_t offset;       // Offset of the payload
+  std::int64_t receive_time;  // Receive time of the frame in ns (clock of the recorder)
+  std::uint32_t type;         // FrameLogType
+  std::uint32_t size;         // Size of the payload in bytes
+};
+
+struct RoadSegmentsFrameRecord
+{
+  std::int32_t stamp_sec;
+  std::uint32_t stamp_nanosec;
+  double position[3];     // Ego pose (x, y, z)
+  double orientation[4];  // Ego pose (quaternion x, y, z, w)
+  std::uint32_t n_segments;
+  std::uint32_t n_points;
+  std::uint32_t frame_id_length;
+  std::uint32_t reserved;
+};
+
+struct SegmentFrameRecord
+{
+  std::uint32_t id;
+  std::uint32_t n_successors;
+  std::uint32_t n_neighbors;
+  std::uint32_t n_points_left;
+  std::uint32_t n_points_right;
+  std::uint32_t reserved;
+};
+
+struct OdometryFrameRecord
+{
+  std::int32_t stamp_sec;
+  std::uint32_t stamp_nanosec;
+  std::uint32_t frame_id_length;
+  std::uint32_t child_frame_id_length;
+  double pose[7];  // Position (x, y, z), orientation (quaternion x, y, z, w)
+  double pose_covariance[36];
+  double twist[6];  // Linear (x, y, z), angular (x, y, z)
+  double twist_covariance[36];
+};
+
+struct MissionFrameRecord
+{
+  std::int32_t stamp_sec;  // Stamp of the mission (reference of the command latency)
+  std::uint32_t stamp_nanosec;
+  std::uint8_t mission_type;
+  std::uint8_t priority;
+  std::uint8_t reserved[2];
+  float deadline;
+};
+
+enum class FrameLogType : std::uint32_t { kRoadSegments = 1, kOdometry = 2, kMission = 3 };
+
+constexpr std::uint32_t kFrameLogMagic = 0x4c464c4d;  // "MLFL"
+constexpr std::uint32_t kFrameLogVersion = 2;
+constexpr std::uint32_t kFrameLogIndexBlockCapacity = 4096;
+
+static_assert(sizeof(FrameLogHeader) == 64, "Unexpected size of FrameLogHeader");
+static_assert(sizeof(FrameLogIndexBlock) == 16, "Unexpected size of FrameLogIndexBlock");
+static_assert(sizeof(FrameLogIndexEntry) == 24, "Unexpected size of FrameLogIndexEntry");
+static_assert(sizeof(RoadSegmentsFrameRecord) == 80, "Unexpected size of RoadSegmentsFrameRecord");
+static_assert(sizeof(SegmentFrameRecord) == 24, "Unexpected size of SegmentFrameRecord");
+static_assert(sizeof(OdometryFrameRecord) == 696, "Unexpected size of OdometryFrameRecord");
+static_assert(sizeof(MissionFrameRecord) == 16, "Unexpected size of MissionFrameRecord");
+
+/**
+ * @brief Appends frames to a memory-mapped frame log file (see FrameLogHeader for the layout).
+ *
+ * The file is grown in large steps (sparse), a frame is encoded directly into the mapping, i.e.
+ * appending a frame does not call into the kernel and the page cache writes the file back
+ * asynchronously.
+ */
+class FrameLogWriter
+{
+public:
+  /**
+   * @brief Create the file (an existing file is overwritten).
+   *
+   * @param path The path of the file.
+   * @param error The error message (output, if nullptr is returned).
+   * @return The writer or nullptr.
+   */
+  static std::unique_ptr<FrameLogWriter> Create(const std::string & path, std::string & error);
+
+  /**
+   * @brief Truncate the file to the appended data and close it.
+   */
+  ~FrameLogWriter();
+
+  FrameLogWriter(const FrameLogWriter &) = delete;
+  FrameLogWriter & operator=(const FrameLogWriter &) = delete;
+
+  /**
+   * @brief Append a frame.
+   *
+   * @param receive_time The receive time of the frame in ns.
+   * @param msg The message.
+   * @return False if the file could not be grown.
+   */
+  bool Append(
+    const std::int64_t receive_time, const autoware_mapless_planning_msgs::msg::RoadSegments & msg);
+  bool Append(const std::int64_t receive_time, const nav_msgs::msg::Odometry & msg);
+  bool Append(
+    const std::int64_t receive_time, const autoware_mapless_planning_msgs::msg::Mission & msg);
+
+  /**
+   * @brief Get the number of appended frames.
+   */
+  std::uint64_t GetFrameCount() const;
+
+  /**
+   * @brief Get the size of the appended data in bytes.
+   */
+  std::uint64_t GetSize() const;
+
+private:
+  FrameLogWriter(const int fd, const std::string & path);
+
+  // Make sure that size bytes can be appended (grows the file and the mapping)
+  bool Reserve(const std::size_t size);
+
+  // Allocate size bytes (8 byte aligned) at the end of the data and return their offset
+  bool Allocate(const std::size_t size, std::uint64_t & offset);
+
+  // Add the index entry of a frame whose payload was written and publish the frame
+  bool Commit(
+    const FrameLogType type, const std::int64_t receive_time, const std::uint64_t offset,
+    const std::size_t size);
+
+  FrameLogHeader * Header() const { return reinterpret_cast<FrameLogHeader *>(memory_); }
+
+  int fd_;
+  std::string path_;
+  std::uint8_t * memory_ = nullptr;
+  std::size_t capacity_ = 0;  // Size of the file and the mapping
+
+  // Offset of the current index block
+  std::uint64_t index_offset_ = 0;
+};
+
+/**
+ * @brief Reads the frames of a frame log file (random access).
+ */
+class FrameLogReader
+{
+public:
+  /**
+   * @brief Open a file.
+   *
+   * @param path The path of the file.
+   * @param error The error message (output, if nullptr is returned).
+   * @return The reader or nullptr.
+   */
+  static std::unique_ptr<FrameLogReader> Open(const std::string & path, std::string & error);
+
+  ~FrameLogReader();
+
+  FrameLogReader(const FrameLogReader &) = delete;
+  FrameLogReader & operator=(const FrameLogReader &) = delete;
+
+  /**
+   * @brief Get the number of frames.
+   */
+  std::size_t GetFrameCount() const { return n_frames_; }
+
+  /**
+   * @brief Get the type of a frame (O(1), the index must be smaller than GetFrameCount()).
+   */
+  FrameLogType GetFrameType(const std::size_t id_frame) const;
+
+  /**
+   * @brief Get the receive time of a frame in ns (O(1), the index must be smaller than
+   * GetFrameCount()).
+   */
+  std::int64_t GetReceiveTime(const std::size_t id_frame) const;
+
+  /**
+   * @brief Find the first frame which was received at or after a time (O(log n), the frames are
+   * ordered by their receive time).
+   *
+   * @param receive_time The receive time in ns.
+   * @return The index of the frame or GetFrameCount() if there is none.
+   */
+  std::size_t FindFrame(const std::int64_t receive_time) const;
+
+  /**
+   * @brief Read a frame (O(1) seek, the capacity of the containers of the message is reused).
+   *
+   * @param id_frame The index of the frame.
+   * @param msg The message (output).
+   * @return False if the index is out of range, the frame has another type or is malformed.
+   */
+  bool Read(
+    const std::size_t id_frame, autoware_mapless_planning_msgs::msg::RoadSegments & msg) const;
+  bool Read(const std::size_t id_frame, nav_msgs::msg::Odometry & msg) const;
+  bool Read(const std::size_t id_frame, autoware_mapless_planning_msgs::msg::Mission & msg) const;
+
+private:
+  FrameLogReader(const std::uint8_t * memory, const std::size_t size);
+
+  const FrameLogIndexEntry & Entry(const std::size_t id_frame) const;
+
+  // Get the payload of a frame of the given type (nullptr if it is not available)
+  const std::uint8_t * Payload(
+    const std::size_t id_frame, const FrameLogType type, std::size_t & size) const;
+
+  const std::uint8_t * memory_;
+  std::size_t size_;
+  std::size_t n_frames_ = 0;
+
+  // Entries of the index blocks
+  std::vector<const FrameLogIndexEntry *> index_blocks_;
+};
+
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__MAPLESS_RECORDER__FRAME_LOG_HPP_
@@ -0,0 +1,75 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__MAPLESS_RECORDER__RECORDER_NODE_HPP_
+#define AUTOWARE__MAPLESS_RECORDER__RECORDER_NODE_HPP_
+
+#include "autoware/mapless_recorder/frame_log.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "autoware_mapless_planning_msgs/msg/mission.hpp"
+#include "autoware_mapless_planning_msgs/msg/road_segments.hpp"
+#include "nav_msgs/msg/odometry.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace autoware::mapless_architecture
+{
+
+/**
+ * Node which records the inputs of the mission planner into a frame log.
+ */
+class RecorderNode : public rclcpp::Node
+{
+public:
+  /**
+   * @brief Constructor for the RecorderNode class.
+   *
+   * Creates the frame log and initializes the subscribers.
+   */
+  explicit RecorderNode(const rclcpp::NodeOptions & options);
+
+  /**
+   * @brief Destructor, closes the frame log.
+   */
+  ~RecorderNode() override;
+
+private:
+  /**
+   * @brief Append a message to the frame log (with the current time as receive time).
+   *
+   * @param msg The message.
+   */
+  template <typename T>
+  void Record_(const T & msg);
+
+  std::unique_ptr<FrameLogWriter> frame_log_;
+  std::string frame_log_path_;
+  std::size_t n_dropped_frames_ = 0;
+
+  // Declare ROS2 subscribers
+
+  rclcpp::Subscription<autoware_mapless_planning_msgs::msg::RoadSegments>::SharedPtr
+    road_subscriber_;
+
+  rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr odometry_subscriber_;
+
+  rclcpp::Subscription<autoware_mapless_planning_msgs::msg::Mission>::SharedPtr
+    mission_subscriber_;
+};
+}  // namespace autoware::mapless_architecture
+
+#endif  // AUTOWARE__MAPLESS_RECORDER__RECORDER_NODE_HPP_
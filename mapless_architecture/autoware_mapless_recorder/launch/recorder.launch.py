@@ -0,0 +1,43 @@
+# Copyright 2024 driveblocks GmbH
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from launch import LaunchDescription
+from launch_ros.actions import Node
+
+
+def generate_launch_description():
+    return LaunchDescription(
+        [
+            # autoware_mapless_recorder executable
+            Node(
+                package="autoware_mapless_recorder",
+                executable="autoware_mapless_recorder_exe",
+                name="autoware_mapless_recorder",
+                namespace="mapless_architecture",
+                remappings=[
+                    (
+                        "recorder_node/input/road_segments",
+                        "local_road_provider_node/output/road_segments",
+                    ),
+                    (
+                        "recorder_node/input/state_estimate",
+                        "/localization/kinematic_state",
+                    ),
+                    ("recorder_node/input/mission", "hmi_node/output/mission"),
+                ],
+                parameters=[],
+                output="screen",
+            ),
+        ]
+    )
@@ -0,0 +1,610 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/mapless_recorder/frame_log.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace autoware::mapless_architecture
+{
+
+namespace
+{
+
+// Initial size of the file and maximum growth step (the file is sparse until it is written)
+constexpr std::size_t kInitialCapacity = std::size_t{16} << 20;
+constexpr std::size_t kMaxGrowth = std::size_t{1} << 30;
+
+constexpr std::size_t kIndexBlockSize =
+  sizeof(FrameLogIndexBlock) + kFrameLogIndexBlockCapacity * sizeof(FrameLogIndexEntry);
+
+std::size_t AlignUp8(const std::size_t value) { return (value + 7) / 8 * 8; }
+
+// Sequential writer into a payload (the size is reserved by the caller)
+class PayloadWriter
+{
+public:
+  explicit PayloadWriter(std::uint8_t * data) : data_(data) {}
+
+  template <typename T>
+  void Put(const T & value)
+  {
+    std::memcpy(data_ + pos_, &value, sizeof(T));
+    pos_ += sizeof(T);
+  }
+
+  void PutBytes(const void * bytes, const std::size_t size)
+  {
+    if (size > 0) std::memcpy(data_ + pos_, bytes, size);
+    pos_ += size;
+  }
+
+  void PadTo8()
+  {
+    while (pos_ % 8 != 0) data_[pos_++] = 0;
+  }
+
+  std::size_t GetSize() const { return pos_; }
+
+private:
+  std::uint8_t * data_;
+  std::size_t pos_ = 0;
+};
+
+// Sequential reader of a payload, all reads are bounds-checked
+class PayloadReader
+{
+public:
+  PayloadReader(const std::uint8_t * data, const std::size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  bool Get(T & value)
+  {
+    if (size_ - pos_ < sizeof(T)) return false;
+    std::memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  // Read a string of the given length and skip the padding
+  bool GetString(const std::size_t length, std::string & value)
+  {
+    if (size_ - pos_ < length) return false;
+    value.assign(reinterpret_cast<const char *>(data_ + pos_), length);
+    pos_ += length;
+    return SkipTo8();
+  }
+
+  // Get the position of an array of n values of type T and skip it
+  template <typename T>
+  const std::uint8_t * GetArray(const std::size_t n)
+  {
+    if ((size_ - pos_) / sizeof(T) < n) return nullptr;
+    const std::uint8_t * array = data_ + pos_;
+    pos_ += n * sizeof(T);
+    return array;
+  }
+
+  bool SkipTo8()
+  {
+    pos_ = AlignUp8(pos_);
+    return pos_ <= size_;
+  }
+
+  std::size_t GetRemaining() const { return size_ - pos_; }
+
+private:
+  const std::uint8_t * data_;
+  std::size_t size_;
+  std::size_t pos_ = 0;
+};
+
+template <typename T>
+T LoadValue(const std::uint8_t * array, const std::size_t i)
+{
+  T value;
+  std::memcpy(&value, array + i * sizeof(T), sizeof(T));
+  return value;
+}
+
+std::string GetErrnoString(const std::string & what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+}  // namespace
+
+// --- FrameLogWriter ---
+
+std::unique_ptr<FrameLogWriter> FrameLogWriter::Create(
+  const std::string & path, std::string & error)
+{
+  const int fd = open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+  if (fd < 0) {
+    error = GetErrnoString("open(" + path + ")");
+    return nullptr;
+  }
+
+  std::unique_ptr<FrameLogWriter> writer(new FrameLogWriter(fd, path));
+  if (!writer->Reserve(sizeof(FrameLogHeader) + kIndexBlockSize)) {
+    error = GetErrnoString("Growing " + path);
+    return nullptr;
+  }
+
+  // The file is zero-initialized, i.e. only the non-zero fields are set
+  FrameLogHeader * header = writer->Header();
+  header->version = kFrameLogVersion;
+  header->first_index_offset = sizeof(FrameLogHeader);
+  header->end_offset = sizeof(FrameLogHeader) + kIndexBlockSize;
+  reinterpret_cast<FrameLogIndexBlock *>(writer->memory_ + header->first_index_offset)->capacity =
+    kFrameLogIndexBlockCapacity;
+  writer->index_offset_ = header->first_index_offset;
+  header->magic = kFrameLogMagic;
+  return writer;
+}
+
+FrameLogWriter::FrameLogWriter(const int fd, const std::string & path) : fd_(fd), path_(path)
+{
+}
+
+FrameLogWriter::~FrameLogWriter()
+{
+  std::uint64_t end_offset = 0;
+  if (memory_) {
+    end_offset = Header()->end_offset;
+    munmap(memory_, capacity_);
+  }
+  // Remove the unused (sparse) reserve at the end of the file (a file with the reserve is valid as
+  // well, i.e. a failure is ignored)
+  if (end_offset > 0) {
+    [[maybe_unused]] const bool is_truncated = ftruncate(fd_, static_cast<off_t>(end_offset)) == 0;
+  }
+  close(fd_);
+}
+
+std::uint64_t FrameLogWriter::GetFrameCount() const { return Header()->n_frames; }
+
+std::uint64_t FrameLogWriter::GetSize() const { return Header()->end_offset; }
+
+bool FrameLogWriter::Reserve(const std::size_t size)
+{
+  if (size <= capacity_) return true;
+
+  std::size_t capacity = std::max(capacity_, kInitialCapacity);
+  while (capacity < size) capacity += std::min(capacity, kMaxGrowth);
+
+  if (ftruncate(fd_, static_cast<off_t>(capacity)) != 0) return false;
+  void * memory = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (memory == MAP_FAILED) return false;
+
+  if (memory_) munmap(memory_, capacity_);
+  memory_ = static_cast<std::uint8_t *>(memory);
+  capacity_ = capacity;
+  return true;
+}
+
+bool FrameLogWriter::Allocate(const std::size_t size, std::uint64_t & offset)
+{
+  offset = Header()->end_offset;
+  const std::size_t end_offset = AlignUp8(offset + size);
+  if (!Reserve(end_offset)) return false;
+  Header()->end_offset = end_offset;
+  return true;
+}
+
+bool FrameLogWriter::Commit(
+  const FrameLogType type, const std::int64_t receive_time, const std::uint64_t offset,
+  const std::size_t size)
+{
+  const std::uint64_t n_frames = Header()->n_frames;
+  const std::size_t id_entry = n_frames % kFrameLogIndexBlockCapacity;
+
+  // Chain a new index block if the current one is full
+  if (n_frames > 0 && id_entry == 0) {
+    std::uint64_t index_offset;
+    if (!Allocate(kIndexBlockSize, index_offset)) return false;
+    reinterpret_cast<FrameLogIndexBlock *>(memory_ + index_offset)->capacity =
+      kFrameLogIndexBlockCapacity;
+    reinterpret_cast<FrameLogIndexBlock *>(memory_ + index_offset_)->next_offset = index_offset;
+    index_offset_ = index_offset;
+  }
+
+  FrameLogIndexEntry * entries =
+    reinterpret_cast<FrameLogIndexEntry *>(memory_ + index_offset_ + sizeof(FrameLogIndexBlock));
+  entries[id_entry] = {offset, receive_time, static_cast<std::uint32_t>(type),
+                       static_cast<std::uint32_t>(size)};
+
+  // The frame becomes visible to readers
+  Header()->n_frames = n_frames + 1;
+  return true;
+}
+
+bool FrameLogWriter::Append(
+  const std::int64_t receive_time, const autoware_mapless_planning_msgs::msg::RoadSegments & msg)
+{
+  std::size_t n_ids = 0;
+  std::size_t n_points = 0;
+  for (const auto & segment : msg.segments) {
+    n_ids += segment.successor_segment_id.size() + segment.neighboring_segment_id.size();
+    n_points += segment.linestrings[0].poses.size() + segment.linestrings[1].poses.size();
+  }
+  const std::size_t size = sizeof(RoadSegmentsFrameRecord) + AlignUp8(msg.header.frame_id.size()) +
+                           msg.segments.size() * sizeof(SegmentFrameRecord) +
+                           AlignUp8(n_ids * sizeof(std::int32_t)) + n_points * 3 * sizeof(double);
+
+  std::uint64_t offset;
+  if (!Allocate(size, offset)) return false;
+  PayloadWriter writer(memory_ + offset);
+
+  RoadSegmentsFrameRecord frame_record{};
+  frame_record.stamp_sec = msg.header.stamp.sec;
+  frame_record.stamp_nanosec = msg.header.stamp.nanosec;
+  frame_record.position[0] = msg.pose.position.x;
+  frame_record.position[1] = msg.pose.position.y;
+  frame_record.position[2] = msg.pose.position.z;
+  frame_record.orientation[0] = msg.pose.orientation.x;
+  frame_record.orientation[1] = msg.pose.orientation.y;
+  frame_record.orientation[2] = msg.pose.orientation.z;
+  frame_record.orientation[3] = msg.pose.orientation.w;
+  frame_record.n_segments = static_cast<std::uint32_t>(msg.segments.size());
+  frame_record.n_points = static_cast<std::uint32_t>(n_points);
+  frame_record.frame_id_length = static_cast<std::uint32_t>(msg.header.frame_id.size());
+  writer.Put(frame_record);
+  writer.PutBytes(msg.header.frame_id.data(), msg.header.frame_id.size());
+  writer.PadTo8();
+
+  for (const auto & segment : msg.segments) {
+    SegmentFrameRecord segment_record{};
+    segment_record.id = segment.id;
+    segment_record.n_successors = static_cast<std::uint32_t>(segment.successor_segment_id.size());
+    segment_record.n_neighbors = static_cast<std::uint32_t>(segment.neighboring_segment_id.size());
+    segment_record.n_points_left = static_cast<std::uint32_t>(segment.linestrings[0].poses.size());
+    segment_record.n_points_right = static_cast<std::uint32_t>(segment.linestrings[1].poses.size());
+    writer.Put(segment_record);
+  }
+  for (const auto & segment : msg.segments) {
+    for (const std::int32_t id : segment.successor_segment_id) writer.Put(id);
+    for (const std::int32_t id : segment.neighboring_segment_id) writer.Put(id);
+  }
+  writer.PadTo8();
+
+  // Point block (structure of arrays)
+  for (std::size_t coordinate = 0; coordinate < 3; coordinate++) {
+    for (const auto & segment : msg.segments) {
+      for (const auto & linestring : segment.linestrings) {
+        for (const auto & pose : linestring.poses) {
+          writer.Put(
+            coordinate == 0   ? pose.position.x
+            : coordinate == 1 ? pose.position.y
+                              : pose.position.z);
+        }
+      }
+    }
+  }
+
+  return Commit(FrameLogType::kRoadSegments, receive_time, offset, writer.GetSize());
+}
+
+bool FrameLogWriter::Append(const std::int64_t receive_time, const nav_msgs::msg::Odometry & msg)
+{
+  const std::size_t size = sizeof(OdometryFrameRecord) + AlignUp8(msg.header.frame_id.size()) +
+                           AlignUp8(msg.child_frame_id.size());
+
+  std::uint64_t offset;
+  if (!Allocate(size, offset)) return false;
+  PayloadWriter writer(memory_ + offset);
+
+  OdometryFrameRecord record{};
+  record.stamp_sec = msg.header.stamp.sec;
+  record.stamp_nanosec = msg.header.stamp.nanosec;
+  record.frame_id_length = static_cast<std::uint32_t>(msg.header.frame_id.size());
+  record.child_frame_id_length = static_cast<std::uint32_t>(msg.child_frame_id.size());
+  const auto & pose = msg.pose.pose;
+  const double pose_values[7] = {pose.position.x,    pose.position.y,    pose.position.z,
+                                 pose.orientation.x, pose.orientation.y, pose.orientation.z,
+                                 pose.orientation.w};
+  std::copy(std::begin(pose_values), std::end(pose_values), record.pose);
+  std::copy(msg.pose.covariance.begin(), msg.pose.covariance.end(), record.pose_covariance);
+  const auto & twist = msg.twist.twist;
+  const double twist_values[6] = {twist.linear.x,  twist.linear.y,  twist.linear.z,
+                                  twist.angular.x, twist.angular.y, twist.angular.z};
+  std::copy(std::begin(twist_values), std::end(twist_values), record.twist);
+  std::copy(msg.twist.covariance.begin(), msg.twist.covariance.end(), record.twist_covariance);
+  writer.Put(record);
+  writer.PutBytes(msg.header.frame_id.data(), msg.header.frame_id.size());
+  writer.PadTo8();
+  writer.PutBytes(msg.child_frame_id.data(), msg.child_frame_id.size());
+  writer.PadTo8();
+
+  return Commit(FrameLogType::kOdometry, receive_time, offset, writer.GetSize());
+}
+
+bool FrameLogWriter::Append(
+  const std::int64_t receive_time, const autoware_mapless_planning_msgs::msg::Mission & msg)
+{
+  std::uint64_t offset;
+  if (!Allocate(sizeof(MissionFrameRecord), offset)) return false;
+
+  MissionFrameRecord record{};
+  record.stamp_sec = msg.stamp.sec;
+  record.stamp_nanosec = msg.stamp.nanosec;
+  record.mission_type = msg.mission_type;
+  record.priority = msg.priority;
+  record.deadline = msg.deadline;
+  std::memcpy(memory_ + offset, &record, sizeof(record));
+
+  return Commit(FrameLogType::kMission, receive_time, offset, sizeof(record));
+}
+
+// --- FrameLogReader ---
+
+std::unique_ptr<FrameLogReader> FrameLogReader::Open(
+  const std::string & path, std::string & error)
+{
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    error = GetErrnoString("open(" + path + ")");
+    return nullptr;
+  }
+
+  struct stat stat_buffer;
+  if (fstat(fd, &stat_buffer) != 0) {
+    error = GetErrnoString("fstat(" + path + ")");
+    close(fd);
+    return nullptr;
+  }
+  const std::size_t size = static_cast<std::size_t>(stat_buffer.st_size);
+  // Every frame log has the header and the first index block (also checked first, as the size
+  // minus the size of an index block bounds the offsets of the index blocks)
+  if (size < sizeof(FrameLogHeader) + kIndexBlockSize) {
+    error = path + " is not a frame log (too small)";
+    close(fd);
+    return nullptr;
+  }
+
+  void * memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    error = GetErrnoString("mmap(" + path + ")");
+    return nullptr;
+  }
+
+  std::unique_ptr<FrameLogReader> reader(
+    new FrameLogReader(static_cast<const std::uint8_t *>(memory), size));
+
+  FrameLogHeader header;
+  std::memcpy(&header, memory, sizeof(header));
+  if (header.magic != kFrameLogMagic || header.version != kFrameLogVersion) {
+    error = path + " is not a frame log (version " + std::to_string(kFrameLogVersion) + ")";
+    return nullptr;
+  }
+
+  // Collect the index blocks (once), afterwards every frame is found in O(1)
+  const std::size_t n_blocks =
+    (header.n_frames + kFrameLogIndexBlockCapacity - 1) / kFrameLogIndexBlockCapacity;
+  std::uint64_t offset = header.first_index_offset;
+  for (std::size_t i = 0; i < n_blocks; i++) {
+    if (offset % 8 != 0 || offset < sizeof(FrameLogHeader) || offset > size - kIndexBlockSize) {
+      error = path + " has a malformed index";
+      return nullptr;
+    }
+    FrameLogIndexBlock block;
+    std::memcpy(&block, reader->memory_ + offset, sizeof(block));
+    if (block.capacity != kFrameLogIndexBlockCapacity) {
+      error = path + " has a malformed index";
+      return nullptr;
+    }
+    reader->index_blocks_.push_back(reinterpret_cast<const FrameLogIndexEntry *>(
+      reader->memory_ + offset + sizeof(FrameLogIndexBlock)));
+    offset = block.next_offset;
+  }
+  reader->n_frames_ = header.n_frames;
+  return reader;
+}
+
+FrameLogReader::FrameLogReader(const std::uint8_t * memory, const std::size_t size)
+: memory_(memory), size_(size)
+{
+}
+
+FrameLogReader::~FrameLogReader() { munmap(const_cast<std::uint8_t *>(memory_), size_); }
+
+const FrameLogIndexEntry & FrameLogReader::Entry(const std::size_t id_frame) const
+{
+  return index_blocks_[id_frame / kFrameLogIndexBlockCapacity]
+                      [id_frame % kFrameLogIndexBlockCapacity];
+}
+
+FrameLogType FrameLogReader::GetFrameType(const std::size_t id_frame) const
+{
+  return static_cast<FrameLogType>(Entry(id_frame).type);
+}
+
+std::int64_t FrameLogReader::GetReceiveTime(const std::size_t id_frame) const
+{
+  return Entry(id_frame).receive_time;
+}
+
+std::size_t FrameLogReader::FindFrame(const std::int64_t receive_time) const
+{
+  std::size_t first = 0;
+  std::size_t count = n_frames_;
+  while (count > 0) {
+    const std::size_t step = count / 2;
+    if (GetReceiveTime(first + step) < receive_time) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+const std::uint8_t * FrameLogReader::Payload(
+  const std::size_t id_frame, const FrameLogType type, std::size_t & size) const
+{
+  if (id_frame >= n_frames_) return nullptr;
+
+  const FrameLogIndexEntry & entry = Entry(id_frame);
+  if (
+    entry.type != static_cast<std::uint32_t>(type) || entry.offset % 8 != 0 ||
+    entry.offset > size_ || entry.size > size_ - entry.offset) {
+    return nullptr;
+  }
+  size = entry.size;
+  return memory_ + entry.offset;
+}
+
+bool FrameLogReader::Read(
+  const std::size_t id_frame, autoware_mapless_planning_msgs::msg::RoadSegments & msg) const
+{
+  std::size_t size;
+  const std::uint8_t * payload = Payload(id_frame, FrameLogType::kRoadSegments, size);
+  if (!payload) return false;
+  PayloadReader reader(payload, size);
+
+  RoadSegmentsFrameRecord frame_record;
+  if (
+    !reader.Get(frame_record) ||
+    !reader.GetString(frame_record.frame_id_length, msg.header.frame_id) ||
+    frame_record.n_segments > reader.GetRemaining() / sizeof(SegmentFrameRecord) ||
+    frame_record.n_points > reader.GetRemaining() / (3 * sizeof(double))) {
+    return false;
+  }
+  msg.header.stamp.sec = frame_record.stamp_sec;
+  msg.header.stamp.nanosec = frame_record.stamp_nanosec;
+  msg.pose.position.x = frame_record.position[0];
+  msg.pose.position.y = frame_record.position[1];
+  msg.pose.position.z = frame_record.position[2];
+  msg.pose.orientation.x = frame_record.orientation[0];
+  msg.pose.orientation.y = frame_record.orientation[1];
+  msg.pose.orientation.z = frame_record.orientation[2];
+  msg.pose.orientation.w = frame_record.orientation[3];
+
+  // Segment records (the counts are checked against the payload before anything is allocated)
+  msg.segments.resize(frame_record.n_segments);
+  std::size_t n_ids = 0;
+  std::size_t n_points = 0;
+  for (auto & segment : msg.segments) {
+    SegmentFrameRecord segment_record;
+    if (!reader.Get(segment_record)) return false;
+    n_ids += static_cast<std::size_t>(segment_record.n_successors) + segment_record.n_neighbors;
+    n_points +=
+      static_cast<std::size_t>(segment_record.n_points_left) + segment_record.n_points_right;
+    if (n_ids > reader.GetRemaining() / sizeof(std::int32_t) || n_points > frame_record.n_points) {
+      return false;
+    }
+    segment.id = static_cast<std::uint16_t>(segment_record.id);
+    segment.successor_segment_id.resize(segment_record.n_successors);
+    segment.neighboring_segment_id.resize(segment_record.n_neighbors);
+    segment.linestrings[0].poses.resize(segment_record.n_points_left);
+    segment.linestrings[1].poses.resize(segment_record.n_points_right);
+  }
+  if (n_points != frame_record.n_points) return false;
+
+  const std::uint8_t * ids = reader.GetArray<std::int32_t>(n_ids);
+  if (!ids || !reader.SkipTo8()) return false;
+  std::size_t id_index = 0;
+  for (auto & segment : msg.segments) {
+    for (auto & id : segment.successor_segment_id) id = LoadValue<std::int32_t>(ids, id_index++);
+    for (auto & id : segment.neighboring_segment_id) id = LoadValue<std::int32_t>(ids, id_index++);
+  }
+
+  // Point block (structure of arrays)
+  const std::uint8_t * x = reader.GetArray<double>(n_points);
+  const std::uint8_t * y = reader.GetArray<double>(n_points);
+  const std::uint8_t * z = reader.GetArray<double>(n_points);
+  if (!x || !y || !z) return false;
+  std::size_t id_point = 0;
+  for (auto & segment : msg.segments) {
+    for (auto & linestring : segment.linestrings) {
+      for (auto & pose : linestring.poses) {
+        pose.position.x = LoadValue<double>(x, id_point);
+        pose.position.y = LoadValue<double>(y, id_point);
+        pose.position.z = LoadValue<double>(z, id_point);
+        pose.orientation = geometry_msgs::msg::Quaternion();
+        id_point++;
+      }
+    }
+  }
+  return true;
+}
+
+bool FrameLogReader::Read(const std::size_t id_frame, nav_msgs::msg::Odometry & msg) const
+{
+  std::size_t size;
+  const std::uint8_t * payload = Payload(id_frame, FrameLogType::kOdometry, size);
+  if (!payload) return false;
+  PayloadReader reader(payload, size);
+
+  OdometryFrameRecord record;
+  if (
+    !reader.Get(record) || !reader.GetString(record.frame_id_length, msg.header.frame_id) ||
+    !reader.GetString(record.child_frame_id_length, msg.child_frame_id)) {
+    return false;
+  }
+  msg.header.stamp.sec = record.stamp_sec;
+  msg.header.stamp.nanosec = record.stamp_nanosec;
+  auto & pose = msg.pose.pose;
+  pose.position.x = record.pose[0];
+  pose.position.y = record.pose[1];
+  pose.position.z = record.pose[2];
+  pose.orientation.x = record.pose[3];
+  pose.orientation.y = record.pose[4];
+  pose.orientation.z = record.pose[5];
+  pose.orientation.w = record.pose[6];
+  std::copy(
+    std::begin(record.pose_covariance), std::end(record.pose_covariance),
+    msg.pose.covariance.begin());
+  auto & twist = msg.twist.twist;
+  twist.linear.x = record.twist[0];
+  twist.linear.y = record.twist[1];
+  twist.linear.z = record.twist[2];
+  twist.angular.x = record.twist[3];
+  twist.angular.y = record.twist[4];
+  twist.angular.z = record.twist[5];
+  std::copy(
+    std::begin(record.twist_covariance), std::end(record.twist_covariance),
+    msg.twist.covariance.begin());
+  return true;
+}
+
+bool FrameLogReader::Read(
+  const std::size_t id_frame, autoware_mapless_planning_msgs::msg::Mission & msg) const
+{
+  std::size_t size;
+  const std::uint8_t * payload = Payload(id_frame, FrameLogType::kMission, size);
+  if (!payload) return false;
+  PayloadReader reader(payload, size);
+
+  MissionFrameRecord record;
+  if (!reader.Get(record)) return false;
+  msg.stamp.sec = record.stamp_sec;
+  msg.stamp.nanosec = record.stamp_nanosec;
+  msg.mission_type = record.mission_type;
+  msg.priority = record.priority;
+  msg.deadline = record.deadline;
+  return true;
+}
+
+}  // namespace autoware::mapless_architecture
@@ -0,0 +1,83 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/mapless_recorder/recorder_node.hpp"
+
+#include <string>
+
+namespace autoware::mapless_architecture
+{
+
+RecorderNode::RecorderNode(const rclcpp::NodeOptions & options) : Node("recorder_node", options)
+{
+  // ROS parameters (will be overwritten by external param file if exists)
+  const std::string output_directory =
+    declare_parameter<std::string>("output_directory", "/tmp");
+  RCLCPP_INFO(
+    this->get_logger(), "Output directory of the recordings: %s", output_directory.c_str());
+
+  frame_log_path_ =
+    output_directory + "/mapless_inputs_" + std::to_string(this->now().nanoseconds()) + ".mlog";
+  std::string error;
+  frame_log_ = FrameLogWriter::Create(frame_log_path_, error);
+  if (!frame_log_) {
+    RCLCPP_ERROR(this->get_logger(), "Could not create the recording: %s", error.c_str());
+    return;
+  }
+  RCLCPP_INFO(this->get_logger(), "Recording the inputs to %s", frame_log_path_.c_str());
+
+  // Best effort as the mission planner, but with a deeper queue (every frame should be recorded)
+  auto qos = rclcpp::QoS(10);
+  qos.best_effort();
+
+  road_subscriber_ = this->create_subscription<autoware_mapless_planning_msgs::msg::RoadSegments>(
+    "recorder_node/input/road_segments", qos,
+    [this](const autoware_mapless_planning_msgs::msg::RoadSegments & msg) { Record_(msg); });
+
+  odometry_subscriber_ = this->create_subscription<nav_msgs::msg::Odometry>(
+    "recorder_node/input/state_estimate", qos,
+    [this](const nav_msgs::msg::Odometry & msg) { Record_(msg); });
+
+  mission_subscriber_ = this->create_subscription<autoware_mapless_planning_msgs::msg::Mission>(
+    "recorder_node/input/mission", qos,
+    [this](const autoware_mapless_planning_msgs::msg::Mission & msg) { Record_(msg); });
+}
+
+RecorderNode::~RecorderNode()
+{
+  if (!frame_log_) return;
+
+  RCLCPP_INFO(
+    this->get_logger(), "Recorded %zu frames (%zu bytes, dropped frames: %zu) to %s",
+    static_cast<std::size_t>(frame_log_->GetFrameCount()),
+    static_cast<std::size_t>(frame_log_->GetSize()), n_dropped_frames_, frame_log_path_.c_str());
+}
+
+template <typename T>
+void RecorderNode::Record_(const T & msg)
+{
+  if (!frame_log_->Append(this->now().nanoseconds(), msg)) {
+    n_dropped_frames_++;
+    RCLCPP_ERROR_THROTTLE(
+      this->get_logger(), *this->get_clock(), 5000,
+      "Could not grow the recording %s, dropped frames so far: %zu", frame_log_path_.c_str(),
+      n_dropped_frames_);
+  }
+}
+
+}  // namespace autoware::mapless_architecture
+
+#include "rclcpp_components/register_node_macro.hpp"
+
+RCLCPP_COMPONENTS_REGISTER_NODE(autoware::mapless_architecture::RecorderNode)
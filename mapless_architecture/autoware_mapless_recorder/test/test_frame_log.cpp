@@ -0,0 +1,207 @@
+// Copyright 2024 driveblocks GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/mapless_recorder/frame_log.hpp"
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+namespace autoware::mapless_architecture
+{
+
+namespace
+{
+
+// Road segments whose content depends on the index of the frame
+autoware_mapless_planning_msgs::msg::RoadSegments CreateRoadSegments(const int id_frame)
+{
+  autoware_mapless_planning_msgs::msg::RoadSegments msg;
+  msg.header.frame_id = "map";
+  msg.header.stamp.sec = id_frame;
+  msg.pose.position.x = 0.5 * id_frame;
+  msg.pose.orientation.w = 1.0;
+
+  const int n_segments = 1 + id_frame % 4;
+  for (int i = 0; i < n_segments; i++) {
+    autoware_mapless_planning_msgs::msg::Segment segment;
+    segment.id = static_cast<std::uint16_t>(i);
+    segment.successor_segment_id.push_back(i + 1 < n_segments ? i + 1 : -1);
+    segment.neighboring_segment_id = {-1, -1};
+    for (int j = 0; j < 2; j++) {
+      for (int k = 0; k < 3 + i; k++) {
+        geometry_msgs::msg::Pose pose;
+        pose.position.x = 10.0 * i + k;
+        pose.position.y = j == 0 ? 1.75 : -1.75;
+        pose.position.z = 0.01 * id_frame;
+        segment.linestrings[j].poses.push_back(pose);
+      }
+    }
+    msg.segments.push_back(segment);
+  }
+  return msg;
+}
+
+}  // namespace
+
+TEST(FrameLogTest, TestWriteAndSeek)
+{
+  const std::string path =
+    "/tmp/test_frame_log_" + std::to_string(static_cast<long>(getpid())) + ".mlog";  // NOLINT
+
+  // More frames than fit into one index block
+  const int n_frames = 3 * static_cast<int>(kFrameLogIndexBlockCapacity) + 17;
+  {
+    std::string error;
+    std::unique_ptr<FrameLogWriter> writer = FrameLogWriter::Create(path, error);
+    ASSERT_NE(writer, nullptr) << error;
+
+    for (int i = 0; i < n_frames; i++) {
+      const std::int64_t receive_time = 1000 * static_cast<std::int64_t>(i);
+      if (i % 3 == 0) {
+        ASSERT_TRUE(writer->Append(receive_time, CreateRoadSegments(i)));
+      } else if (i % 3 == 1) {
+        nav_msgs::msg::Odometry odometry;
+        odometry.header.frame_id = "map";
+        odometry.child_frame_id = "base_link";
+        odometry.pose.pose.position.x = i;
+        odometry.twist.twist.linear.x = 2.0 * i;
+        odometry.pose.covariance[35] = 0.1;
+        ASSERT_TRUE(writer->Append(receive_time, odometry));
+      } else {
+        autoware_mapless_planning_msgs::msg::Mission mission;
+        mission.mission_type = autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_LEFT;
+        mission.deadline = static_cast<float>(i);
+        mission.priority = autoware_mapless_planning_msgs::msg::Mission::PRIORITY_HIGH;
+        mission.stamp.sec = i;
+        mission.stamp.nanosec = 1000u * static_cast<std::uint32_t>(i);
+        ASSERT_TRUE(writer->Append(receive_time, mission));
+      }
+    }
+    EXPECT_EQ(writer->GetFrameCount(), static_cast<std::uint64_t>(n_frames));
+  }
+
+  std::string error;
+  std::unique_ptr<FrameLogReader> reader = FrameLogReader::Open(path, error);
+  ASSERT_NE(reader, nullptr) << error;
+  ASSERT_EQ(reader->GetFrameCount(), static_cast<std::size_t>(n_frames));
+
+  // Seek to frames in arbitrary order (also across the index blocks)
+  for (const int i : {n_frames - 1, 0, 4098, 12288, 7, 8193, 4095}) {
+    EXPECT_EQ(reader->GetReceiveTime(i), 1000 * static_cast<std::int64_t>(i));
+
+    if (i % 3 == 0) {
+      EXPECT_EQ(reader->GetFrameType(i), FrameLogType::kRoadSegments);
+      autoware_mapless_planning_msgs::msg::RoadSegments msg;
+      ASSERT_TRUE(reader->Read(i, msg));
+
+      const autoware_mapless_planning_msgs::msg::RoadSegments expected = CreateRoadSegments(i);
+      EXPECT_EQ(msg.header.frame_id, expected.header.frame_id);
+      EXPECT_EQ(msg.header.stamp.sec, expected.header.stamp.sec);
+      EXPECT_EQ(msg.pose.position.x, expected.pose.position.x);
+      ASSERT_EQ(msg.segments.size(), expected.segments.size());
+      for (std::size_t j = 0; j < msg.segments.size(); j++) {
+        EXPECT_EQ(msg.segments[j].id, expected.segments[j].id);
+        EXPECT_EQ(msg.segments[j].successor_segment_id, expected.segments[j].successor_segment_id);
+        EXPECT_EQ(
+          msg.segments[j].neighboring_segment_id, expected.segments[j].neighboring_segment_id);
+        for (std::size_t k = 0; k < 2; k++) {
+          const auto & poses = msg.segments[j].linestrings[k].poses;
+          const auto & expected_poses = expected.segments[j].linestrings[k].poses;
+          ASSERT_EQ(poses.size(), expected_poses.size());
+          for (std::size_t l = 0; l < poses.size(); l++) {
+            EXPECT_EQ(poses[l].position.x, expected_poses[l].position.x);
+            EXPECT_EQ(poses[l].position.y, expected_poses[l].position.y);
+            EXPECT_EQ(poses[l].position.z, expected_poses[l].position.z);
+          }
+        }
+      }
+    } else if (i % 3 == 1) {
+      EXPECT_EQ(reader->GetFrameType(i), FrameLogType::kOdometry);
+      nav_msgs::msg::Odometry odometry;
+      ASSERT_TRUE(reader->Read(i, odometry));
+      EXPECT_EQ(odometry.header.frame_id, "map");
+      EXPECT_EQ(odometry.child_frame_id, "base_link");
+      EXPECT_EQ(odometry.pose.pose.position.x, i);
+      EXPECT_EQ(odometry.twist.twist.linear.x, 2.0 * i);
+      EXPECT_EQ(odometry.pose.covariance[35], 0.1);
+    } else {
+      EXPECT_EQ(reader->GetFrameType(i), FrameLogType::kMission);
+      autoware_mapless_planning_msgs::msg::Mission mission;
+      ASSERT_TRUE(reader->Read(i, mission));
+      EXPECT_EQ(
+        mission.mission_type, autoware_mapless_planning_msgs::msg::Mission::LANE_CHANGE_LEFT);
+      EXPECT_EQ(mission.deadline, static_cast<float>(i));
+      EXPECT_EQ(mission.priority, autoware_mapless_planning_msgs::msg::Mission::PRIORITY_HIGH);
+      EXPECT_EQ(mission.stamp.sec, i);
+      EXPECT_EQ(mission.stamp.nanosec, 1000u * static_cast<std::uint32_t>(i));
+    }
+  }
+
+  // A frame of another type or out of range is not read
+  autoware_mapless_planning_msgs::msg::Mission mission;
+  EXPECT_FALSE(reader->Read(0, mission));
+  EXPECT_FALSE(reader->Read(n_frames, mission));
+
+  // Find frames by their receive time
+  EXPECT_EQ(reader->FindFrame(0), 0u);
+  EXPECT_EQ(reader->FindFrame(5500), 6u);
+  EXPECT_EQ(reader->FindFrame(6000), 6u);
+  EXPECT_EQ(reader->FindFrame(1000 * static_cast<std::int64_t>(n_frames)), reader->GetFrameCount());
+
+  std::remove(path.c_str());
+}
+
+TEST(FrameLogTest, TestOpenInvalidFile)
+{
+  const std::string path =
+    "/tmp/test_frame_log_invalid_" + std::to_string(static_cast<long>(getpid()));  // NOLINT
+  FILE * file = std::fopen(path.c_str(), "w");
+  ASSERT_NE(file, nullptr);
+  std::fputs("no frame log", file);
+  std::fclose(file);
+
+  std::string error;
+  EXPECT_EQ(FrameLogReader::Open(path, error), nullptr);
+  EXPECT_FALSE(error.empty());
+  EXPECT_EQ(FrameLogReader::Open(path + "_missing", error), nullptr);
+
+  std::remove(path.c_str());
+}
+
+TEST(FrameLogTest, TestOpenTruncatedFile)
+{
+  const std::string path =
+    "/tmp/test_frame_log_truncated_" + std::to_string(static_cast<long>(getpid()));  // NOLINT
+  {
+    std::string error;
+    std::unique_ptr<FrameLogWriter> writer = FrameLogWriter::Create(path, error);
+    ASSERT_NE(writer, nullptr) << error;
+    ASSERT_TRUE(writer->Append(0, CreateRoadSegments(0)));
+  }
+
+  // The header is intact, the first index block is cut off (the file is smaller than an index
+  // block)
+  ASSERT_EQ(truncate(path.c_str(), sizeof(FrameLogHeader) + 64), 0);
+
+  std::string error;
+  EXPECT_EQ(FrameLogReader::Open(path, error), nullptr);
+  EXPECT_FALSE(error.empty());
+
+  std::remove(path.c_str());
+}
+
+}  // namespace autoware::mapless_architecture
@@ -16,22 +16,44 @@
 #define AUTOWARE__MISSION_LANE_CONVERTER__MISSION_LANE_CONVERTER_NODE_HPP_
 
 #include "autoware/local_mission_planner_common/helper_functions.hpp"
+#include "autoware/local_mission_planner_common/stage_profiler.hpp"
+#include "diagnostic_updater/diagnostic_updater.hpp"
 #include "rclcpp/rclcpp.hpp"
 
 #include "autoware_mapless_planning_msgs/msg/mission_lanes_stamped.hpp"
 #include "autoware_planning_msgs/msg/path.hpp"
 #include "autoware_planning_msgs/msg/trajectory.hpp"
 #include "nav_msgs/msg/odometry.hpp"
+#include "std_msgs/msg/header.hpp"
+#include "std_srvs/srv/trigger.hpp"
 #include "visualization_msgs/msg/marker.hpp"
 #include "visualization_msgs/msg/marker_array.hpp"
 
+#include <memory>
 #include <string>
-#include <tuple>
 #include <vector>
 
 namespace autoware::mapless_architecture
 {
 
+/**
+ * @brief Output messages of the mission conversion, owned by the caller and reused across frames
+ * (the containers keep their capacity, so no reallocation is needed in steady state).
+ */
+struct ConversionOutput
+{
+  // Local frame
+  autoware_planning_msgs::msg::Trajectory trajectory;
+  autoware_planning_msgs::msg::Path path;
+  visualization_msgs::msg::Marker trajectory_vis;
+  visualization_msgs::msg::MarkerArray path_area_vis;
+
+  // Global map frame
+  autoware_planning_msgs::msg::Trajectory trajectory_global;
+  autoware_planning_msgs::msg::Path path_global;
+  visualization_msgs::msg::Marker trajectory_vis_global;
+};
+
 /**
  * Node to convert the mission lane to an autoware trajectory type.
  */
@@ -54,15 +76,33 @@ public:
    * @brief Converts the mission message into a reference trajectory which is
    * forwarded to a local trajectory planner for refinement.
    *
+   * The local messages and their global map frame variants are written into the given output,
+   * whose previous content is overwritten.
+   *
    * @param msg The mission lanes.
-   * @return std::tuple<autoware_planning_msgs::msg::Trajectory,
-   * visualization_msgs::msg::Marker, autoware_planning_msgs::msg::Path,
-   * visualization_msgs::msg::Marker>.
+   * @param output The output messages (reused across calls).
+   * @param convert_to_global_frame Whether the global map frame variants are computed as well.
    */
-  std::tuple<
-    autoware_planning_msgs::msg::Trajectory, visualization_msgs::msg::Marker,
-    autoware_planning_msgs::msg::Path, visualization_msgs::msg::MarkerArray>
-  ConvertMissionToTrajectory(const autoware_mapless_planning_msgs::msg::MissionLanesStamped & msg);
+  void ConvertMissionToTrajectory(
+    const autoware_mapless_planning_msgs::msg::MissionLanesStamped & msg,
+    ConversionOutput & output, const bool convert_to_global_frame = true);
+
+  /**
+   * @brief Store an odometry update, the global map frame output has to be transformed again.
+   *
+   * @param msg The odometry.
+   */
+  void UpdateOdometry(const nav_msgs::msg::Odometry & msg);
+
+  /**
+   * @brief Transform the local messages of a conversion output into the global map frame again
+   * with the latest odometry (timed global output). The global messages are stamped with the
+   * stamp of the odometry, i.e. the time at which the transformation is valid (unchanged if no
+   * odometry was received).
+   *
+   * @param output The conversion output.
+   */
+  void RetransformToGlobalFrame(ConversionOutput & output);
 
 private:
   /**
@@ -112,6 +152,32 @@ private:
    */
   void TimedStartupTrajectoryCallback();
 
+  /**
+   * @brief Build the (local) startup trajectory and path, which are cached until the target speed
+   * changes.
+   */
+  void BuildStartupTemplate_();
+
+  /**
+   * @brief Callback function for parameter changes (target_speed).
+   *
+   * @param parameters The changed parameters.
+   */
+  rcl_interfaces::msg::SetParametersResult ParamCallback_(
+    const std::vector<rclcpp::Parameter> & parameters);
+
+  /**
+   * @brief Timed callback (global_output_rate_hz) which transforms the latest local trajectory and
+   * path with the newest odometry and publishes them, if either of them changed since the last
+   * output.
+   */
+  void TimedGlobalOutputCallback_();
+
+  /**
+   * @brief Publish the global map frame messages of the conversion output.
+   */
+  void PublishGlobalOutput_();
+
   /**
    *@brief Create a path bound.
    *
@@ -157,24 +223,54 @@ private:
   void CallbackOdometryMessages_(const nav_msgs::msg::Odometry & msg);
 
   /**
-   * @brief Template to transform both Autoware::Path and Autoware::Trajectory into a global map
-   * frame.
+   * @brief Transform a trajectory and a path into the global map frame in a single pass.
+   *
+   * Points which the trajectory and the path have in common (the path is built from the same
+   * centerline) are transformed only once. The orientations of the trajectory points are the local
+   * orientations rotated by the yaw of the transformation. The output messages are overwritten,
+   * but keep their capacity.
+   *
+   * @param trj_msg The trajectory in the local frame.
+   * @param path_msg The path in the local frame.
+   * @param trj_msg_global The trajectory in the global map frame (output).
+   * @param path_msg_global The path in the global map frame (output).
+   * @param trj_vis_global The visualization of the global trajectory (output, optional).
+   */
+  void TransformToGlobalFrame(
+    const autoware_planning_msgs::msg::Trajectory & trj_msg,
+    const autoware_planning_msgs::msg::Path & path_msg,
+    autoware_planning_msgs::msg::Trajectory & trj_msg_global,
+    autoware_planning_msgs::msg::Path & path_msg_global,
+    visualization_msgs::msg::Marker * trj_vis_global = nullptr);
+
+  /**
+   * @brief Get the transformation from the current odometry frame to the global map frame.
    *
-   * @tparam T autoware_planning_msgs::msg::Path, autoware_planning_msgs::msg::Trajectory.
-   * @param input Input ROS message which content must be transformed into the global map frame.
-   * @return T Same as input message with the content being valid in the global map.
+   * @param d_current_to_map_origin The transformation (output).
+   * @return True if an odometry update was received, otherwise the global map frame equals the
+   * local frame.
    */
-  template <typename T>
-  T TransformToGlobalFrame(const T & input);
+  bool GetTransformToGlobalFrame_(Pose2D & d_current_to_map_origin);
 
   /**
-   * @brief Visualization helper for the global trajectory.
+   * @brief Publish a trajectory or path, written into a loaned message if use_loaned_messages is
+   * set and the middleware supports loaning for the message type (fallback: regular publishing).
    *
-   * @param trj_msg Trajectory in global map frame.
-   * @return visualization_msgs::msg::Marker.
+   * @tparam MessageT autoware_planning_msgs::msg::Path, autoware_planning_msgs::msg::Trajectory.
+   * @param publisher The publisher.
+   * @param msg The message.
    */
-  visualization_msgs::msg::Marker GetGlobalTrjVisualization_(
-    const autoware_planning_msgs::msg::Trajectory & trj_msg);
+  template <typename MessageT>
+  void PublishLoanedIfSupported_(rclcpp::Publisher<MessageT> & publisher, const MessageT & msg);
+
+  /**
+   * @brief Initialize the visualization marker of the global trajectory (without points).
+   *
+   * @param trj_vis_global The marker.
+   * @param header The header of the global trajectory.
+   */
+  void InitGlobalTrjVisualization_(
+    visualization_msgs::msg::Marker & trj_vis_global, const std_msgs::msg::Header & header);
 
   // Declare ROS2 publisher and subscriber
 
@@ -198,6 +294,19 @@ private:
 
   rclcpp::TimerBase::SharedPtr timer_;
 
+  rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr param_callback_handle_;
+
+  // Cached startup trajectory and path (local frame) and their reused global variants
+  autoware_planning_msgs::msg::Trajectory startup_trajectory_, startup_trajectory_global_;
+  autoware_planning_msgs::msg::Path startup_path_, startup_path_global_;
+
+  // Publishes the global output at a fixed rate (latest-value semantics, only if configured)
+  rclcpp::TimerBase::SharedPtr global_output_timer_;
+  bool global_output_pending_ = false;
+
+  // Output messages of the mission conversion, reused across frames
+  ConversionOutput conversion_output_;
+
   // Switch to print an error about wrongly configured odometry frames
   bool b_input_odom_frame_error_ = false;
   bool received_motion_update_once_ = false;
@@ -210,10 +319,19 @@ private:
 
   // ROS parameters
   float target_speed_;
+  bool use_loaned_messages_;
+  double global_output_rate_hz_;
   std::string local_map_frame_;
 
   // Unique ID for each marker
   ID marker_id_;
+
+  // Stage profiling (statistics are published on /diagnostics if compiled in)
+  StageProfiler profiler_;
+  std::unique_ptr<diagnostic_updater::Updater> diagnostic_updater_;
+
+  // Trace dump service
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr trace_dump_service_;
 };
 }  // namespace autoware::mapless_architecture
 
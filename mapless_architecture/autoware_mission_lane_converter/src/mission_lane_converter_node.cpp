@@ -14,15 +14,37 @@
 
 #include "autoware/mission_lane_converter/mission_lane_converter_node.hpp"
 
+#include "autoware/local_mission_planner_common/corridor_emitter.hpp"
+#include "autoware/local_mission_planner_common/stage_diagnostics.hpp"
+#include "autoware/local_mission_planner_common/trace_service.hpp"
+
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace autoware::mapless_architecture
 {
 using std::placeholders::_1;
 
+namespace
+{
+
+// A mission lane point is only added if it differs from the last added point in both coordinates
+bool IsNewMissionLanePoint(
+  const geometry_msgs::msg::Point & last_point, const geometry_msgs::msg::Point & point)
+{
+  return last_point.x != point.x && last_point.y != point.y;
+}
+
+}  // namespace
+
 MissionLaneConverterNode::MissionLaneConverterNode(
   const rclcpp::NodeOptions & options, const bool init_publishers_and_subscribers)
-: Node("mission_lane_converter_node", options)
+: Node("mission_lane_converter_node", options), profiler_("mission_lane_converter")
 {
   // Set quality of service to best effort (if transmission fails, do not try to resend but rather
   // use new sensor data), the history_depth is set to 1 (message queue size)
@@ -74,60 +96,142 @@ MissionLaneConverterNode::MissionLaneConverterNode(
       "mission_lane_converter/output/vis_global_odometry", qos_best_effort);
   }
 
+  // ROS parameters (will be overwritten by external param file if exists)
+  target_speed_ = declare_parameter<float>("target_speed", 3.0);
+  RCLCPP_INFO(this->get_logger(), "Target speed set to: %.2f", target_speed_);
+
+  // The startup trajectory is cached and only rebuilt if the target speed changes
+  BuildStartupTemplate_();
+  param_callback_handle_ = this->add_on_set_parameters_callback(
+    std::bind(&MissionLaneConverterNode::ParamCallback_, this, std::placeholders::_1));
+
+  // Publish the startup trajectory until the first mission lanes are received
   timer_ = this->create_wall_timer(
     std::chrono::milliseconds(100),
     std::bind(&MissionLaneConverterNode::TimedStartupTrajectoryCallback, this));
 
-  // ROS parameters (will be overwritten by external param file if exists)
-  target_speed_ = declare_parameter<float>("target_speed", 3.0);
-  RCLCPP_INFO(this->get_logger(), "Target speed set to: %.2f", target_speed_);
+  use_loaned_messages_ = declare_parameter<bool>("use_loaned_messages", false);
+  RCLCPP_INFO(
+    this->get_logger(), "Publish trajectories and paths in loaned messages: %d",
+    use_loaned_messages_);
+  if (
+    use_loaned_messages_ && init_publishers_and_subscribers &&
+    !(trajectory_publisher_->can_loan_messages() && path_publisher_->can_loan_messages())) {
+    RCLCPP_WARN(
+      this->get_logger(),
+      "The middleware does not support loaned trajectory/path messages, they are published "
+      "without loaning.");
+  }
+
+  global_output_rate_hz_ = declare_parameter<double>("global_output_rate_hz", 0.0);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "Rate of the global trajectory/path output (0 publishes them with each mission lanes "
+    "message): %.1f Hz",
+    global_output_rate_hz_);
+
+  // Decouple the global output from the mission lanes: the latest local output is re-transformed
+  // with the newest odometry at a fixed rate
+  if (global_output_rate_hz_ > 0.0 && init_publishers_and_subscribers) {
+    global_output_timer_ = this->create_wall_timer(
+      std::chrono::duration<double>(1.0 / global_output_rate_hz_),
+      std::bind(&MissionLaneConverterNode::TimedGlobalOutputCallback_, this));
+  }
+
+  // Publish the stage profiling statistics on /diagnostics (only if compiled in)
+  if (IsProfilingEnabled() && init_publishers_and_subscribers) {
+    diagnostic_updater_ = std::make_unique<diagnostic_updater::Updater>(this, 1.0);
+    diagnostic_updater_->setHardwareID("none");
+    diagnostic_updater_->add(
+      "mission_lane_converter_stage_profiling",
+      [this](diagnostic_updater::DiagnosticStatusWrapper & stat) {
+        ProduceStageDiagnostics(profiler_, stat);
+      });
+  }
+
+  // Service to write the recorded trace events of the processing stages to a file
+  if (init_publishers_and_subscribers) trace_dump_service_ = CreateTraceDumpService(*this);
 }
 
 void MissionLaneConverterNode::TimedStartupTrajectoryCallback()
 {
-  if (!mission_lanes_available_once_) {
-    // Empty trajectory for controller
-    autoware_planning_msgs::msg::Trajectory trj_msg = autoware_planning_msgs::msg::Trajectory();
-    autoware_planning_msgs::msg::Path pth_msg = autoware_planning_msgs::msg::Path();
-
-    // Frame id
-    trj_msg.header.frame_id = local_map_frame_;
-    trj_msg.header.stamp = rclcpp::Node::now();
-
-    pth_msg.header.frame_id = local_map_frame_;
-    pth_msg.header.stamp = rclcpp::Node::now();
-
-    for (int idx_point = 0; idx_point < 100; idx_point++) {
-      const double x = -5.0 + idx_point * 1.0;
-      const double y = 0.0;
-      const double v_x = target_speed_;
-
-      AddTrajectoryPoint_(trj_msg, x, y, v_x);
-      AddPathPoint_(pth_msg, x, y, v_x);
-
-      // Create path bounds
-      geometry_msgs::msg::Point pt_path;
-      pt_path.x = x;
-      pt_path.y = 1.5;
-      pth_msg.left_bound.push_back(pt_path);
-      pt_path.y = -1.5;
-      pth_msg.right_bound.push_back(pt_path);
-    }
+  // The startup trajectory is not needed anymore once mission lanes were received
+  if (mission_lanes_available_once_) {
+    timer_->cancel();
+    return;
+  }
 
-    // Heading in trajectory path will be overwritten
-    this->AddHeadingToTrajectory_(trj_msg);
+  // Only the pose transform is applied per tick, the local template is cached
+  startup_trajectory_.header.stamp = rclcpp::Node::now();
+  startup_path_.header.stamp = startup_trajectory_.header.stamp;
 
-    trj_msg = TransformToGlobalFrame(trj_msg);
-    pth_msg = TransformToGlobalFrame(pth_msg);
+  TransformToGlobalFrame(
+    startup_trajectory_, startup_path_, startup_trajectory_global_, startup_path_global_);
 
-    publisher_->publish(trj_msg);
-    path_publisher_global_->publish(pth_msg);
+  PublishLoanedIfSupported_(*publisher_, startup_trajectory_global_);
+  PublishLoanedIfSupported_(*path_publisher_global_, startup_path_global_);
+}
+
+void MissionLaneConverterNode::BuildStartupTemplate_()
+{
+  // Straight trajectory for controller (heading is computed once)
+  startup_trajectory_ = autoware_planning_msgs::msg::Trajectory();
+  startup_path_ = autoware_planning_msgs::msg::Path();
+
+  // Frame id
+  startup_trajectory_.header.frame_id = local_map_frame_;
+  startup_path_.header.frame_id = local_map_frame_;
+
+  for (int idx_point = 0; idx_point < 100; idx_point++) {
+    const double x = -5.0 + idx_point * 1.0;
+    const double y = 0.0;
+    const double v_x = target_speed_;
+
+    AddTrajectoryPoint_(startup_trajectory_, x, y, v_x);
+    AddPathPoint_(startup_path_, x, y, v_x);
+
+    // Create path bounds
+    geometry_msgs::msg::Point pt_path;
+    pt_path.x = x;
+    pt_path.y = 1.5;
+    startup_path_.left_bound.push_back(pt_path);
+    pt_path.y = -1.5;
+    startup_path_.right_bound.push_back(pt_path);
   }
+
+  // Heading in trajectory path will be overwritten
+  this->AddHeadingToTrajectory_(startup_trajectory_);
+}
+
+rcl_interfaces::msg::SetParametersResult MissionLaneConverterNode::ParamCallback_(
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+  result.reason = "";
+
+  for (const auto & param : parameters) {
+    if (param.get_name() == "target_speed") {
+      if (param.get_type() == rclcpp::ParameterType::PARAMETER_DOUBLE) {
+        target_speed_ = param.as_double();
+        RCLCPP_INFO(this->get_logger(), "Target speed set to: %.2f", target_speed_);
+
+        // The startup template contains the target speed
+        BuildStartupTemplate_();
+      } else {
+        result.successful = false;
+        result.reason = "Incorrect Type";
+      }
+    }
+  }
+  return result;
 }
 
 void MissionLaneConverterNode::MissionLanesCallback_(
   const autoware_mapless_planning_msgs::msg::MissionLanesStamped & msg_mission)
 {
+  MAPLESS_TRACE_SCOPE("mission_lane_converter", "mission lanes callback");
+
   // FIXME: Workaround to get the vehicle driving in autonomous mode until the
   // environment model is available
   if (msg_mission.ego_lane.centerline.size() == 0) {
@@ -137,73 +241,80 @@ void MissionLaneConverterNode::MissionLanesCallback_(
       RCLCPP_WARN(this->get_logger(), "Received empty ego mission lane, aborting conversion!");
     }
     return;
-  } else {
+  } else if (!mission_lanes_available_once_) {
     mission_lanes_available_once_ = true;
+
+    // Stop publishing the startup trajectory
+    timer_->cancel();
   }
 
-  // Convert mission lanes to trajectory
-  std::tuple<
-    autoware_planning_msgs::msg::Trajectory, visualization_msgs::msg::Marker,
-    autoware_planning_msgs::msg::Path, visualization_msgs::msg::MarkerArray>
-    mission_to_trj = ConvertMissionToTrajectory(msg_mission);
+  // Convert mission lanes to trajectory and path (local and global map frame), the output
+  // messages are reused across frames. If the global output is published by the timer, the local
+  // output is the latest value which the timer transforms.
+  const bool is_global_output_timed = global_output_timer_ != nullptr;
+  ConvertMissionToTrajectory(msg_mission, conversion_output_, !is_global_output_timed);
+  const ConversionOutput & output = conversion_output_;
 
-  // Extract the tuple
-  autoware_planning_msgs::msg::Trajectory trj_msg = std::get<0>(mission_to_trj);
-  visualization_msgs::msg::Marker trj_vis = std::get<1>(mission_to_trj);
-  autoware_planning_msgs::msg::Path path_msg = std::get<2>(mission_to_trj);
-  visualization_msgs::msg::MarkerArray path_area = std::get<3>(mission_to_trj);
+  {
+    MAPLESS_PROFILE_STAGE(profiler_, kStagePublish);
 
-  // Transform trajectory to global frame
-  autoware_planning_msgs::msg::Trajectory trj_msg_global =
-    TransformToGlobalFrame<autoware_planning_msgs::msg::Trajectory>(trj_msg);
-  autoware_planning_msgs::msg::Path path_msg_global =
-    TransformToGlobalFrame<autoware_planning_msgs::msg::Path>(path_msg);
+    // Publish trajectory to motion planner
+    PublishLoanedIfSupported_(*trajectory_publisher_, output.trajectory);
 
-  // Publish trajectory to visualization
-  visualization_msgs::msg::Marker trj_vis_global = GetGlobalTrjVisualization_(trj_msg_global);
-  vis_trajectory_publisher_global_->publish(trj_vis_global);
+    // Publish path to motion planner
+    PublishLoanedIfSupported_(*path_publisher_, output.path);
 
-  // Publish trajectory to motion planner
-  trajectory_publisher_->publish(trj_msg);
-  trajectory_publisher_global_->publish(trj_msg_global);
+    if (is_global_output_timed) {
+      global_output_pending_ = true;
+    } else {
+      PublishGlobalOutput_();
+    }
+  }
 
-  // Publish path to motion planner
-  path_publisher_->publish(path_msg);
-  path_publisher_global_->publish(path_msg_global);
+  {
+    MAPLESS_PROFILE_STAGE(profiler_, kStageVisualization);
 
-  // Clear all markers in scene
-  visualization_msgs::msg::Marker msg_marker;
-  msg_marker.header = msg_mission.header;
-  msg_marker.type = visualization_msgs::msg::Marker::LINE_STRIP;
+    // Clear all markers in scene
+    visualization_msgs::msg::Marker msg_marker;
+    msg_marker.header = msg_mission.header;
+    msg_marker.type = visualization_msgs::msg::Marker::LINE_STRIP;
 
-  // This specifies the clear all / delete all action
-  msg_marker.action = 3;
-  vis_trajectory_publisher_->publish(msg_marker);
+    // This specifies the clear all / delete all action
+    msg_marker.action = 3;
+    vis_trajectory_publisher_->publish(msg_marker);
 
-  visualization_msgs::msg::MarkerArray msg_marker_array;
-  msg_marker_array.markers.push_back(msg_marker);
-  vis_path_publisher_->publish(msg_marker_array);
+    visualization_msgs::msg::MarkerArray msg_marker_array;
+    msg_marker_array.markers.push_back(msg_marker);
+    vis_path_publisher_->publish(msg_marker_array);
 
-  vis_trajectory_publisher_->publish(trj_vis);
-  vis_path_publisher_->publish(path_area);
+    vis_trajectory_publisher_->publish(output.trajectory_vis);
+    vis_path_publisher_->publish(output.path_area_vis);
+  }
 
   return;
 }
 
-std::tuple<
-  autoware_planning_msgs::msg::Trajectory, visualization_msgs::msg::Marker,
-  autoware_planning_msgs::msg::Path, visualization_msgs::msg::MarkerArray>
-MissionLaneConverterNode::ConvertMissionToTrajectory(
-  const autoware_mapless_planning_msgs::msg::MissionLanesStamped & msg)
+void MissionLaneConverterNode::ConvertMissionToTrajectory(
+  const autoware_mapless_planning_msgs::msg::MissionLanesStamped & msg, ConversionOutput & output,
+  const bool convert_to_global_frame)
 {
-  // Empty trajectory for controller
-  autoware_planning_msgs::msg::Trajectory trj_msg = autoware_planning_msgs::msg::Trajectory();
-
-  autoware_planning_msgs::msg::Path path_msg = autoware_planning_msgs::msg::Path();
-
-  // Empty trajectory visualization message
-  visualization_msgs::msg::Marker trj_vis, path_center_vis, path_left_vis, path_right_vis;
-  visualization_msgs::msg::MarkerArray path_area_vis;
+  MAPLESS_PROFILE_STAGE(profiler_, kStageConversion);
+
+  // Empty trajectory for controller (clear() keeps the capacity of the reused messages)
+  autoware_planning_msgs::msg::Trajectory & trj_msg = output.trajectory;
+  autoware_planning_msgs::msg::Path & path_msg = output.path;
+  trj_msg.points.clear();
+  path_msg.points.clear();
+  path_msg.left_bound.clear();
+  path_msg.right_bound.clear();
+
+  // Empty trajectory visualization message (path area: center, left and right marker)
+  visualization_msgs::msg::Marker & trj_vis = output.trajectory_vis;
+  trj_vis.points.clear();
+  output.path_area_vis.markers.resize(3);
+  visualization_msgs::msg::Marker & path_center_vis = output.path_area_vis.markers[0];
+  visualization_msgs::msg::Marker & path_left_vis = output.path_area_vis.markers[1];
+  visualization_msgs::msg::Marker & path_right_vis = output.path_area_vis.markers[2];
 
   trj_vis.header.frame_id = msg.header.frame_id;
   trj_vis.header.stamp = msg.header.stamp;
@@ -218,22 +329,23 @@ MissionLaneConverterNode::ConvertMissionToTrajectory(
   trj_vis.lifetime.nanosec = 0;  // Forever
   trj_vis.frame_locked = false;  // Always transform into baselink
 
-  path_left_vis.header.frame_id = msg.header.frame_id;
-  path_left_vis.header.stamp = msg.header.stamp;
-  path_left_vis.ns = "mission_path";
-  path_left_vis.type = visualization_msgs::msg::Marker::LINE_STRIP;
-  path_left_vis.pose.orientation.w = 1.0;  // Neutral orientation
-  path_left_vis.scale.x = 0.6;
-
-  path_left_vis.color.g = 0.742;  // Green color
-  path_left_vis.color.b = 0.703;  // Blue color
-  path_left_vis.color.a = 0.350;
-  path_left_vis.lifetime.sec = 0;      // Forever
-  path_left_vis.lifetime.nanosec = 0;  // Forever
-  path_left_vis.frame_locked = false;  // Always transform into baselink
-
-  path_right_vis = path_left_vis;
-  path_center_vis = path_left_vis;
+  for (visualization_msgs::msg::Marker & path_vis : output.path_area_vis.markers) {
+    path_vis.points.clear();
+    path_vis.header.frame_id = msg.header.frame_id;
+    path_vis.header.stamp = msg.header.stamp;
+    path_vis.ns = "mission_path";
+    path_vis.id = 0;
+    path_vis.type = visualization_msgs::msg::Marker::LINE_STRIP;
+    path_vis.pose.orientation.w = 1.0;  // Neutral orientation
+    path_vis.scale.x = 0.6;
+
+    path_vis.color.g = 0.742;  // Green color
+    path_vis.color.b = 0.703;  // Blue color
+    path_vis.color.a = 0.350;
+    path_vis.lifetime.sec = 0;      // Forever
+    path_vis.lifetime.nanosec = 0;  // Forever
+    path_vis.frame_locked = false;  // Always transform into baselink
+  }
 
   // Fill output trajectory header
   trj_msg.header = msg.header;
@@ -315,13 +427,54 @@ MissionLaneConverterNode::ConvertMissionToTrajectory(
       break;
   }
 
-  path_area_vis.markers.push_back(path_center_vis);
-  path_area_vis.markers.push_back(path_left_vis);
-  path_area_vis.markers.push_back(path_right_vis);
-
   this->AddHeadingToTrajectory_(trj_msg);
 
-  return std::make_tuple(trj_msg, trj_vis, path_msg, path_area_vis);
+  // Global map frame variant
+  if (convert_to_global_frame) {
+    TransformToGlobalFrame(
+      trj_msg, path_msg, output.trajectory_global, output.path_global,
+      &output.trajectory_vis_global);
+  }
+}
+
+void MissionLaneConverterNode::TimedGlobalOutputCallback_()
+{
+  MAPLESS_TRACE_SCOPE("mission_lane_converter", "global output callback");
+
+  // Only publish if the mission lanes or the odometry changed since the last output
+  if (!global_output_pending_ || conversion_output_.trajectory.points.empty()) return;
+
+  RetransformToGlobalFrame(conversion_output_);
+
+  MAPLESS_PROFILE_STAGE(profiler_, kStagePublish);
+  PublishGlobalOutput_();
+}
+
+void MissionLaneConverterNode::RetransformToGlobalFrame(ConversionOutput & output)
+{
+  TransformToGlobalFrame(
+    output.trajectory, output.path, output.trajectory_global, output.path_global,
+    &output.trajectory_vis_global);
+
+  // The output is valid at the time of the odometry which it was transformed with (the mission
+  // lanes may be older)
+  if (received_motion_update_once_) {
+    output.trajectory_global.header.stamp = last_odom_msg_.header.stamp;
+    output.path_global.header.stamp = last_odom_msg_.header.stamp;
+    output.trajectory_vis_global.header.stamp = last_odom_msg_.header.stamp;
+  }
+}
+
+void MissionLaneConverterNode::PublishGlobalOutput_()
+{
+  // Publish trajectory to visualization
+  vis_trajectory_publisher_global_->publish(conversion_output_.trajectory_vis_global);
+
+  // Publish trajectory and path to motion planner
+  PublishLoanedIfSupported_(*trajectory_publisher_global_, conversion_output_.trajectory_global);
+  PublishLoanedIfSupported_(*path_publisher_global_, conversion_output_.path_global);
+
+  global_output_pending_ = false;
 }
 
 void MissionLaneConverterNode::CreateMotionPlannerInput_(
@@ -329,51 +482,29 @@ void MissionLaneConverterNode::CreateMotionPlannerInput_(
   visualization_msgs::msg::Marker & trj_vis, visualization_msgs::msg::Marker & path_vis,
   const std::vector<geometry_msgs::msg::Point> & centerline_mission_lane)
 {
-  // Add a mission lane's centerline to the output trajectory and path messages
-  for (size_t idx_point = 0; idx_point < centerline_mission_lane.size(); idx_point++) {
-    // Check if trajectory message is empty
-    if (trj_msg.points.size() > 0) {
-      // Check if last trajectory point equals the one we want to add now
-      if (
-        trj_msg.points.back().pose.position.x != centerline_mission_lane[idx_point].x &&
-        trj_msg.points.back().pose.position.y != centerline_mission_lane[idx_point].y) {
-        AddTrajectoryPoint_(
-          trj_msg, centerline_mission_lane[idx_point].x, centerline_mission_lane[idx_point].y,
-          target_speed_);
-
-        // Similar point has to be added to the path message
-        AddPathPoint_(
-          path_msg, centerline_mission_lane[idx_point].x, centerline_mission_lane[idx_point].y,
-          target_speed_);
-
-        // Add visualization marker to trajectory vis message
-        AddPointVisualizationMarker_(
-          trj_vis, centerline_mission_lane[idx_point].x, centerline_mission_lane[idx_point].y, 0);
-
-        // Add visualization marker to path vis message
-        AddPointVisualizationMarker_(
-          path_vis, centerline_mission_lane[idx_point].x, centerline_mission_lane[idx_point].y, 0);
-      }
-    } else {  // Add first point
-      // Add a trajectory point
-      AddTrajectoryPoint_(
-        trj_msg, centerline_mission_lane[idx_point].x, centerline_mission_lane[idx_point].y,
-        target_speed_);
-
-      // Similar point has to be added to the path message
-      AddPathPoint_(
-        path_msg, centerline_mission_lane[idx_point].x, centerline_mission_lane[idx_point].y,
-        target_speed_);
-
-      AddPointVisualizationMarker_(
-        trj_vis, centerline_mission_lane[idx_point].x, centerline_mission_lane[idx_point].y, 0);
-
-      // Add visualization marker to path vis message
-      AddPointVisualizationMarker_(
-        path_vis, centerline_mission_lane[idx_point].x, centerline_mission_lane[idx_point].y, 0);
-    }
+  // Add a mission lane's centerline to the output trajectory and path messages and their
+  // visualization markers in one pass (constant velocity, planar points)
+  autoware_planning_msgs::msg::TrajectoryPoint trajectory_point;
+  trajectory_point.longitudinal_velocity_mps = target_speed_;
+  autoware_planning_msgs::msg::PathPoint path_point;
+  path_point.longitudinal_velocity_mps = target_speed_;
+
+  const std::size_t n_points = centerline_mission_lane.size();
+  trj_msg.points.reserve(trj_msg.points.size() + n_points);
+  path_msg.points.reserve(path_msg.points.size() + n_points);
+  trj_vis.points.reserve(trj_vis.points.size() + n_points);
+  path_vis.points.reserve(path_vis.points.size() + n_points);
+  if (n_points > 0) {
+    trj_vis.id = 0;
+    path_vis.id = 0;
   }
 
+  EmitCorridorPoints(
+    centerline_mission_lane, 1, IsNewMissionLanePoint,
+    MakeCorridorSink<false>(trj_msg.points, trajectory_point),
+    MakeCorridorSink<false>(path_msg.points, path_point), MakeCorridorSink<false>(trj_vis.points),
+    MakeCorridorSink<false>(path_vis.points));
+
   return;
 }
 
@@ -381,26 +512,14 @@ void MissionLaneConverterNode::CreatePathBound_(
   std::vector<geometry_msgs::msg::Point> & bound_path, visualization_msgs::msg::Marker & path_vis,
   const std::vector<geometry_msgs::msg::Point> & bound_mission_lane, const int id_marker)
 {
-  for (size_t idx_point = 0; idx_point < bound_mission_lane.size(); idx_point++) {
-    geometry_msgs::msg::Point pt_path;
-    pt_path.x = bound_mission_lane[idx_point].x;
-    pt_path.y = bound_mission_lane[idx_point].y;
-    // Check if path bound is empty
-    if (bound_path.size() > 0) {
-      // Check if last path point equals the one we want to add now
-      if (
-        bound_path.back().x != bound_mission_lane[idx_point].x &&
-        bound_path.back().y != bound_mission_lane[idx_point].y) {
-        // Finally add the path point after successful checks
-        bound_path.push_back(pt_path);
-      }
-    } else {  // Add first point to path
-      bound_path.push_back(pt_path);
-    }
+  // Add the path points and the marker points for debugging in one pass
+  bound_path.reserve(bound_path.size() + bound_mission_lane.size());
+  path_vis.points.reserve(path_vis.points.size() + bound_mission_lane.size());
+  if (!bound_mission_lane.empty()) path_vis.id = id_marker;
 
-    // Add last added point to a marker message for debugging
-    AddPointVisualizationMarker_(path_vis, bound_path.back().x, bound_path.back().y, id_marker);
-  }
+  EmitCorridorPoints(
+    bound_mission_lane, 1, IsNewMissionLanePoint, MakeCorridorSink<false>(bound_path),
+    MakeCorridorSink<false>(path_vis.points));
 
   return;
 }
@@ -454,26 +573,29 @@ void MissionLaneConverterNode::AddPointVisualizationMarker_(
 void MissionLaneConverterNode::AddHeadingToTrajectory_(
   autoware_planning_msgs::msg::Trajectory & trj_msg)
 {
-  std::vector<geometry_msgs::msg::Point> points;
+  MAPLESS_PROFILE_STAGE(profiler_, kStageHeading);
 
-  for (size_t idx_point = 0; idx_point < trj_msg.points.size(); idx_point++) {
-    points.push_back(geometry_msgs::msg::Point());
-    points.back().x = trj_msg.points[idx_point].pose.position.x;
-    points.back().y = trj_msg.points[idx_point].pose.position.y;
-  }
+  const size_t num_points = trj_msg.points.size();
 
   // Only execute if we have at least 2 points
-  if (points.size() > 1) {
-    std::vector<double> psi_vec = GetPsiForPoints(points);
+  if (num_points > 1) {
+    // Gather positions into contiguous x/y arrays for the heading kernel
+    std::vector<double> x(num_points), y(num_points), psi_vec(num_points);
+    for (size_t idx_point = 0; idx_point < num_points; idx_point++) {
+      x[idx_point] = trj_msg.points[idx_point].pose.position.x;
+      y[idx_point] = trj_msg.points[idx_point].pose.position.y;
+    }
+
+    GetPsiForPoints(x.data(), y.data(), num_points, psi_vec.data());
 
     tf2::Quaternion tf2_quat;
-    for (size_t idx_point = 0; idx_point < trj_msg.points.size(); idx_point++) {
+    for (size_t idx_point = 0; idx_point < num_points; idx_point++) {
       tf2_quat.setRPY(0.0, 0.0, psi_vec[idx_point]);
 
-      trj_msg.points.back().pose.orientation.x = tf2_quat.getX();
-      trj_msg.points.back().pose.orientation.y = tf2_quat.getY();
-      trj_msg.points.back().pose.orientation.z = tf2_quat.getZ();
-      trj_msg.points.back().pose.orientation.w = tf2_quat.getW();
+      trj_msg.points[idx_point].pose.orientation.x = tf2_quat.getX();
+      trj_msg.points[idx_point].pose.orientation.y = tf2_quat.getY();
+      trj_msg.points[idx_point].pose.orientation.z = tf2_quat.getZ();
+      trj_msg.points[idx_point].pose.orientation.w = tf2_quat.getW();
     }
   }
 
@@ -482,14 +604,9 @@ void MissionLaneConverterNode::AddHeadingToTrajectory_(
 
 void MissionLaneConverterNode::CallbackOdometryMessages_(const nav_msgs::msg::Odometry & msg)
 {
-  // Store current odometry information
-  last_odom_msg_ = msg;
+  MAPLESS_TRACE_SCOPE("mission_lane_converter", "odometry callback");
 
-  if (!received_motion_update_once_) {
-    initial_odom_msg_ = msg;
-  }
-
-  received_motion_update_once_ = true;
+  UpdateOdometry(msg);
 
   visualization_msgs::msg::Marker odom_vis;
   odom_vis.header.frame_id = msg.header.frame_id;
@@ -516,109 +633,177 @@ void MissionLaneConverterNode::CallbackOdometryMessages_(const nav_msgs::msg::Od
   return;
 }
 
-template <typename T>
-T MissionLaneConverterNode::TransformToGlobalFrame(const T & msg_input)
+void MissionLaneConverterNode::UpdateOdometry(const nav_msgs::msg::Odometry & msg)
 {
-  // Define output message
-  T msg_output = msg_input;
-  msg_output.header.frame_id = local_map_frame_;
+  // Store current odometry information
+  last_odom_msg_ = msg;
 
-  // Construct raw odometry pose
-  geometry_msgs::msg::PoseStamped odometry_pose_raw;
-  odometry_pose_raw.header = last_odom_msg_.header;
-  odometry_pose_raw.pose = last_odom_msg_.pose.pose;
+  if (!received_motion_update_once_) {
+    initial_odom_msg_ = msg;
+  }
 
-  if (received_motion_update_once_) {
-    // If the incoming odometry signal is properly filled, i.e. if the frame ids
-    // are given and report an odometry signal, do nothing, else we assume the
-    // odometry signal stems from the GNSS (and is therefore valid in the odom
-    // frame)
-    if (!(last_odom_msg_.header.frame_id == local_map_frame_ &&
-          last_odom_msg_.child_frame_id == "base_link")) {
-      if (!b_input_odom_frame_error_) {
-        RCLCPP_ERROR(
-          this->get_logger(),
-          "Your odometry signal doesn't match the expectation to be a "
-          "transformation from frame <%s> to <base_link>! The node will continue spinning but the "
-          "odometry signal should be checked! This error is printed only "
-          "once.",
-          local_map_frame_.c_str());
-        b_input_odom_frame_error_ = true;
-      }
-    }
+  received_motion_update_once_ = true;
 
-    const double psi_initial = GetYawFromQuaternion(
-      initial_odom_msg_.pose.pose.orientation.x, initial_odom_msg_.pose.pose.orientation.y,
-      initial_odom_msg_.pose.pose.orientation.z, initial_odom_msg_.pose.pose.orientation.w);
-    const Pose2D pose_initial(
-      initial_odom_msg_.pose.pose.position.x, initial_odom_msg_.pose.pose.position.y, psi_initial);
-
-    const double psi_cur = GetYawFromQuaternion(
-      last_odom_msg_.pose.pose.orientation.x, last_odom_msg_.pose.pose.orientation.y,
-      last_odom_msg_.pose.pose.orientation.z, last_odom_msg_.pose.pose.orientation.w);
-    const Pose2D pose_cur(
-      last_odom_msg_.pose.pose.position.x, last_odom_msg_.pose.pose.position.y, psi_cur);
-
-    // Get relationship from current odom frame to global map frame origin
-    const Pose2D d_current_to_map_origin = TransformToNewCosy2D(pose_cur, Pose2D{0.0, 0.0});
-
-    // Convert all the input points to the global map frame
-    for (size_t i = 0; i < msg_input.points.size(); i++) {
-      // Convert input pose
-      const double psi_point = GetYawFromQuaternion(
-        msg_input.points[i].pose.orientation.x, msg_input.points[i].pose.orientation.y,
-        msg_input.points[i].pose.orientation.z, msg_input.points[i].pose.orientation.w);
-      const Pose2D pose(
-        msg_input.points[i].pose.position.x, msg_input.points[i].pose.position.y, psi_point);
-
-      // Express point in global map frame
-      Pose2D pose_map = TransformToNewCosy2D(d_current_to_map_origin, pose);
-
-      msg_output.points[i].pose.position.x = pose_map.get_x();
-      msg_output.points[i].pose.position.y = pose_map.get_y();
+  // The latest local output has to be transformed with the new odometry
+  global_output_pending_ = true;
+}
+
+bool MissionLaneConverterNode::GetTransformToGlobalFrame_(Pose2D & d_current_to_map_origin)
+{
+  if (!received_motion_update_once_) return false;
+
+  // If the incoming odometry signal is properly filled, i.e. if the frame ids
+  // are given and report an odometry signal, do nothing, else we assume the
+  // odometry signal stems from the GNSS (and is therefore valid in the odom
+  // frame)
+  if (!(last_odom_msg_.header.frame_id == local_map_frame_ &&
+        last_odom_msg_.child_frame_id == "base_link")) {
+    if (!b_input_odom_frame_error_) {
+      RCLCPP_ERROR(
+        this->get_logger(),
+        "Your odometry signal doesn't match the expectation to be a "
+        "transformation from frame <%s> to <base_link>! The node will continue spinning but the "
+        "odometry signal should be checked! This error is printed only "
+        "once.",
+        local_map_frame_.c_str());
+      b_input_odom_frame_error_ = true;
     }
+  }
+
+  const double psi_cur = GetYawFromQuaternion(
+    last_odom_msg_.pose.pose.orientation.x, last_odom_msg_.pose.pose.orientation.y,
+    last_odom_msg_.pose.pose.orientation.z, last_odom_msg_.pose.pose.orientation.w);
+  const Pose2D pose_cur(
+    last_odom_msg_.pose.pose.position.x, last_odom_msg_.pose.pose.position.y, psi_cur);
+
+  // Get relationship from current odom frame to global map frame origin
+  d_current_to_map_origin = TransformToNewCosy2D(pose_cur, Pose2D{0.0, 0.0});
+
+  return true;
+}
+
+void MissionLaneConverterNode::TransformToGlobalFrame(
+  const autoware_planning_msgs::msg::Trajectory & trj_msg,
+  const autoware_planning_msgs::msg::Path & path_msg,
+  autoware_planning_msgs::msg::Trajectory & trj_msg_global,
+  autoware_planning_msgs::msg::Path & path_msg_global,
+  visualization_msgs::msg::Marker * trj_vis_global)
+{
+  MAPLESS_PROFILE_STAGE(profiler_, kStageTransform);
+
+  Pose2D d_current_to_map_origin;
+  const bool is_transformed = GetTransformToGlobalFrame_(d_current_to_map_origin);
+
+  // Express a point in the global map frame (identity if no odometry was received yet)
+  const auto to_global = [&](const double x, const double y) {
+    return is_transformed ? TransformToNewCosy2D(d_current_to_map_origin, Pose2D(x, y))
+                          : Pose2D(x, y);
+  };
+
+  // Rotation of the (local) trajectory orientations into the global map frame
+  tf2::Quaternion rotation_to_global;
+  rotation_to_global.setRPY(0.0, 0.0, is_transformed ? -d_current_to_map_origin.get_psi() : 0.0);
+
+  trj_msg_global.header = trj_msg.header;
+  trj_msg_global.header.frame_id = local_map_frame_;
+  path_msg_global.header = path_msg.header;
+  path_msg_global.header.frame_id = local_map_frame_;
+
+  const size_t num_trj_points = trj_msg.points.size();
+  const size_t num_path_points = path_msg.points.size();
+  trj_msg_global.points.resize(num_trj_points);
+  path_msg_global.points.resize(num_path_points);
+
+  if (trj_vis_global != nullptr) {
+    InitGlobalTrjVisualization_(*trj_vis_global, trj_msg_global.header);
+  }
 
-    // Convert the path area's bounds
-    if constexpr (std::is_same<T, autoware_planning_msgs::msg::Path>::value) {
-      for (size_t ib = 0; ib < 2; ib++) {
-        std::vector<geometry_msgs::msg::Point> bound;
-        if (ib == 0)
-          bound = msg_input.left_bound;
-        else
-          bound = msg_input.right_bound;
-        for (size_t i = 0; i < bound.size(); i++) {
-          // Convert input pose
-          const Pose2D pose(bound[i].x, bound[i].y);
-
-          // Express point in global map frame
-          Pose2D pose_map = TransformToNewCosy2D(d_current_to_map_origin, pose);
-
-          if (ib == 0) {
-            msg_output.left_bound[i].x = pose_map.get_x();
-            msg_output.left_bound[i].y = pose_map.get_y();
-          } else {
-            msg_output.right_bound[i].x = pose_map.get_x();
-            msg_output.right_bound[i].y = pose_map.get_y();
-          }
-        }
+  // Convert all the input points to the global map frame
+  for (size_t i = 0; i < std::max(num_trj_points, num_path_points); i++) {
+    Pose2D pose_map;
+    if (i < num_trj_points) {
+      const geometry_msgs::msg::Point & position = trj_msg.points[i].pose.position;
+      pose_map = to_global(position.x, position.y);
+
+      trj_msg_global.points[i] = trj_msg.points[i];
+      trj_msg_global.points[i].pose.position.x = pose_map.get_x();
+      trj_msg_global.points[i].pose.position.y = pose_map.get_y();
+      if (is_transformed) {
+        const geometry_msgs::msg::Quaternion & orientation = trj_msg.points[i].pose.orientation;
+        const tf2::Quaternion orientation_map =
+          rotation_to_global *
+          tf2::Quaternion(orientation.x, orientation.y, orientation.z, orientation.w);
+        trj_msg_global.points[i].pose.orientation.x = orientation_map.getX();
+        trj_msg_global.points[i].pose.orientation.y = orientation_map.getY();
+        trj_msg_global.points[i].pose.orientation.z = orientation_map.getZ();
+        trj_msg_global.points[i].pose.orientation.w = orientation_map.getW();
+      }
+
+      if (trj_vis_global != nullptr) {
+        AddPointVisualizationMarker_(*trj_vis_global, pose_map.get_x(), pose_map.get_y(), 10);
       }
     }
 
-    // Add heading if type is a trajectory
-    if constexpr (std::is_same<T, autoware_planning_msgs::msg::Trajectory>::value)
-      AddHeadingToTrajectory_(msg_output);
+    if (i < num_path_points) {
+      // The path shares its points with the trajectory, so the transformation is usually reused
+      const geometry_msgs::msg::Point & position = path_msg.points[i].pose.position;
+      if (
+        i >= num_trj_points || position.x != trj_msg.points[i].pose.position.x ||
+        position.y != trj_msg.points[i].pose.position.y) {
+        pose_map = to_global(position.x, position.y);
+      }
+
+      path_msg_global.points[i] = path_msg.points[i];
+      path_msg_global.points[i].pose.position.x = pose_map.get_x();
+      path_msg_global.points[i].pose.position.y = pose_map.get_y();
+    }
   }
 
-  return msg_output;
+  // Convert the path area's bounds
+  const auto transform_bound = [&](
+                                 const std::vector<geometry_msgs::msg::Point> & bound,
+                                 std::vector<geometry_msgs::msg::Point> & bound_global) {
+    bound_global.resize(bound.size());
+    for (size_t i = 0; i < bound.size(); i++) {
+      const Pose2D pose_map = to_global(bound[i].x, bound[i].y);
+
+      bound_global[i] = bound[i];
+      bound_global[i].x = pose_map.get_x();
+      bound_global[i].y = pose_map.get_y();
+    }
+  };
+  transform_bound(path_msg.left_bound, path_msg_global.left_bound);
+  transform_bound(path_msg.right_bound, path_msg_global.right_bound);
+}
+
+template <typename MessageT>
+void MissionLaneConverterNode::PublishLoanedIfSupported_(
+  rclcpp::Publisher<MessageT> & publisher, const MessageT & msg)
+{
+  if (use_loaned_messages_ && publisher.can_loan_messages()) {
+    // Fill the message directly into memory owned by the middleware, which is handed over to the
+    // subscribers without serialization
+    rclcpp::LoanedMessage<MessageT> loaned_msg = publisher.borrow_loaned_message();
+    MessageT & msg_loaned = loaned_msg.get();
+    msg_loaned.header = msg.header;
+    msg_loaned.points.assign(msg.points.begin(), msg.points.end());
+    if constexpr (std::is_same<MessageT, autoware_planning_msgs::msg::Path>::value) {
+      msg_loaned.left_bound.assign(msg.left_bound.begin(), msg.left_bound.end());
+      msg_loaned.right_bound.assign(msg.right_bound.begin(), msg.right_bound.end());
+    }
+    publisher.publish(std::move(loaned_msg));
+  } else {
+    publisher.publish(msg);
+  }
 }
 
-visualization_msgs::msg::Marker MissionLaneConverterNode::GetGlobalTrjVisualization_(
-  const autoware_planning_msgs::msg::Trajectory & trj_msg)
+void MissionLaneConverterNode::InitGlobalTrjVisualization_(
+  visualization_msgs::msg::Marker & trj_vis_global, const std_msgs::msg::Header & header)
 {
   // Empty trajectory visualization message
-  visualization_msgs::msg::Marker trj_vis_global;
-  trj_vis_global.header.frame_id = trj_msg.header.frame_id;
-  trj_vis_global.header.stamp = trj_msg.header.stamp;
+  trj_vis_global.points.clear();
+  trj_vis_global.header.frame_id = header.frame_id;
+  trj_vis_global.header.stamp = header.stamp;
   trj_vis_global.ns = "mission_trajectory_global";
   trj_vis_global.type = visualization_msgs::msg::Marker::LINE_STRIP;
   trj_vis_global.pose.orientation.w = 1.0;  // Neutral orientation
@@ -629,13 +814,6 @@ visualization_msgs::msg::Marker MissionLaneConverterNode::GetGlobalTrjVisualizat
   trj_vis_global.lifetime.sec = 0;      // Forever
   trj_vis_global.lifetime.nanosec = 0;  // Forever
   trj_vis_global.frame_locked = false;  // Always transform into baselink
-
-  for (size_t i = 0; i < trj_msg.points.size(); i++) {
-    AddPointVisualizationMarker_(
-      trj_vis_global, trj_msg.points[i].pose.position.x, trj_msg.points[i].pose.position.y, 10);
-  }
-
-  return trj_vis_global;
 }
 }  // namespace autoware::mapless_architecture
 
@@ -18,6 +18,8 @@
 
 #include "geometry_msgs/msg/point.hpp"
 
+#include <cmath>
+
 namespace autoware::mapless_architecture
 {
 
@@ -74,10 +76,11 @@ TEST_F(MissionLaneConverterTest, TestConvertMissionToTrajectoryExampleInputAndOu
   mission_msg.ego_lane.centerline.back().y = 0.0;
 
   // Get converted trajectory
-  auto mission_to_trj = mission_converter.ConvertMissionToTrajectory(mission_msg);
+  ConversionOutput output;
+  mission_converter.ConvertMissionToTrajectory(mission_msg, output);
 
   // Extract trajectory
-  auto trj_msg = std::get<0>(mission_to_trj);
+  auto trj_msg = output.trajectory;
 
   EXPECT_EQ(trj_msg.points.back().pose.position.x, mission_msg.ego_lane.centerline.back().x);
   EXPECT_EQ(trj_msg.points.back().pose.position.y, mission_msg.ego_lane.centerline.back().y);
@@ -96,10 +99,10 @@ TEST_F(MissionLaneConverterTest, TestConvertMissionToTrajectoryExampleInputAndOu
   mission_msg.ego_lane.centerline.back().y = 2.0;
 
   // Convert
-  mission_to_trj = mission_converter.ConvertMissionToTrajectory(mission_msg);
+  mission_converter.ConvertMissionToTrajectory(mission_msg, output);
 
   // Extract trajectory
-  trj_msg = std::get<0>(mission_to_trj);
+  trj_msg = output.trajectory;
 
   EXPECT_EQ(trj_msg.points.back().pose.position.x, mission_msg.ego_lane.centerline.back().x);
   EXPECT_EQ(trj_msg.points.back().pose.position.y, mission_msg.ego_lane.centerline.back().y);
@@ -117,10 +120,10 @@ TEST_F(MissionLaneConverterTest, TestConvertMissionToTrajectoryExampleInputAndOu
   mission_msg.target_lane = -1;
 
   // Convert
-  mission_to_trj = mission_converter.ConvertMissionToTrajectory(mission_msg);
+  mission_converter.ConvertMissionToTrajectory(mission_msg, output);
 
   // Extract trajectory
-  trj_msg = std::get<0>(mission_to_trj);
+  trj_msg = output.trajectory;
 
   EXPECT_EQ(
     trj_msg.points.back().pose.position.x,
@@ -143,10 +146,10 @@ TEST_F(MissionLaneConverterTest, TestConvertMissionToTrajectoryExampleInputAndOu
   mission_msg.target_lane = 1;
 
   // Convert
-  mission_to_trj = mission_converter.ConvertMissionToTrajectory(mission_msg);
+  mission_converter.ConvertMissionToTrajectory(mission_msg, output);
 
   // Extract trajectory
-  trj_msg = std::get<0>(mission_to_trj);
+  trj_msg = output.trajectory;
 
   EXPECT_EQ(
     trj_msg.points.back().pose.position.x,
@@ -155,4 +158,136 @@ TEST_F(MissionLaneConverterTest, TestConvertMissionToTrajectoryExampleInputAndOu
     trj_msg.points.back().pose.position.y,
     mission_msg.drivable_lanes_right.back().centerline.back().y);
 }
+
+/**
+ * @brief Test that the reused output of ConvertMissionToTrajectory() only contains the last frame.
+ */
+TEST_F(MissionLaneConverterTest, TestConvertMissionToTrajectoryReusedOutput)
+{
+  rclcpp::NodeOptions options;
+  MissionLaneConverterNodeMock mission_converter(options);
+
+  autoware_mapless_planning_msgs::msg::MissionLanesStamped mission_msg;
+  mission_msg.target_lane = 0;
+  for (int i = 0; i < 5; i++) {
+    mission_msg.ego_lane.centerline.push_back(geometry_msgs::msg::Point());
+    mission_msg.ego_lane.centerline.back().x = i;
+    mission_msg.ego_lane.centerline.back().y = 0.5 * i;
+    mission_msg.ego_lane.bound_left.push_back(mission_msg.ego_lane.centerline.back());
+    mission_msg.ego_lane.bound_left.back().y += 1.5;
+  }
+
+  ConversionOutput output;
+  mission_converter.ConvertMissionToTrajectory(mission_msg, output);
+  EXPECT_EQ(output.trajectory.points.size(), 5u);
+
+  // Convert a shorter mission lane into the same output
+  mission_msg.ego_lane.centerline.resize(2);
+  mission_msg.ego_lane.bound_left.resize(2);
+  mission_converter.ConvertMissionToTrajectory(mission_msg, output);
+
+  EXPECT_EQ(output.trajectory.points.size(), 2u);
+  EXPECT_EQ(output.path.points.size(), 2u);
+  EXPECT_EQ(output.path.left_bound.size(), 2u);
+  EXPECT_EQ(output.trajectory_vis.points.size(), 2u);
+  ASSERT_EQ(output.path_area_vis.markers.size(), 3u);
+  EXPECT_EQ(output.path_area_vis.markers[0].points.size(), 2u);
+
+  // Without odometry the global map frame equals the local frame
+  ASSERT_EQ(output.trajectory_global.points.size(), 2u);
+  ASSERT_EQ(output.path_global.left_bound.size(), 2u);
+  EXPECT_EQ(output.trajectory_global.points[1].pose.position.x, 1.0);
+  EXPECT_EQ(output.trajectory_global.points[1].pose.position.y, 0.5);
+  EXPECT_EQ(output.path_global.points[1].pose.position.y, 0.5);
+  EXPECT_EQ(output.path_global.left_bound[1].y, 2.0);
+  EXPECT_EQ(output.trajectory_vis_global.points.size(), 2u);
+}
+
+/**
+ * @brief Test that the global output which is transformed again with a newer odometry is stamped
+ * with the odometry stamp.
+ */
+TEST_F(MissionLaneConverterTest, TestRetransformToGlobalFrameStamp)
+{
+  rclcpp::NodeOptions options;
+  MissionLaneConverterNodeMock mission_converter(options);
+
+  autoware_mapless_planning_msgs::msg::MissionLanesStamped mission_msg;
+  mission_msg.header.stamp.sec = 10;
+  mission_msg.target_lane = 0;
+  for (int i = 0; i < 3; i++) {
+    mission_msg.ego_lane.centerline.push_back(geometry_msgs::msg::Point());
+    mission_msg.ego_lane.centerline.back().x = i;
+    mission_msg.ego_lane.bound_left.push_back(mission_msg.ego_lane.centerline.back());
+    mission_msg.ego_lane.bound_left.back().y += 1.5;
+  }
+
+  // Without odometry the global output keeps the stamp of the mission lanes
+  ConversionOutput output;
+  mission_converter.ConvertMissionToTrajectory(mission_msg, output);
+  EXPECT_EQ(output.trajectory_global.header.stamp.sec, 10);
+  mission_converter.RetransformToGlobalFrame(output);
+  EXPECT_EQ(output.trajectory_global.header.stamp.sec, 10);
+
+  // A newer odometry (the vehicle moved 5 m forward)
+  nav_msgs::msg::Odometry odometry;
+  odometry.header.stamp.sec = 12;
+  odometry.header.stamp.nanosec = 500;
+  odometry.pose.pose.position.x = 5.0;
+  odometry.pose.pose.orientation.w = 1.0;
+  mission_converter.UpdateOdometry(odometry);
+  mission_converter.RetransformToGlobalFrame(output);
+
+  EXPECT_EQ(output.trajectory_global.header.stamp.sec, 12);
+  EXPECT_EQ(output.trajectory_global.header.stamp.nanosec, 500u);
+  EXPECT_EQ(output.path_global.header.stamp.sec, 12);
+  EXPECT_EQ(output.trajectory_vis_global.header.stamp.sec, 12);
+  ASSERT_EQ(output.trajectory_global.points.size(), 3u);
+  EXPECT_NE(
+    output.trajectory_global.points[1].pose.position.x,
+    output.trajectory.points[1].pose.position.x);
+
+  // The local output keeps the stamp of the mission lanes
+  EXPECT_EQ(output.trajectory.header.stamp.sec, 10);
+}
+
+TEST_F(MissionLaneConverterTest, TestGlobalTrajectoryOrientation)
+{
+  rclcpp::NodeOptions options;
+  MissionLaneConverterNodeMock mission_converter(options);
+
+  // A curved ego lane, so that the local headings differ along the trajectory
+  autoware_mapless_planning_msgs::msg::MissionLanesStamped mission_msg;
+  mission_msg.target_lane = 0;
+  for (int i = 0; i < 5; i++) {
+    mission_msg.ego_lane.centerline.push_back(geometry_msgs::msg::Point());
+    mission_msg.ego_lane.centerline.back().x = i;
+    mission_msg.ego_lane.centerline.back().y = 0.2 * i * i;
+    mission_msg.ego_lane.bound_left.push_back(mission_msg.ego_lane.centerline.back());
+    mission_msg.ego_lane.bound_left.back().y += 1.5;
+  }
+
+  // The vehicle is rotated by 90 degrees with respect to the global map frame
+  nav_msgs::msg::Odometry odometry;
+  odometry.pose.pose.position.x = 3.0;
+  odometry.pose.pose.position.y = -2.0;
+  odometry.pose.pose.orientation.z = std::sin(M_PI / 4.0);
+  odometry.pose.pose.orientation.w = std::cos(M_PI / 4.0);
+  mission_converter.UpdateOdometry(odometry);
+
+  ConversionOutput output;
+  mission_converter.ConvertMissionToTrajectory(mission_msg, output);
+
+  // The global orientations are the local orientations rotated by the odometry yaw
+  ASSERT_EQ(output.trajectory_global.points.size(), output.trajectory.points.size());
+  ASSERT_FALSE(output.trajectory.points.empty());
+  for (size_t i = 0; i < output.trajectory.points.size(); i++) {
+    const auto & q_local = output.trajectory.points[i].pose.orientation;
+    const auto & q_global = output.trajectory_global.points[i].pose.orientation;
+    const double psi_local = GetYawFromQuaternion(q_local.x, q_local.y, q_local.z, q_local.w);
+    const double psi_global =
+      GetYawFromQuaternion(q_global.x, q_global.y, q_global.z, q_global.w);
+    EXPECT_NEAR(NormalizePsi(psi_global - psi_local - M_PI / 2.0), 0.0, 1e-9);
+  }
+}
 }  // namespace autoware::mapless_architecture